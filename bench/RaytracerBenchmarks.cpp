@@ -0,0 +1,230 @@
+#include <benchmark/benchmark.h>
+#include "IntersectionEngine.h"
+#include "MeshLoader.h"
+#include "MaxwellSampler.h"
+#include "SurfaceInteractionModel.h"
+#include "DragForceCalculator.h"
+#include "ConfigLoader.h"
+#include "AeroDatabase.h"
+#include "Vector3.h"
+#include "Ray.h"
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+// Microbenchmarks der Hot-Path-Kernel.
+// JSON-Export: ./RaytracerBenchmarks --benchmark_out=bench.json --benchmark_out_format=json
+
+#ifndef VLEO_MODEL_DIR
+#define VLEO_MODEL_DIR "models"
+#endif
+
+namespace {
+
+const std::vector<std::string> kModels = {"Cube", "Opt_Sat", "SOAR", "Triple_Cube"};
+
+std::string modelPath(int index) {
+    return std::string(VLEO_MODEL_DIR) + "/" + kModels[index] + ".obj";
+}
+
+// Mesh einmal pro Modell laden und für alle Benchmarks wiederverwenden
+const MeshLoader& cachedMesh(int index) {
+    static std::map<int, MeshLoader> meshes;
+    auto it = meshes.find(index);
+    if (it == meshes.end()) {
+        it = meshes.emplace(index, MeshLoader{}).first;
+        it->second.load(modelPath(index));
+    }
+    return it->second;
+}
+
+// Strahlen von einer Kugel um die Bounding Box auf zufällige Punkte in der Box
+std::vector<Ray> makeRays(const MeshLoader& mesh, int count, unsigned seed) {
+    auto [minB, maxB] = mesh.getBoundingBox();
+    Vector3 center = (minB + maxB) * 0.5;
+    double radius = (maxB - minB).norm();
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> uni(0.0, 1.0);
+    std::normal_distribution<double> gauss(0.0, 1.0);
+
+    std::vector<Ray> rays(count);
+    for (auto& r : rays) {
+        Vector3 onSphere = Vector3(gauss(rng), gauss(rng), gauss(rng)).normalize();
+        Vector3 target(minB.x + uni(rng) * (maxB.x - minB.x),
+                       minB.y + uni(rng) * (maxB.y - minB.y),
+                       minB.z + uni(rng) * (maxB.z - minB.z));
+        r.origin = center + onSphere * radius;
+        r.direction = (target - r.origin).normalize();
+    }
+    return rays;
+}
+
+Ray makeIncidentRay() {
+    Ray in;
+    in.direction = Vector3(0.3, -1.0, 0.1).normalize();
+    in.speciesMass = 2.66e-26;                // atomarer Sauerstoff
+    in.velocity = in.direction * 7600.0;
+    in.energy = 0.5 * in.speciesMass * 7600.0 * 7600.0;
+    in.momentum = in.velocity * in.speciesMass;
+    in.weight = 1.0;
+    return in;
+}
+
+HitInfo makeHit() {
+    HitInfo hit{};
+    hit.point = {0, 0, 0};
+    hit.normal = {0, 1, 0};
+    hit.panelId = 0;
+    hit.t = 1.0;
+    return hit;
+}
+
+} // namespace
+
+// --- IntersectionEngine::intersect (Arg = Modellindex), double- und float-Geometrie
+template <TracePrecision Precision>
+static void BM_Intersect(benchmark::State& state) {
+    const MeshLoader& mesh = cachedMesh(static_cast<int>(state.range(0)));
+    IntersectionEngine engine;
+    engine.setPrecision(Precision);
+    engine.setMesh(mesh.getInstancedMesh());
+    const auto rays = makeRays(mesh, 1024, 42);
+
+    size_t i = 0, hits = 0;
+    for (auto _ : state) {
+        auto hit = engine.intersect(rays[i]);
+        hits += hit.has_value();
+        benchmark::DoNotOptimize(hit);
+        i = (i + 1) % rays.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetLabel(kModels[state.range(0)] + " (" + std::to_string(mesh.getTriangles().size()) + " tris)");
+    state.counters["hit_rate"] = static_cast<double>(hits) / std::max<int64_t>(state.iterations(), 1);
+}
+BENCHMARK_TEMPLATE(BM_Intersect, TracePrecision::Double)->DenseRange(0, 3);
+BENCHMARK_TEMPLATE(BM_Intersect, TracePrecision::Float)->DenseRange(0, 3);
+
+// --- IntersectionEngine::setMesh: Aufbau beider BVH-Ebenen (Arg = Modellindex)
+static void BM_BuildEngine(benchmark::State& state) {
+    const MeshLoader& mesh = cachedMesh(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        IntersectionEngine engine;
+        engine.setMesh(mesh.getInstancedMesh());
+        benchmark::DoNotOptimize(engine);
+    }
+}
+BENCHMARK(BM_BuildEngine)->DenseRange(0, 3)->Unit(benchmark::kMicrosecond);
+
+// --- MaxwellSampler::sampleVelocity
+static void BM_SampleVelocity(benchmark::State& state) {
+    MaxwellSampler sampler(1000.0, 2.66e-26, Vector3(0.0, 0.0, -7600.0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sampler.sampleVelocity());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SampleVelocity);
+
+// --- SurfaceInteractionModel: ein Benchmark je Reflexionsmodell
+template <SurfaceModelType Model>
+static void BM_Reflect(benchmark::State& state) {
+    SimulationConfig cfg;
+    SurfaceInteractionModel model(cfg.reflectionRatio, cfg.absorptionRatio);
+    model.prepare(cfg);
+
+    const Ray in = makeIncidentRay();
+    const HitInfo hit = makeHit();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(model.reflect<Model>(cfg, in, hit));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_Reflect, SurfaceModelType::DRIA);
+BENCHMARK_TEMPLATE(BM_Reflect, SurfaceModelType::Sentman);
+BENCHMARK_TEMPLATE(BM_Reflect, SurfaceModelType::CLL);
+BENCHMARK_TEMPLATE(BM_Reflect, SurfaceModelType::Classic);
+
+// --- DragForceCalculator::accumulateForce (Arg = Anzahl Panels)
+static void BM_AccumulateForce(benchmark::State& state) {
+    const int panels = static_cast<int>(state.range(0));
+    DragForceCalculator calc;
+    Ray in = makeIncidentRay();
+    Ray out = in;
+    out.momentum = out.momentum * -0.5;
+
+    int panel = 0;
+    for (auto _ : state) {
+        in.panelId = panel;
+        calc.accumulateForce(in, out, 1.0);
+        panel = (panel + 7) % panels;
+    }
+    benchmark::DoNotOptimize(calc.getTotalDragForce());
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AccumulateForce)->Arg(12)->Arg(2688)->Arg(6540);
+
+// --- DragForceCalculator::merge (Arg = Anzahl Panels je Calculator)
+static void BM_DragMerge(benchmark::State& state) {
+    const int panels = static_cast<int>(state.range(0));
+    DragForceCalculator part;
+    Ray in = makeIncidentRay();
+    Ray out = in;
+    for (int p = 0; p < panels; ++p) {
+        in.panelId = p;
+        part.accumulateForce(in, out, 1.0);
+    }
+
+    for (auto _ : state) {
+        DragForceCalculator total;
+        total.merge(part);
+        benchmark::DoNotOptimize(total.getTotalDragForce());
+    }
+    state.SetItemsProcessed(state.iterations() * panels);
+}
+BENCHMARK(BM_DragMerge)->Arg(12)->Arg(2688)->Arg(6540);
+
+// --- MeshLoader::loadFromOBJ (Arg = Modellindex)
+static void BM_LoadOBJ(benchmark::State& state) {
+    const std::string path = modelPath(static_cast<int>(state.range(0)));
+    size_t tris = 0;
+    for (auto _ : state) {
+        MeshLoader mesh;
+        mesh.loadFromOBJ(path);
+        tris = mesh.getTriangles().size();
+        benchmark::DoNotOptimize(tris);
+    }
+    state.SetItemsProcessed(state.iterations() * tris);
+    state.SetLabel(kModels[state.range(0)]);
+}
+BENCHMARK(BM_LoadOBJ)->DenseRange(0, 3)->Unit(benchmark::kMillisecond);
+
+// --- AeroDatabase::lookup auf einer Tabelle üblicher Größe (25 × 5 × 8 × 5 Knoten)
+static void BM_AeroLookup(benchmark::State& state) {
+    std::array<AeroAxis, AeroDatabase::axisCount> axes = {
+        AeroAxis::fromRange({-60.0, 60.0, 25}), AeroAxis::fromRange({-20.0, 20.0, 5}),
+        AeroAxis::fromRange({4.0, 12.0, 8}), AeroAxis::fromRange({0.2, 0.6, 5})
+    };
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> val(-1.0f, 1.0f);
+    std::vector<float> values(25 * 5 * 8 * 5 * AeroDatabase::valuesPerNode);
+    for (auto& v : values) v = val(rng);
+    AeroDatabase db;
+    db.setTable(axes, values);
+
+    std::uniform_real_distribution<double> uni(0.0, 1.0);
+    std::vector<std::array<double, 4>> queries(1024);
+    for (auto& q : queries)
+        q = {-60.0 + 120.0 * uni(rng), -20.0 + 40.0 * uni(rng), 4.0 + 8.0 * uni(rng), 0.2 + 0.4 * uni(rng)};
+
+    size_t i = 0;
+    for (auto _ : state) {
+        const auto& q = queries[i++ & 1023];
+        benchmark::DoNotOptimize(db.lookup(q[0], q[1], q[2], q[3]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AeroLookup);
+
+BENCHMARK_MAIN();
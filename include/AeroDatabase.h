@@ -0,0 +1,76 @@
+#pragma once
+#include "ConfigLoader.h"
+#include "Vector3.h"
+#include <array>
+#include <string>
+#include <vector>
+
+class DragSolver;
+
+// Gleichmäßige Tabellenachse
+struct AeroAxis {
+    double start = 0.0;
+    double step = 0.0;     // 0 bei nur einem Punkt
+    int count = 1;
+
+    static AeroAxis fromRange(const GridRange& range);
+    bool valid() const;    // count ≥ 1, bei mehreren Punkten endliche Schrittweite ≠ 0
+    double value(int i) const { return start + step * i; }
+};
+
+// Beiwerte im Körpersystem: C_F = F / (q A_ref), C_M = M / (q A_ref L_ref)
+struct AeroCoefficients {
+    Vector3 force = {0, 0, 0};
+    Vector3 moment = {0, 0, 0};
+    Vector3 forceError = {0, 0, 0};    // 1σ Monte Carlo
+    Vector3 momentError = {0, 0, 0};
+};
+
+/**
+ * Tabulated force and moment coefficients over
+ * (angle of attack, sideslip, speed ratio, wall/gas temperature ratio).
+ *
+ * generate() evaluates every grid node with one DragSolver::computeBatch;
+ * save()/load() use a compact binary file (float32 values), written
+ * little-endian on every host.
+ * lookup() interpolates multilinearly on the uniform grid and clamps
+ * queries outside the table to its boundary.
+ *
+ * Flow direction at angle of attack α and sideslip β (body axes, matching
+ * the TestMain convention with the free stream along +y at α = 0):
+ *   d = (sin α cos β, cos α cos β, sin β)
+ */
+class AeroDatabase {
+public:
+    static constexpr int axisCount = 4;            // AoA, Schiebewinkel, s, T_w/T
+    static constexpr int valuesPerNode = 12;       // C_F, C_M, σ(C_F), σ(C_M)
+
+    // Tabelle über das Gitter aus cfg rechnen (Spezieszusammensetzung und T_w aus cfg)
+    bool generate(const DragSolver& solver, const SimulationConfig& cfg);
+
+    // Gitter und Werte direkt setzen (Tests, externe Quellen); values: valuesPerNode pro Knoten
+    bool setTable(const std::array<AeroAxis, axisCount>& axes, std::vector<float> values);
+
+    bool save(const std::string& filename) const;
+    bool load(const std::string& filename);
+
+    AeroCoefficients lookup(double aoaDeg, double sideslipDeg, double speedRatio, double temperatureRatio) const;
+
+    const AeroAxis& getAxis(int axis) const { return axes[axis]; }
+    size_t getNodeCount() const;
+    double getReferenceArea() const { return referenceArea; }
+    double getReferenceLength() const { return referenceLength; }
+    const Vector3& getReferencePoint() const { return referencePoint; }
+
+    static Vector3 flowDirection(double aoaDeg, double sideslipDeg);
+
+private:
+    std::array<AeroAxis, axisCount> axes;
+    std::vector<float> values;            // Knoten-major, Index ((i0·n1 + i1)·n2 + i2)·n3 + i3
+    std::array<size_t, axisCount> strides = {1, 1, 1, 1};   // Knotenabstand pro Achse
+    double referenceArea = 1.0;
+    double referenceLength = 1.0;
+    Vector3 referencePoint = {0, 0, 0};
+
+    void updateStrides();
+};
@@ -0,0 +1,75 @@
+#pragma once
+#include "ConfigLoader.h"
+#include <array>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+// Atmosphärenzustand einer Tabellenzeile
+struct AtmosphereState {
+    double massDensity = 0.0;       // [kg/m³]
+    double temperature = 0.0;       // [K]
+    double dynamicPressure = 0.0;   // [Pa]
+    std::array<double, 9> densities{};   // [1/m³], Reihenfolge wie AtmosphereTable::speciesNames
+
+    // Temperatur, Massendichte und Dichten der in cfg vorhandenen Spezies setzen (Massen bleiben)
+    void applyTo(SimulationConfig& cfg) const;
+};
+
+/**
+ * Atmosphere rows of all assets/atmos_data/database_<alt>km.csv files.
+ *
+ * The CSVs are parsed once into one column-major block per altitude; a row
+ * is then read in O(1) without touching text. Column layout of the CSVs
+ * (after one header line): mass density, number densities of N2, O2, O,
+ * HE, H, AR, N, AO, NO, temperature, …, dynamic pressure (last column).
+ *
+ * load() keeps a binary cache of all blocks in host byte order (a local
+ * file, not meant to be moved between machines). The cache records the
+ * canonical source directory and size and mtime of every CSV; the CSVs are
+ * reparsed whenever any of these differ.
+ */
+class AtmosphereTable {
+public:
+    static constexpr int speciesCount = 9;
+    static const std::array<std::string, speciesCount> speciesNames;
+
+    // Cache nutzen, wenn aktuell; sonst alle CSVs lesen und den Cache neu schreiben (cacheFile leer: kein Cache)
+    bool load(const std::string& directory, const std::string& cacheFile);
+    bool loadCsvDirectory(const std::string& directory);
+    bool readCsv(const std::string& altitude, const std::string& filename);
+
+    bool saveCache(const std::string& filename) const;
+    bool loadCache(const std::string& filename);
+
+    // Kanonisches Verzeichnis, aus dem die Tabelle stammt (auch beim Laden aus dem Cache)
+    const std::string& getSourceDirectory() const { return sourceDirectory; }
+
+    bool hasAltitude(const std::string& altitude) const { return blocks.count(altitude) > 0; }
+    size_t getRowCount(const std::string& altitude) const;
+    std::vector<std::string> getAltitudes() const;
+
+    // false, wenn Höhe oder Zeile fehlt
+    bool getState(const std::string& altitude, size_t row, AtmosphereState& state) const;
+
+private:
+    static constexpr int columnCount = 3 + speciesCount;   // ρ, Spezies, T, q
+
+    // Spalten einer Höhe: values[offset + Spalte · rows + Zeile]
+    struct Block {
+        size_t offset = 0;
+        size_t rows = 0;
+    };
+    // Größe und Änderungszeit der CSV, aus der ein Block stammt
+    struct Source {
+        uint64_t size = 0;
+        int64_t mtime = 0;   // file_time_type seit Epoche, in Ticks der Dateisystemuhr
+    };
+    std::map<std::string, Block> blocks;
+    std::map<std::string, Source> sources;
+    std::string sourceDirectory;
+    std::vector<double> values;
+
+    void addBlock(const std::string& altitude, const std::vector<std::array<double, columnCount>>& rows);
+};
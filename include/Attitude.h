@@ -0,0 +1,68 @@
+#pragma once
+#include "RigidTransform.h"
+#include "Vector3.h"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * Orientation of the body relative to the free stream.
+ *
+ * The mesh and all acceleration structures stay in the body frame; only the
+ * free stream is turned into it. The reference (wind) frame has the free
+ * stream along +y, as TestMain always had for α = 0.
+ */
+struct Attitude {
+    RigidTransform toBodyRotation;   // Referenz- → Körpersystem (ohne Verschiebung)
+
+    Vector3 toBody(const Vector3& v) const { return toBodyRotation.rotate(v); }
+
+    /**
+     * Aerodynamic angles in degrees. The free stream +y arrives in the body
+     * frame as (sin α cos β, cos α cos β, sin β), as AeroDatabase::flowDirection;
+     * roll then turns the body about its y axis.
+     */
+    static Attitude fromAngles(double aoaDeg, double sideslipDeg, double rollDeg = 0.0) {
+        const double a = aoaDeg * M_PI / 180.0, b = sideslipDeg * M_PI / 180.0, r = rollDeg * M_PI / 180.0;
+        const RigidTransform pitch = RigidTransform::rotation({0.0, 0.0, 1.0}, -a);
+        const RigidTransform yaw = RigidTransform::rotation({std::cos(a), -std::sin(a), 0.0}, b);
+        const RigidTransform roll = RigidTransform::rotation({0.0, 1.0, 0.0}, r);
+        return {roll * yaw * pitch};
+    }
+
+    /**
+     * Inverse of fromAngles: α, β and roll in degrees with fromAngles(α, β, roll)
+     * giving this rotation (α in [−90°, 90°]). R = R_y(roll) R_z(−α) R_x(β), so
+     * the middle row fixes α and β and the first column fixes roll. At α = ±90°
+     * roll and sideslip share one axis; roll is then reported as 0.
+     */
+    void toAngles(double& aoaDeg, double& sideslipDeg, double& rollDeg) const {
+        const RigidTransform& R = toBodyRotation;
+        const double a = std::asin(std::clamp(-R.row1.x, -1.0, 1.0));
+        double b, r;
+        if (std::cos(a) > 1e-9) {
+            b = std::atan2(-R.row1.z, R.row1.y);
+            r = std::atan2(-R.row2.x, R.row0.x);
+        } else {
+            b = std::atan2(R.row2.y, R.row2.z);
+            r = 0.0;
+        }
+        aoaDeg = a * 180.0 / M_PI;
+        sideslipDeg = b * 180.0 / M_PI;
+        rollDeg = r * 180.0 / M_PI;
+    }
+
+    /**
+     * Unit quaternion (w, x, y, z) body → reference, as DragService requests;
+     * it is normalised here.
+     */
+    static Attitude fromQuaternion(double w, double x, double y, double z) {
+        const double n = std::sqrt(w * w + x * x + y * y + z * z);
+        w /= n; x /= n; y /= n; z /= n;
+        // Zeilen von R(q)ᵀ: Referenz → Körper
+        Attitude att;
+        att.toBodyRotation.row0 = {1.0 - 2.0 * (y * y + z * z), 2.0 * (x * y + w * z), 2.0 * (x * z - w * y)};
+        att.toBodyRotation.row1 = {2.0 * (x * y - w * z), 1.0 - 2.0 * (x * x + z * z), 2.0 * (y * z + w * x)};
+        att.toBodyRotation.row2 = {2.0 * (x * z + w * y), 2.0 * (y * z - w * x), 1.0 - 2.0 * (x * x + y * y)};
+        return att;
+    }
+};
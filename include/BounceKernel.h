@@ -0,0 +1,90 @@
+#pragma once
+#include "IntersectionEngine.h"
+#include "SurfaceInteractionModel.h"
+#include "ConfigLoader.h"
+#include "HitInfo.h"
+#include "Ray.h"
+#include "RunProfiler.h"
+#include <cassert>
+#include <type_traits>
+
+template <SurfaceModelType Model>
+using SurfaceModelTag = std::integral_constant<SurfaceModelType, Model>;
+
+/**
+ * Calls f with a SurfaceModelTag for the given model type.
+ *
+ * The switch runs once at setup; everything inside f (typically the whole
+ * parallel ray loop) is instantiated separately for every model.
+ */
+template <typename F>
+decltype(auto) dispatchSurfaceModel(SurfaceModelType type, F&& f) {
+    switch (type) {
+        case SurfaceModelType::DRIA:
+            return f(SurfaceModelTag<SurfaceModelType::DRIA>{});
+        case SurfaceModelType::Sentman:
+            return f(SurfaceModelTag<SurfaceModelType::Sentman>{});
+        case SurfaceModelType::CLL:
+            return f(SurfaceModelTag<SurfaceModelType::CLL>{});
+        default:
+            return f(SurfaceModelTag<SurfaceModelType::Classic>{});
+    }
+}
+
+/**
+ * Bounce loop of a single ray with a compile-time surface model.
+ *
+ * For every hit the reflection is computed with reflect<Model>() and passed to
+ * onHit(incident, reflected, hit, bounce); returning false stops the ray.
+ * The ray also stops after maxBounces or once its energy drops below 10 %
+ * of the initial energy (after cfg.energyLoss). The model must be prepared, so that
+ * every hit reads its material (and CLL table) without locking.
+ *
+ * With counters set, intersect calls, hits, triangle tests and the bounce depth are
+ * counted; if timeScale > 0 the intersect/reflect/accumulate stages are also
+ * timed and the times multiplied by timeScale (sampled rays).
+ *
+ * @return Number of completed bounces.
+ */
+template <SurfaceModelType Model, typename OnHit>
+inline int traceBounces(const IntersectionEngine& engine,
+                        const SurfaceInteractionModel& model,
+                        const SimulationConfig& cfg,
+                        Ray r,
+                        int maxBounces,
+                        OnHit&& onHit,
+                        ThreadCounters* counters = nullptr,
+                        double timeScale = 0.0) {
+    assert(!model.getMaterials().empty() && "SurfaceInteractionModel::prepare() must run before tracing");
+    double remaining = r.energy;
+    const double minE = 0.1 * r.energy;
+    int bounces = 0;
+    const bool timed = counters && timeScale > 0.0;
+    StageClock::time_point t0;
+
+    while (bounces < maxBounces && remaining > minE) {
+        if (timed) t0 = StageClock::now();
+        auto hit = engine.intersect(r, counters ? &counters->traversal : nullptr);
+        if (counters) ++counters->intersectCalls;
+        if (timed) counters->add(Stage::Intersect, secondsSince(t0) * timeScale);
+        if (!hit) break;
+        if (counters) ++counters->hits;
+
+        if (timed) t0 = StageClock::now();
+        Ray refl = model.template reflect<Model>(cfg, r, *hit);
+        if (timed) {
+            counters->add(Stage::Reflect, secondsSince(t0) * timeScale);
+            t0 = StageClock::now();
+        }
+
+        bool keepGoing = onHit(r, refl, *hit, bounces);
+        if (timed) counters->add(Stage::Accumulate, secondsSince(t0) * timeScale);
+        if (!keepGoing) break;
+
+        r = refl;
+        remaining = refl.energy * (1.0 - cfg.energyLoss);
+        ++bounces;
+    }
+    if (counters) counters->recordRay(bounces);
+    return bounces;
+}
@@ -0,0 +1,167 @@
+#pragma once
+#include "Vector3.h"
+#include "RunProfiler.h"
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+// Achsenparallele Box; leer, solange lo > hi
+struct Aabb {
+    Vector3 lo{std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity(),
+               std::numeric_limits<double>::infinity()};
+    Vector3 hi{-std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(),
+               -std::numeric_limits<double>::infinity()};
+
+    void grow(const Vector3& p) { lo = Vector3::min(lo, p); hi = Vector3::max(hi, p); }
+    void grow(const Aabb& b) { lo = Vector3::min(lo, b.lo); hi = Vector3::max(hi, b.hi); }
+    bool empty() const { return lo.x > hi.x; }
+    Vector3 center() const { return (lo + hi) * 0.5; }
+    double surfaceArea() const {
+        if (empty()) return 0.0;
+        const Vector3 d = hi - lo;
+        return 2.0 * (d.x * d.y + d.y * d.z + d.z * d.x);
+    }
+};
+
+// Innerer Knoten: count = 0, Kinder first und first + 1; Blatt: Primitive order[first .. first + count)
+struct BvhNode {
+    Aabb box;
+    uint32_t first = 0;
+    uint32_t count = 0;
+};
+
+/**
+ * Bounding volume hierarchy over primitive boxes (binned SAH build).
+ *
+ * The hierarchy only knows boxes; the caller tests the primitives of each
+ * leaf it is handed. It serves both levels of the instanced intersection
+ * engine: triangles of a prototype and instances of the scene.
+ */
+class Bvh {
+public:
+    static constexpr uint32_t maxLeafSize = 4;
+    static constexpr uint32_t maxLeafCount = 4 * maxLeafSize;   // größeres Blatt nur, wenn SAH nicht teilt (build)
+    static constexpr int maxDepth = 96;   // Medianteilung ab Tiefe 64, begrenzt den Traversierungsstapel
+
+    void build(const std::vector<Aabb>& primitiveBounds);
+    // Ein Blatt mit allen Primitiven: kein Aufbau, lineare Suche
+    void buildSingleLeaf(const Aabb& bounds, uint32_t primitiveCount);
+
+    bool empty() const { return nodes.empty(); }
+    size_t nodeCount() const { return nodes.size(); }
+    const Aabb& bounds() const { return nodes.front().box; }
+    // Primitivindex je Blattposition
+    const std::vector<uint32_t>& primitiveOrder() const { return order; }
+
+    /**
+     * Visits the leaves hit by a ray, nearest box first.
+     *
+     * @param tMax Current nearest hit; read again after every leaf, so the
+     *             leaf callback may shrink it through the reference.
+     * @param leaf Called as leaf(first, count) with positions into primitiveOrder().
+     */
+    template <typename Leaf>
+    void traverse(const Vector3& origin, const Vector3& direction, const double& tMax, Leaf&& leaf,
+                  TraversalStats* stats = nullptr) const {
+        if (nodes.empty()) return;
+        const Vector3 inv(1.0 / direction.x, 1.0 / direction.y, 1.0 / direction.z);
+
+        std::pair<uint32_t, double> stack[maxDepth];
+        int top = 0;
+        double tNear;
+        if (stats) ++stats->nodeTests;
+        if (!slab(nodes[0].box, origin, inv, tMax, tNear)) return;
+        uint32_t node = 0;
+
+        while (true) {
+            const BvhNode& n = nodes[node];
+            if (n.count > 0) {
+                leaf(n.first, n.count);
+            } else {
+                double tA, tB;
+                const bool hitA = slab(nodes[n.first].box, origin, inv, tMax, tA);
+                const bool hitB = slab(nodes[n.first + 1].box, origin, inv, tMax, tB);
+                if (stats) stats->nodeTests += 2;
+                if (hitA && hitB) {
+                    const bool aFirst = tA <= tB;
+                    stack[top++] = {aFirst ? n.first + 1 : n.first, aFirst ? tB : tA};
+                    node = aFirst ? n.first : n.first + 1;
+                    continue;
+                }
+                if (hitA || hitB) {
+                    node = hitA ? n.first : n.first + 1;
+                    continue;
+                }
+            }
+            // Nächsten Knoten vom Stapel, der noch vor dem bisher nächsten Treffer beginnt
+            do {
+                if (top == 0) return;
+                node = stack[--top].first;
+            } while (stack[top].second > tMax);
+        }
+    }
+
+    /**
+     * Visits the leaves whose boxes pass a test (e.g. "reaches into a half-space").
+     *
+     * @param accept Called as accept(box); false prunes the subtree.
+     * @param leaf Called as leaf(first, count) with positions into primitiveOrder();
+     *             returning true ends the query.
+     */
+    template <typename Accept, typename Leaf>
+    void query(Accept&& accept, Leaf&& leaf) const {
+        if (nodes.empty() || !accept(nodes[0].box)) return;
+
+        uint32_t stack[maxDepth];
+        int top = 0;
+        uint32_t node = 0;
+        while (true) {
+            const BvhNode& n = nodes[node];
+            if (n.count > 0) {
+                if (leaf(n.first, n.count)) return;
+            } else {
+                const bool hitA = accept(nodes[n.first].box);
+                const bool hitB = accept(nodes[n.first + 1].box);
+                if (hitA && hitB) {
+                    stack[top++] = n.first + 1;
+                    node = n.first;
+                    continue;
+                }
+                if (hitA || hitB) {
+                    node = hitA ? n.first : n.first + 1;
+                    continue;
+                }
+            }
+            if (top == 0) return;
+            node = stack[--top];
+        }
+    }
+
+private:
+    std::vector<BvhNode> nodes;
+    std::vector<uint32_t> order;
+
+    void subdivide(uint32_t node, uint32_t begin, uint32_t end, int depth, const std::vector<Aabb>& boxes,
+                   const std::vector<Vector3>& centers);
+
+    // Slab-Test; tFar leicht vergrößert, damit Rundung keine Treffer auf dem Boxrand verwirft
+    static bool slab(const Aabb& box, const Vector3& o, const Vector3& inv, double tMax, double& tNear) {
+        constexpr double pad = 1.0 + 4.0 * std::numeric_limits<double>::epsilon();
+        double t0 = 0.0, t1 = tMax;
+        double lo = (box.lo.x - o.x) * inv.x, hi = (box.hi.x - o.x) * inv.x;
+        if (lo > hi) std::swap(lo, hi);
+        if (lo > t0) t0 = lo;   // NaN (Strahl in der Randebene) ändert nichts
+        if (hi * pad < t1) t1 = hi * pad;
+        lo = (box.lo.y - o.y) * inv.y; hi = (box.hi.y - o.y) * inv.y;
+        if (lo > hi) std::swap(lo, hi);
+        if (lo > t0) t0 = lo;
+        if (hi * pad < t1) t1 = hi * pad;
+        lo = (box.lo.z - o.z) * inv.z; hi = (box.hi.z - o.z) * inv.z;
+        if (lo > hi) std::swap(lo, hi);
+        if (lo > t0) t0 = lo;
+        if (hi * pad < t1) t1 = hi * pad;
+        tNear = t0;
+        return t0 <= t1;
+    }
+};
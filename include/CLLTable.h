@@ -0,0 +1,44 @@
+#pragma once
+#include <vector>
+
+/**
+ * Tabulated Cercignani–Lampis–Lord (CLL) normal-velocity kernel.
+ *
+ * In units of the wall thermal speed c_w = √(2kT_w/m) the reflected normal speed
+ * u_r for an incident normal speed u_i follows
+ *
+ *   P(u_r | u_i) = (2u_r/α_n) I0(2√(1−α_n) u_r u_i / α_n) exp(−(u_r² + (1−α_n) u_i²)/α_n).
+ *
+ * The Bessel-based inverse CDF is precomputed on a grid of u_i, so one sample
+ * costs two table lookups. The tangential part is Gaussian and sampled directly
+ * (mean √(1−α_t) u_t, variance α_t/2, α_t = tangential energy accommodation).
+ */
+class CLLTable {
+public:
+    CLLTable(double alphaN, double alphaT, double wallTemp,
+             int speedBins = 321, int quantiles = 128, double maxSpeed = 40.0);
+
+    // Reflektierte Normalgeschwindigkeit (dimensionslos) für Zufallszahl xi ∈ [0, 1)
+    double sampleNormalSpeed(double uIn, double xi) const;
+
+    double getNormalAccommodation() const { return alphaN; }
+    double getTangentialAccommodation() const { return alphaT; }
+    double getWallTemperature() const { return wallTemp; }
+
+    // Prozessweiter Cache, einmal pro (α_n, α_t, T_w) aufgebaut; thread-safe
+    static const CLLTable& cached(double alphaN, double alphaT, double wallTemp);
+
+private:
+    double alphaN;
+    double alphaT;
+    double wallTemp;
+
+    int speedBins;
+    int quantiles;
+    double maxSpeed;
+    double speedStep;
+
+    std::vector<double> inverseCdf;  // speedBins × (quantiles + 1), zeilenweise
+
+    void buildRow(int row, double uIn);
+};
@@ -1,26 +1,96 @@
 #pragma once
 #include "INIReader.h"
 #include <string>
+#include <map>
+#include <optional>
 #include <iostream>
+#include <vector>
+#include <array>
 #include "Vector3.h"
+#include "RigidTransform.h"
 
 struct SpeciesInfo {
     double density;
     double mass;
 };
 
+// Werte aus einem [material:<name>]-Abschnitt; nicht gesetzte Werte erben die globalen
+struct MaterialInfo {
+    std::optional<double> energyAccommodation;
+    std::optional<double> wallTemperature;
+    std::optional<double> specularFraction;
+    std::optional<double> reflectionRatio;
+    std::optional<double> energyLoss;
+    std::optional<double> normalAccommodation;
+    std::optional<double> tangentialAccommodation;
+};
+
+// Lage eines Teilkörpers aus einem [body:<name>]-Abschnitt: Drehung um die Achse durch pivot, dann Verschiebung
+struct BodyPose {
+    Vector3 axis{0.0, 0.0, 1.0};
+    double angle = 0.0;                   // [deg]
+    Vector3 pivot{0.0, 0.0, 0.0};
+    Vector3 translation{0.0, 0.0, 0.0};
+
+    RigidTransform transform() const;
+};
+
+// Gleichmäßiges Gitter start … end mit count Punkten (count = 1: nur start)
+struct GridRange {
+    double start = 0.0;
+    double end = 0.0;
+    int count = 1;
+
+    double value(int i) const { return count > 1 ? start + (end - start) * i / (count - 1) : start; }
+};
 
 struct SimulationConfig {
     std::string geometryFile = "models/Cube.obj";
-    std::string heatmapOutputFile = "output.vtk";
+    std::string heatmapOutputFile = "surfaceLoads.vtk";   // Oberflächenlasten pro Panel (TestMain)
     std::string model = "DRIA";
+    std::string solver = "hybrid";   // "hybrid" (Panelmethode + Rays) oder "raytrace"
     int rayCount = 1000;
     int maxBounces = 5;
+    std::string tracePrecision = "double";   // "float": Geometrie und Schnitttest in einfacher Genauigkeit
+    int visibilitySamples = 64;      // Sichtbarkeitsstrahlen pro Panel (hybrid)
+    int seed = -1;                   // ≥ 0: feste Zufallsfolgen (reproduzierbare Läufe)
+    std::string traceFile;           // Chrome-Trace-Ausgabe; leer = kein Tracing
+    int traceBufferEvents = 65536;   // Ringpuffergröße pro Thread
+    bool perfCounters = false;       // Hardware-Zähler (perf_event_open) um die Bounce-Schleife
+    int serviceCacheSize = 100000;   // DragService: gespeicherte Ergebnisse (0 = kein Cache)
+    double serviceQuantization = 1e-3;  // DragService: Rasterweite der Cache-Schlüssel (Richtung absolut, sonst relativ)
+    std::string atmosphereDirectory = "../assets/atmos_data";   // database_<alt>km.csv (TestMain)
+    std::string atmosphereCache = "atmos_data.cache";           // Binärcache aller Höhen; leer = keiner
+    std::string atmosphereModel = "table";   // "table" (CSV-Zeile) oder "empirical" (ThermosphereModel)
+    // Eingaben des empirischen Modells (Höhe von der Kommandozeile)
+    double latitude = 0.0;          // [deg]
+    double longitude = 0.0;         // [deg]
+    double dayOfYear = 1.0;
+    double utSeconds = 0.0;         // [s]
+    double f107 = 150.0;            // F10.7 des Vortags [sfu]
+    double f107a = 150.0;           // 81-Tage-Mittel [sfu]
+    double ap = 4.0;
+
+    // Koeffizientendatenbank (AeroDatabaseGenerator)
+    std::string databaseFile = "aero_database.adb";
+    GridRange databaseAoA{-30.0, 30.0, 13};              // Anstellwinkel [deg]
+    GridRange databaseSideslip{0.0, 0.0, 1};             // Schiebewinkel [deg]
+    GridRange databaseSpeedRatio{5.0, 12.0, 8};          // s = V / √(2kT/m̄)
+    GridRange databaseTemperatureRatio{0.2, 0.6, 5};     // T_w / T
+    double referenceLength = 1.0;                        // Bezugslänge der Momentenbeiwerte [m]
+    std::optional<Vector3> centerOfMass;                 // Momentenbezugspunkt; leer = Mitte der Bounding Box
+
+    // Lagen für TestMain (Anstellwinkel von der Kommandozeile); alle auf einem Mesh-Aufbau
+    GridRange attitudeSideslip{0.0, 0.0, 1};             // Schiebewinkel [deg]
+    GridRange attitudeRoll{0.0, 0.0, 1};                 // Rollwinkel [deg]
+    std::optional<std::array<double, 4>> attitudeQuaternion;   // w,x,y,z Körper → Referenz; ersetzt die Winkel
 
     double reflectionRatio = 0.5;
     double absorptionRatio = 0.2;
     double energyLoss = 0.1;
     double energyAccommodation = 1.0;
+    double normalAccommodation = 1.0;      // CLL α_n
+    double tangentialAccommodation = 1.0;  // CLL α_t (Energie; α_t = σ_t(2−σ_t))
     double kB = 1.380649e-23;
     double WallTemp = 300.0;
     double specularFraction = 0.3;
@@ -29,7 +99,17 @@ struct SimulationConfig {
     double temperature = 300.0;
     Vector3 flowVelocity = Vector3{0.0, 0.0, -1.0};
     std::map<std::string, SpeciesInfo> species;
+    std::map<std::string, MaterialInfo> materials;
+    std::map<std::string, BodyPose> bodies;   // OBJ o/g-Name → Lage relativ zur Datei
 };
+
+// Transformation je Triangle::bodyId; Namen ohne Teilkörper im Mesh werden gemeldet und übergangen
+std::vector<RigidTransform> resolveBodyTransforms(const std::map<std::string, BodyPose>& poses,
+                                                  const std::vector<std::string>& bodyNames);
+
+// "start,end,count" oder ein einzelner Wert
+GridRange parseGridRange(const std::string& value);
+
 class ConfigLoader {
 public:
     bool loadFromFile(const std::string& filename);
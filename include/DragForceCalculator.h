@@ -3,43 +3,97 @@
 
 #include "Vector3.h"
 #include "Ray.h"
-#include "Triangle.h"
+#include "TriangleTable.h"
+#include "HitInfo.h"
 #include <map>
 #include <vector>
 #include <string>
 
 struct PanelForce {
     Vector3 force = {0, 0, 0};
+    Vector3 moment = {0, 0, 0};   // um den Bezugspunkt, gleiche Vorzeichenkonvention wie force
     double area   = 0.0;
+
+    // Oberflächenlasten (nur über accumulateForce mit HitInfo bzw. addPanelLoad)
+    double heat = 0.0;                  // an die Wand abgegebene Energie pro Zeit [W]
+    double normalForce = 0.0;           // Druckkraft in die Wand hinein [N]
+    Vector3 shear = {0, 0, 0};          // Tangentialkraft auf den Körper [N]
+};
+
+// Windachsen zur Anströmrichtung: Auftrieb senkrecht zur Anströmung und zur Schiebeachse z (liegt in der
+// x-y-Ebene des Anstellwinkels), Seite = Auftrieb × Anströmung. Stetig für jeden Anstellwinkel; einzig
+// singulär bei Schiebewinkel ±90° (Anströmung entlang z), dort dreht der Auftrieb um die Anströmachse
+// und weicht exakt auf der Achse auf Körper-x aus.
+struct WindAxes {
+    Vector3 drag, lift, side;
+
+    static WindAxes fromFlow(const Vector3& flowDir) {
+        WindAxes w;
+        w.drag = flowDir.normalize();
+        const Vector3 l = w.drag.cross(Vector3{0, 0, 1});
+        w.lift = l.norm() > 1e-12 ? l.normalize() : Vector3{1, 0, 0};
+        w.side = w.lift.cross(w.drag);
+        return w;
+    }
 };
 
 class DragForceCalculator {
 public:
-    void setMesh(const std::vector<Vector3>& verts,
-                 const std::vector<Triangle>& tris);
+    // Panelflächen aus der gemeinsamen Dreieckstabelle übernehmen
+    void setMesh(const TriangleTable& table);
+
+    // Momentenbezugspunkt (z. B. Schwerpunkt) für alle folgenden Beiträge
+    void setReferencePoint(const Vector3& point) { referencePoint = point; }
 
     void accumulateForce(const Ray& in, const Ray& out, double area);
 
+    // Mit Moment (r − r_ref) × Δp am Trefferpunkt; Panel aus hit.panelId
+    void accumulateForce(const Ray& in, const Ray& out, double area, const HitInfo& hit);
+
+    // Vorberechneter Beitrag (z. B. Panelmethode), gleiche Vorzeichenkonvention wie accumulateForce
+    void addPanelForce(int panelId, const Vector3& deltaP);
+    void addPanelForce(int panelId, const Vector3& deltaP, const Vector3& point);
+
+    // Wie oben, zusätzlich Zerlegung in Druck/Schub (normal zeigt zur Gasseite) und Wärmestrom [W]
+    void addPanelLoad(int panelId, const Vector3& deltaP, const Vector3& point,
+                      const Vector3& normal, double heat);
+
     void merge(const DragForceCalculator& other);
 
     Vector3 getTotalDragForce() const { return totalForce; }
+    Vector3 getTotalMoment() const { return totalMoment; }
     
     Vector3 computeScaledForce(double totalMassFlux) const;
 
     void exportPanelForcesCSV(const std::string& filename) const;
 
-    const std::map<int, PanelForce>& getPanelForces() const {
-        return perPanelForces;
-    }
+    // Panels mit Einträgen (setMesh oder Beiträge) als Map, für Ausgabe und Tests
+    std::map<int, PanelForce> getPanelForces() const;
 
-private:
-    std::vector<Vector3> vertices;
-    std::vector<Triangle> triangles;
+    // Dichte Tabelle (panelLoadStride Werte pro Panel) für MPI_Reduce; unpack ersetzt die Panelwerte
+    static constexpr size_t panelLoadStride = 11;
+    std::vector<double> packPanelLoads(size_t panelCount) const;
+    void unpackPanelLoads(const std::vector<double>& packed);
 
-    std::map<int, PanelForce> perPanelForces;
+private:
+    // Dicht nach Panel-ID (keine Map-Suche pro Treffer); used markiert belegte Einträge, IDs < 0 zählen nur zur Summe
+    std::vector<PanelForce> perPanelForces;
+    std::vector<char> used;
     Vector3 totalForce = {0, 0, 0};
+    Vector3 totalMoment = {0, 0, 0};
+    Vector3 referencePoint = {0, 0, 0};
+
+    PanelForce* panel(int panelId) {
+        if (panelId < 0) return nullptr;
+        if (static_cast<size_t>(panelId) >= perPanelForces.size()) {
+            perPanelForces.resize(panelId + 1);
+            used.resize(panelId + 1, 0);
+        }
+        used[panelId] = 1;
+        return &perPanelForces[panelId];
+    }
 
-    double computeTriangleArea(const Triangle& tri) const;
+    static void addSurfaceLoad(PanelForce& pf, const Vector3& deltaP, const Vector3& normal, double heat);
 };
 
 #endif // DRAG_FORCE_CALCULATOR_H
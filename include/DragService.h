@@ -0,0 +1,82 @@
+#pragma once
+#include "ConfigLoader.h"
+#include "DragSolver.h"
+#include "Vector3.h"
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Eine Abfrage des Drag-Dienstes (eine Zeile des Socket-Protokolls)
+struct DragRequest {
+    std::string geometry;                       // beim Start registrierte Geometrie-ID
+    double attitude[4] = {1.0, 0.0, 0.0, 0.0};  // Quaternion Körper → Inertial (w, x, y, z)
+    Vector3 velocity = {0, 0, 0};               // Anströmung relativ zum Körper, inertial [m/s]
+    double temperature = 0.0;                   // [K]
+    std::map<std::string, double> densities;    // [1/m³]
+};
+
+struct DragServiceStats {
+    uint64_t requests = 0;
+    uint64_t cacheHits = 0;
+    uint64_t computed = 0;
+    uint64_t batches = 0;
+    uint64_t errors = 0;
+};
+
+/**
+ * Drag service core: resident geometries plus a result cache.
+ *
+ * Every geometry keeps its DragSolver (mesh, intersection engine, visibility
+ * graph) for the lifetime of the service. A request is rotated into the body
+ * frame and its inputs are quantized (flow direction per component, speed,
+ * temperature and densities on a logarithmic grid); requests with the same
+ * quantized key share one cached result. Cache misses of a batch are
+ * evaluated together with DragSolver::computeBatch. Only geometries added
+ * with addGeometry are served; unknown IDs are answered with an error.
+ *
+ * The socket transport lives in drag_service.cpp; this class only parses
+ * and answers text lines, so it can be tested without sockets.
+ */
+class DragService {
+public:
+    explicit DragService(const SimulationConfig& cfg);
+
+    // Geometrie beim Start laden; Abfragen mit unbekannter ID werden abgelehnt
+    bool addGeometry(const std::string& id, const std::string& path);
+    size_t getGeometryCount() const { return solvers.size(); }
+
+    // Ergebnisse im Körpersystem, eines pro Abfrage; cached[i] = aus dem Cache
+    std::vector<DragResult> handleBatch(const std::vector<DragRequest>& requests,
+                                        std::vector<char>* cached = nullptr);
+
+    // Je eine Antwort pro Protokollzeile (leer für Leer- und Kommentarzeilen)
+    std::vector<std::string> handleLines(const std::vector<std::string>& lines);
+
+    static bool parseRequest(const std::string& line, DragRequest& request, std::string& error);
+    static std::string formatResult(const DragResult& result, bool cached);
+
+    // serviceQuantization muss endlich und > 0 sein
+    static bool quantizationValid(double q);
+
+    // Anströmrichtung und -betrag im Körpersystem
+    static Vector3 toBodyFrame(const double attitude[4], const Vector3& v);
+
+    const DragServiceStats& getStats() const { return stats; }
+    size_t getCacheSize() const { return cache.size(); }
+
+private:
+    SimulationConfig cfg;
+    std::map<std::string, std::unique_ptr<DragSolver>> solvers;
+
+    std::unordered_map<std::string, DragResult> cache;
+    std::deque<std::string> cacheOrder;   // Einfügereihenfolge, älteste zuerst verdrängt
+    DragServiceStats stats;
+
+    DragSolver* findSolver(const std::string& id);
+    std::string cacheKey(const DragRequest& request) const;
+    void storeResult(const std::string& key, const DragResult& result);
+};
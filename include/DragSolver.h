@@ -0,0 +1,109 @@
+#pragma once
+#include "ConfigLoader.h"
+#include "IntersectionEngine.h"
+#include "MeshLoader.h"
+#include "PanelMethodEngine.h"
+#include "RigidTransform.h"
+#include "SurfaceInteractionModel.h"
+#include "Triangle.h"
+#include "TriangleTable.h"
+#include "Vector3.h"
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Anströmzustand einer Abfrage (Körperkoordinaten)
+struct FlowState {
+    Vector3 direction = Vector3{0.0, 0.0, -1.0};   // Anströmrichtung, wird normiert
+    double velocity = 7800.0;                      // Relativgeschwindigkeit [m/s]
+    double temperature = 1000.0;                   // Gastemperatur [K]
+    std::map<std::string, double> densities;       // Teilchendichte pro Spezies [1/m³]
+};
+
+// Ergebnis einer Abfrage; Kraft und Moment wirken auf den Körper
+struct DragResult {
+    Vector3 force = {0, 0, 0};       // [N]
+    Vector3 torque = {0, 0, 0};      // um den Referenzpunkt [N m]
+    double drag = 0.0;               // Kraftanteil entlang der Anströmung [N]
+    double cd = 0.0;                 // drag / (q · A_ref)
+    double dynamicPressure = 0.0;    // q = ½ ρ V² [Pa]
+    Vector3 forceError = {0, 0, 0};  // Standardfehler (1σ) des Monte-Carlo-Anteils
+    Vector3 torqueError = {0, 0, 0};
+    double cdError = 0.0;
+    int rays = 0;                    // Monte-Carlo-Strahlen (0 = rein analytisch)
+    bool valid = false;              // false: kein Mesh geladen oder unbekannte Spezies
+};
+
+/**
+ * In-process drag API (library target vleodrag).
+ *
+ * Loads the mesh once and builds the intersection engine, the surface
+ * materials and (solver = hybrid) the panel-method visibility graph. Every
+ * query then only evaluates the closed-form panels and traces rays for the
+ * coupled ones, without touching config.ini or writing files.
+ *
+ * Named sub-bodies of the mesh (OBJ o/g) can be moved between queries with
+ * setBodyTransform(); only the top level of the intersection hierarchy and
+ * the panel-method state are redone, not the mesh load or triangle BVHs.
+ *
+ * Surface model, solver, rayCount, seed, materials, body poses and the
+ * species masses come from the base configuration. A FlowState may only name species that
+ * have a mass there; species it does not name have zero density.
+ */
+class DragSolver {
+public:
+    explicit DragSolver(const SimulationConfig& base);
+
+    DragSolver(const DragSolver&) = delete;
+    DragSolver& operator=(const DragSolver&) = delete;
+
+    bool loadMesh(const std::string& path);
+    bool isReady() const { return !mesh.getTriangles().empty(); }
+
+    // Starre Teilkörper (OBJ o/g), Index = Triangle::bodyId (0 = Hauptkörper "")
+    const std::vector<std::string>& getBodyNames() const { return mesh.getBodyNames(); }
+
+    // Lage relativ zur geladenen Datei (nicht kumulativ); false bei unbekanntem Körper
+    bool setBodyTransform(const std::string& body, const RigidTransform& transform);
+    // Alle Teilkörper auf einmal (Index = bodyId, fehlende Einträge = geladene Lage)
+    void setBodyTransforms(const std::vector<RigidTransform>& transforms);
+    const std::vector<RigidTransform>& getBodyTransforms() const { return bodyTransforms; }
+
+    // Momentenbezugspunkt (Standard: Mitte der Bounding Box)
+    void setReferencePoint(const Vector3& point) { referencePoint = point; }
+    const Vector3& getReferencePoint() const { return referencePoint; }
+
+    // Bezugsfläche für C_D (Standard: halbe Oberfläche wie in TestMain)
+    void setReferenceArea(double area) { referenceArea = area; }
+    double getReferenceArea() const { return referenceArea; }
+
+    // Panels, die per Monte Carlo gerechnet werden (alle bei solver = raytrace)
+    size_t getCoupledPanelCount() const;
+
+    DragResult compute(const FlowState& state) const;
+
+    // Mehrere Zustände; parallel über die Zustände, die Strahlschleifen laufen dann seriell
+    std::vector<DragResult> computeBatch(const std::vector<FlowState>& states) const;
+
+private:
+    SimulationConfig base;
+    bool hybrid = true;
+    SurfaceModelType modelType = SurfaceModelType::DRIA;
+
+    MeshLoader mesh;                                    // geladene Lage
+    std::vector<RigidTransform> bodyTransforms;         // je bodyId
+    std::vector<Vector3> vertices;                      // mit bewegten Teilkörpern
+    std::shared_ptr<const TriangleTable> triangleTable; // mit bewegten Teilkörpern (nur hybrid nachgeführt)
+    std::vector<int> coupledPanels;
+
+    IntersectionEngine engine;
+    SurfaceInteractionModel model;
+    PanelMethodEngine panelMethod;
+
+    Vector3 referencePoint = {0, 0, 0};
+    double referenceArea = 0.0;
+
+    SimulationConfig makeConfig(const FlowState& state) const;
+    void preparePanelMethod();
+};
@@ -1,9 +1,11 @@
 #pragma once
 #include "Ray.h"
+#include <map>
 #include <string>
 #include <vector>
 #include "Vector3.h"
 #include "Triangle.h"
+#include "DragForceCalculator.h"
 
 class HeatmapExporter {
 public:
@@ -11,6 +13,18 @@ public:
                           const std::vector<Vector3>& vertices,
                           const std::vector<Triangle>& triangles,
                           const std::vector<double>& scalars);  // z. B. Kraftbeträge pro Panel
+
+    // Skalarwert pro Panel (Schlüssel = panelId)
+    static void exportHeatmapAsVTK(const std::string& filename,
+                                   const std::map<int, double>& values,
+                                   const std::vector<Triangle>& tris,
+                                   const std::vector<Vector3>& vertices);
+
+    // Oberflächenlasten pro Panel: Kraft, Wärmestromdichte, Druck und Schubspannung als Zellfelder
+    static void exportPanelLoadsAsVTK(const std::string& filename,
+                                      const std::map<int, PanelForce>& loads,
+                                      const std::vector<Triangle>& tris,
+                                      const std::vector<Vector3>& vertices);
                           
     static void exportRaysAsVTK(const std::string& filename,
                             const std::vector<std::pair<Vector3, Vector3>>& raySegments,
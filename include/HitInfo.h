@@ -5,8 +5,9 @@
 
 struct HitInfo {
     Vector3 point;       // Schnittpunkt
-    Vector3 normal;      // Normale am Schnittpunkt
+    Vector3 normal;      // Einheitsnormale am Schnittpunkt (zur Strahlseite)
     int panelId;         // ID des Panels, das getroffen wurde
     Ray nextRay;         // Optional: vorberechneter reflektierter Ray (optional verwendet)
     double t;            // Abstand entlang des Strahls
+    int materialId = 0;  // Material des getroffenen Panels
 };
@@ -0,0 +1,61 @@
+#pragma once
+#include "RigidTransform.h"
+#include "TriangleTable.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Platzierung eines Prototyps: Panel-ID im Ergebnis = Panel-ID der Prototypzeile + panelOffset
+struct MeshInstance {
+    uint32_t prototype = 0;
+    RigidTransform transform;   // Prototyp-Koordinaten (= erstes Vorkommen) → geladene Lage
+    int panelOffset = 0;
+    int body = 0;               // Teilkörper; seine Transformation wirkt zusätzlich (IntersectionEngine::setBodyTransforms)
+};
+
+/**
+ * Two-level view of a mesh for ray tracing.
+ *
+ * A prototype is a set of rows of the shared triangle table, in the
+ * coordinates of its first occurrence. Instances place prototypes with a
+ * rigid transform and shift their panel IDs, so a repeated sub-mesh (array
+ * cells, identical bodies) is stored and indexed once. The triangle table
+ * itself keeps one row per panel for panel-method and force code; only the
+ * tracing structures built on top scale with the unique geometry.
+ *
+ * No prototype spans two rigid sub-bodies, so moving a body only moves
+ * its instances.
+ */
+class InstancedMesh {
+public:
+    InstancedMesh() = default;
+
+    // Ganze Tabelle als ein Prototyp je Teilkörper mit einer Instanz (Identität)
+    explicit InstancedMesh(std::shared_ptr<const TriangleTable> table);
+
+    InstancedMesh(std::shared_ptr<const TriangleTable> table, std::vector<std::vector<uint32_t>> prototypes,
+                  std::vector<MeshInstance> instances);
+
+    /**
+     * Finds repeated parts by rigid congruence.
+     *
+     * @param componentOf Connected component per table row (e.g. from MeshOrientation).
+     */
+    static std::shared_ptr<const InstancedMesh> detect(std::shared_ptr<const TriangleTable> table,
+                                                       const std::vector<int>& componentOf);
+
+    const TriangleTable& getTriangleTable() const { return *table; }
+    std::shared_ptr<const TriangleTable> getTriangleTablePtr() const { return table; }
+
+    // Tabellenzeilen je Prototyp
+    const std::vector<std::vector<uint32_t>>& getPrototypes() const { return prototypes; }
+    const std::vector<MeshInstance>& getInstances() const { return instances; }
+
+    // Dreiecke, die tatsächlich gespeichert und indiziert werden
+    size_t uniqueTriangleCount() const;
+
+private:
+    std::shared_ptr<const TriangleTable> table = std::make_shared<const TriangleTable>();
+    std::vector<std::vector<uint32_t>> prototypes;
+    std::vector<MeshInstance> instances;
+};
@@ -1,24 +1,75 @@
 #pragma once
 #include "MeshLoader.h"
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <memory>
 #include <vector>
 #include <optional>
 #include "Vector3.h"
 #include "Ray.h"
 #include "Triangle.h"
+#include "TriangleTable.h"
+#include "InstancedMesh.h"
+#include "Bvh.h"
 #include "HitInfo.h"
+#include "RunProfiler.h"
+
+// Genauigkeit von Geometrie und Schnitttest; Trefferpunkte und Akkumulation bleiben double
+enum class TracePrecision { Double, Float };
+
+TracePrecision parseTracePrecision(const std::string& name);
 
 class IntersectionEngine {
     public:
+        // Vor setMesh setzen; Float hält die Eckpunkte nur in einfacher Genauigkeit
+        void setPrecision(TracePrecision p) { precision = p; }
+        TracePrecision getPrecision() const { return precision; }
+
+        // Vor setMesh setzen; ohne Hierarchie unter den Instanzen (lohnt nur für sehr wenige Strahlen)
+        void setLinearScan(bool enabled) { linearScan = enabled; }
+
+        void setMesh(std::shared_ptr<const InstancedMesh> mesh);
+        void setMesh(std::shared_ptr<const TriangleTable> table);
         void setMesh(const std::vector<Vector3>& verts, const std::vector<Triangle>& tris);
+        // Lage der Teilkörper (Index = bodyId, fehlende Einträge = geladene Lage); erneuert nur die obere Ebene
+        void setBodyTransforms(const std::vector<RigidTransform>& bodyTransforms);
+
+        // Tabelle in geladener Lage (ohne Körpertransformationen)
+        const TriangleTable& getTriangleTable() const { return mesh->getTriangleTable(); }
+        const InstancedMesh& getInstancedMesh() const { return *mesh; }
     
-        std::optional<HitInfo> intersect(const Ray& ray) const;
-    
-        
+        // stats (optional) zählt Dreiecks- und Knotentests
+        std::optional<HitInfo> intersect(const Ray& ray, TraversalStats* stats = nullptr) const;
     
     private:
-        std::vector<Vector3> vertices;
-        std::vector<Triangle> triangles;
-        
-        bool intersects(const Ray& ray, const Vector3& v0, const Vector3& v1, const Vector3& v2, double& t) const;
+        // Untere Ebene je Prototyp: BVH über seine Zeilen; Tabellenzeile und Float-Ecken je Blattposition
+        struct BottomLevel {
+            Bvh bvh;
+            std::vector<uint32_t> rows;
+            std::array<std::vector<float>, 9> cornersF;   // Float: Ecke k, Achse a in cornersF[3k + a]
+        };
+
+        // Bisher nächster Treffer; bei gleichem t gewinnt die kleinere Panel-ID
+        struct Nearest {
+            double t = std::numeric_limits<double>::infinity();
+            int panelId = std::numeric_limits<int>::max();
+            const TriangleAttributes* row = nullptr;
+            uint32_t instance = 0;
+        };
+
+        TracePrecision precision = TracePrecision::Double;
+        bool linearScan = false;
+        std::shared_ptr<const InstancedMesh> mesh = std::make_shared<const InstancedMesh>();
+        std::vector<BottomLevel> bottom;
+        std::vector<RigidTransform> placement;   // Prototyp → Welt je Instanz, inkl. Körpertransformation
+        std::vector<char> identity;   // Instanz ohne Transformation (Test direkt in Weltkoordinaten)
+        std::vector<Aabb> instanceBoxes;          // Weltbox je Instanz
+        std::vector<RigidTransform> bodyPose;     // zuletzt gesetzte Körpertransformationen
+        Bvh top;                      // obere Ebene über den Weltboxen der Instanzen
+
+        void placeInstance(size_t instance, const RigidTransform& body);
 
+        void intersectPrototype(uint32_t instance, const Vector3& origin, const Vector3& direction, int skipPanel,
+                                Nearest& nearest, TraversalStats* stats) const;
     };
@@ -0,0 +1,46 @@
+#pragma once
+#include "ConfigLoader.h"
+#include <string>
+#include <vector>
+
+class CLLTable;
+
+// Oberflächenparameter eines Materials, von den Reflexionskernen per Index gelesen
+struct SurfaceMaterial {
+    double energyAccommodation = 1.0;
+    double wallTemperature = 300.0;
+    double specularFraction = 0.3;
+    double reflectionRatio = 0.5;
+    double energyLoss = 0.1;
+    double normalAccommodation = 1.0;
+    double tangentialAccommodation = 1.0;
+    const CLLTable* cllTable = nullptr;   // nur für CLL gesetzt
+
+    // Globale Werte aus der Konfiguration (bei CLL inklusive aufgelöster Tabelle)
+    static SurfaceMaterial fromConfig(const SimulationConfig& cfg);
+};
+
+/**
+ * Compact table of surface materials indexed by Triangle::materialId.
+ *
+ * Entry 0 is the default material built from the global configuration; every
+ * material name found in the mesh gets its own entry, with values from the
+ * matching [material:<name>] section and the global values as fallback.
+ */
+class MaterialTable {
+public:
+    void build(const SimulationConfig& cfg, const std::vector<std::string>& meshMaterialNames);
+
+    const SurfaceMaterial& operator[](int materialId) const { return materials[materialId]; }
+    bool contains(int materialId) const {
+        return materialId >= 0 && static_cast<size_t>(materialId) < materials.size();
+    }
+
+    size_t size() const { return materials.size(); }
+    bool empty() const { return materials.empty(); }
+    const std::string& getName(int materialId) const { return names[materialId]; }
+
+private:
+    std::vector<SurfaceMaterial> materials;
+    std::vector<std::string> names;
+};
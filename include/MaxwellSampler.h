@@ -4,10 +4,11 @@
 
 class MaxwellSampler {
 public:
-    MaxwellSampler(double temperature, double mass, Vector3 drift);
+    // seed < 0: Startwert aus std::random_device
+    MaxwellSampler(double temperature, double mass, Vector3 drift, long long seed = -1);
 
     // Eine einzelne Geschwindigkeit im Halbraum (gerichtet entlang Drift)
-    Vector3 sampleVelocity();
+    Vector3 sampleVelocity() const;
 
 private:
     double mass;
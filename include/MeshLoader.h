@@ -2,8 +2,13 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <memory>
 #include "Vector3.h"
 #include "Triangle.h"
+#include "TriangleTable.h"
+#include "RigidTransform.h"
+#include "MeshOrientation.h"
+#include "InstancedMesh.h"
 
 class MeshLoader {
 public:
@@ -13,6 +18,24 @@ public:
     const std::vector<Vector3>& getVertices() const;
     const std::vector<Triangle>& getTriangles() const;
 
+    // Nach der Windungskorrektur einmal berechnete Dreiecksattribute (von allen Komponenten geteilt)
+    std::shared_ptr<const TriangleTable> getTriangleTable() const;
+
+    // Wiederholte Teile als Instanzen eines Prototyps, für IntersectionEngine::setMesh
+    std::shared_ptr<const InstancedMesh> getInstancedMesh() const;
+
+    // Komponenten, gedrehte Dreiecke, offene/nichtmannigfaltige Kanten der letzten Orientierung
+    const MeshTopologyReport& getTopologyReport() const;
+
+    // Materialnamen, Index = Triangle::materialId (0 = Standardmaterial "")
+    const std::vector<std::string>& getMaterialNames() const;
+
+    // Namen der starren Teilkörper (OBJ o/g), Index = Triangle::bodyId (0 = Hauptkörper "")
+    const std::vector<std::string>& getBodyNames() const;
+
+    // Vertices mit bewegten Teilkörpern (Transformation je bodyId; jeder Vertex gehört genau einem Körper)
+    std::vector<Vector3> getPosedVertices(const std::vector<RigidTransform>& bodyTransforms) const;
+
     std::pair<Vector3, Vector3> getBoundingBox() const;
     std::pair<Vector3, Vector3> getBoundingBox(double paddingFraction) const;
     Vector3 getCenter(double paddingFraction) const;
@@ -21,4 +44,12 @@ public:
 private:
     std::vector<Vector3> vertices;
     std::vector<Triangle> triangles;
+    std::vector<std::string> materialNames;
+    std::vector<std::string> bodyNames;
+    std::vector<int> vertexBody;   // Teilkörper je Vertex
+    std::shared_ptr<const TriangleTable> triangleTable = std::make_shared<const TriangleTable>();
+    std::shared_ptr<const InstancedMesh> instancedMesh = std::make_shared<const InstancedMesh>();
+    MeshTopologyReport topology;
+
+    void separateBodies();
 };
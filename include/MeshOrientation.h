@@ -0,0 +1,37 @@
+#pragma once
+#include "Vector3.h"
+#include "Triangle.h"
+#include <cstddef>
+#include <vector>
+
+// Ergebnis der Orientierung: Topologie und Anzahl gedrehter Dreiecke
+struct MeshTopologyReport {
+    size_t components = 0;          // über Mannigfaltigkeitskanten zusammenhängende Teile
+    size_t flippedFaces = 0;
+    size_t openEdges = 0;           // Kanten mit nur einem Dreieck
+    size_t nonManifoldEdges = 0;    // Kanten mit mehr als zwei Dreiecken
+    size_t inconsistentEdges = 0;   // nicht orientierbar (z. B. Möbiusband)
+
+    bool isClosedManifold() const { return openEdges == 0 && nonManifoldEdges == 0 && inconsistentEdges == 0; }
+};
+
+/**
+ * Topology-based outward orientation.
+ *
+ * Vertices at identical positions are welded for the adjacency only. Each
+ * triangle finds its neighbours across edges shared by exactly two
+ * triangles; open and non-manifold edges do not connect. Within every
+ * connected component the winding is propagated breadth-first so that shared
+ * edges are traversed in opposite directions. The component is then flipped
+ * as a whole if it encloses a negative volume (closed components), or else if
+ * a majority of parity rays, cast from sample points along the propagated
+ * normals through the intersection engine, cross the component's own surface
+ * an odd number of times (i.e. start into its interior). Components are
+ * processed in parallel.
+ */
+class MeshOrientation {
+public:
+    // componentOf (optional): Komponente je Dreieck
+    static MeshTopologyReport orientOutward(const std::vector<Vector3>& vertices, std::vector<Triangle>& triangles,
+                                            std::vector<int>* componentOf = nullptr);
+};
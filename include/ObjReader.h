@@ -0,0 +1,31 @@
+#pragma once
+#include "Vector3.h"
+#include "Triangle.h"
+#include <string>
+#include <vector>
+
+/**
+ * Parallel Wavefront OBJ reader for large meshes.
+ *
+ * The file is memory-mapped and split into chunks at line boundaries. A
+ * first parallel pass counts vertices and triangles per chunk; their prefix
+ * sums give every chunk its slice of the output arrays, which are sized
+ * once. Vertices and faces are then parsed in parallel directly into those
+ * slices, without an intermediate attribute copy.
+ *
+ * Supported: `v`, `f` (v, v/vt, v//vn, v/vt/vn, negative indices),
+ * `mtllib`/`usemtl`, `o`/`g` (the latest of either names the rigid sub-body
+ * of the following faces). Quads are split along the shorter diagonal, larger
+ * polygons as a fan. Faces with repeated vertex indices are dropped. Other
+ * statements (vn, vt, s, l, comments) are ignored.
+ */
+class ObjReader {
+public:
+    // Panel-IDs 0..n−1 in Dateireihenfolge; materialNames[0] = "" (Standardmaterial), mtllib-Material k → k + 1;
+    // bodyNames[0] = "" (Faces vor dem ersten o/g), weitere Namen in Dateireihenfolge
+    static bool read(const std::string& filename,
+                     std::vector<Vector3>& vertices,
+                     std::vector<Triangle>& triangles,
+                     std::vector<std::string>& materialNames,
+                     std::vector<std::string>& bodyNames);
+};
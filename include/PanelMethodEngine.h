@@ -0,0 +1,96 @@
+#pragma once
+#include "Vector3.h"
+#include "Triangle.h"
+#include "TriangleTable.h"
+#include "ConfigLoader.h"
+#include "MaterialTable.h"
+#include "SurfaceInteractionModel.h"
+#include <memory>
+#include <vector>
+#include <utility>
+
+class IntersectionEngine;
+
+/**
+ * Closed-form free-molecular panel method (Sentman / DRIA).
+ *
+ * Panels that cannot see any other panel are "isolated": the free stream
+ * reaches them unobstructed and re-emitted molecules escape, so their force
+ * is exact without rays. Only the remaining panels need Monte Carlo.
+ *
+ * The closed form describes fully diffuse re-emission. Panels whose surface
+ * model reflects partly specularly (Sentman with specularFraction > 0, CLL
+ * with incomplete accommodation, Classic) are never isolated and always
+ * traced, so hybrid and raytrace use the same physics for every panel.
+ * Panels of open components (thin plates) are two-sided: both faces meet the
+ * flow and may see other panels.
+ */
+class PanelMethodEngine {
+public:
+    void setMesh(std::shared_ptr<const TriangleTable> table);
+    void setMesh(const std::vector<Vector3>& verts, const std::vector<Triangle>& tris);
+
+    // Oberflächenmodell der Strahlverfolgung (Standard: DRIA); vor detectIsolatedPanels setzen
+    void setSurfaceModel(const SimulationConfig& cfg);
+
+    // Konsolenausgabe der Panelzahlen
+    void setVerbose(bool enabled) { verbose = enabled; }
+
+    // Markiert alle Panels, die kein anderes Panel sehen können
+    void detectIsolatedPanels();
+
+    // Sichtbarkeitsgraph per Strahl-Sampling verfeinern (nach detectIsolatedPanels)
+    void buildVisibilityGraph(const IntersectionEngine& engine, int samplesPerPanel = 64);
+
+    // Geschätzte Sichtfaktoren F_ij (panelId, Anteil) eines Panels
+    const std::vector<std::pair<int, double>>& getViewFactors(int panelId) const;
+
+    // Panels mit Sichtkontakt, die per Monte Carlo gerechnet werden müssen
+    std::vector<int> getCoupledPanels() const;
+
+    // Panel-Materialien (Wandtemperatur, Akkommodation); ohne Tabelle gelten die globalen Werte
+    void setMaterials(const MaterialTable& table) { materials = &table; }
+
+    bool isIsolated(int panelId) const;
+    // Voll diffuse Wiederemission, d. h. die geschlossene Lösung gilt
+    bool hasClosedForm(int panelId) const;
+    // Panel eines offenen Teils (beide Seiten umströmt)
+    bool isTwoSided(int panelId) const;
+    // Panels, die erst das Strahl-Sampling als isoliert erkannt hat
+    size_t getSampledIsolatedCount() const { return sampledIsolated; }
+    size_t getIsolatedCount() const;
+    bool allIsolated() const;
+
+    // Kraft auf den Körper [N] für ein einzelnes Panel (alle Spezies)
+    Vector3 computePanelForce(const SimulationConfig& cfg, int panelId) const;
+
+    // An die Wand abgegebene Leistung [W] eines Panels (translatorisch, alle Spezies)
+    double computePanelHeatLoad(const SimulationConfig& cfg, int panelId) const;
+
+    // Nach außen zeigende Einheitsnormale und Schwerpunkt eines Panels
+    Vector3 getPanelNormal(int panelId) const;
+    Vector3 getPanelCentroid(int panelId) const;
+
+    // Summe über alle isolierten Panels; optional Kraft pro Panel (Index = panelId)
+    Vector3 computeAnalyticForce(const SimulationConfig& cfg,
+                                 std::vector<Vector3>* perPanel = nullptr) const;
+
+private:
+    std::shared_ptr<const TriangleTable> table = std::make_shared<const TriangleTable>();
+    std::vector<char> isolated;
+    std::vector<char> twoSided;
+    std::vector<std::vector<std::pair<int, double>>> viewFactors;
+    size_t sampledIsolated = 0;
+    double planeTolerance = 1e-12;
+    const MaterialTable* materials = nullptr;
+    SurfaceModelType surfaceModel = SurfaceModelType::DRIA;
+    SurfaceMaterial defaultMaterial;
+    bool verbose = true;
+
+    int indexOf(int panelId) const { return table->indexOf(panelId); }
+    const SurfaceMaterial& materialOf(size_t panel) const;
+    bool closedForm(size_t panel) const;
+    // Mindestens ein Eckpunkt von other liegt vor panel (bei zweiseitigen Panels: auf einer der Seiten)
+    bool sees(size_t panel, size_t other) const;
+    void detectTwoSidedPanels();
+};
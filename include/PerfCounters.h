@@ -0,0 +1,50 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+// Hardware-Zählerstände (User-Space) eines oder mehrerer Threads
+struct HardwareCounts {
+    uint64_t cycles = 0;
+    uint64_t instructions = 0;
+    uint64_t cacheMisses = 0;
+    uint64_t branchMisses = 0;
+    uint64_t threads = 0;        // Threads mit gültigen Zählern
+
+    void merge(const HardwareCounts& other) {
+        cycles += other.cycles;
+        instructions += other.instructions;
+        cacheMisses += other.cacheMisses;
+        branchMisses += other.branchMisses;
+        threads += other.threads;
+    }
+};
+
+/**
+ * perf_event_open counter group (cycles, instructions, cache misses, branch
+ * misses) for the calling thread.
+ *
+ * If the counters cannot be opened (no Linux, perf_event_paranoid too strict,
+ * virtual machine without PMU) the group is a no-op: start() does nothing and
+ * stop() returns zero counts with threads = 0.
+ */
+class PerfCounterGroup {
+public:
+    PerfCounterGroup();
+    ~PerfCounterGroup();
+
+    PerfCounterGroup(const PerfCounterGroup&) = delete;
+    PerfCounterGroup& operator=(const PerfCounterGroup&) = delete;
+
+    bool available() const { return fds[0] >= 0; }
+
+    // Grund, falls nicht verfügbar (für eine einmalige Warnung)
+    const std::string& error() const { return reason; }
+
+    void start();
+    HardwareCounts stop();
+
+private:
+    static constexpr int eventCount = 4;
+    int fds[eventCount] = {-1, -1, -1, -1};
+    std::string reason;
+};
@@ -1,7 +1,5 @@
 #pragma once
 #include "Vector3.h"
-#include <string>
-#include <cstring>
 
 struct Ray {
     Vector3 origin;
@@ -11,7 +9,7 @@ struct Ray {
     double energy = 0.0;
     double speciesMass = 0.0;
     double speciesDensity = 0.0;
-    std::string speciesName;
+    int speciesId = -1;   // Index in SimulationConfig::species (Map-Reihenfolge)
     bool active = true;
     double weight = 1.0;
     int panelId = -1;
@@ -27,7 +25,7 @@ struct RayMPI {
     double energy;
     double speciesMass;
     double speciesDensity;
-    char speciesName[32];
+    int speciesId;
     bool active;
     double weight;
     int panelId;
@@ -45,7 +43,7 @@ inline RayMPI toRayMPI(const Ray& ray) {
     r.energy = ray.energy;
     r.speciesMass = ray.speciesMass;
     r.speciesDensity = ray.speciesDensity;
-    std::strncpy(r.speciesName, ray.speciesName.c_str(), sizeof(r.speciesName) - 1);
+    r.speciesId = ray.speciesId;
     r.active = ray.active;
     r.weight = ray.weight;
     r.panelId = ray.panelId;
@@ -61,7 +59,7 @@ inline Ray fromRayMPI(const RayMPI& r) {
     ray.energy = r.energy;
     ray.speciesMass = r.speciesMass;
     ray.speciesDensity = r.speciesDensity;
-    ray.speciesName = std::string(r.speciesName);
+    ray.speciesId = r.speciesId;
     ray.active = r.active;
     ray.weight = r.weight;
     ray.panelId = r.panelId;
@@ -0,0 +1,45 @@
+#pragma once
+#include "Vector3.h"
+#include <cmath>
+
+// Starre Transformation x' = R·x + t; R als Zeilen gespeichert, R⁻¹ = Rᵀ
+struct RigidTransform {
+    Vector3 row0{1.0, 0.0, 0.0};
+    Vector3 row1{0.0, 1.0, 0.0};
+    Vector3 row2{0.0, 0.0, 1.0};
+    Vector3 translation;
+
+    Vector3 rotate(const Vector3& v) const { return {row0.dot(v), row1.dot(v), row2.dot(v)}; }
+    Vector3 rotateInverse(const Vector3& v) const { return row0 * v.x + row1 * v.y + row2 * v.z; }
+    Vector3 apply(const Vector3& p) const { return rotate(p) + translation; }
+    Vector3 applyInverse(const Vector3& p) const { return rotateInverse(p - translation); }
+
+    // Erst other, dann diese Transformation
+    RigidTransform operator*(const RigidTransform& other) const {
+        RigidTransform T;
+        T.row0 = other.rotateInverse(row0);
+        T.row1 = other.rotateInverse(row1);
+        T.row2 = other.rotateInverse(row2);
+        T.translation = apply(other.translation);
+        return T;
+    }
+
+    // Drehung um die Achse durch pivot (Rodrigues), Winkel im Bogenmaß
+    static RigidTransform rotation(const Vector3& axis, double angle, const Vector3& pivot = Vector3()) {
+        RigidTransform T;
+        const Vector3 k = axis.normalize();
+        const double c = std::cos(angle), s = std::sin(angle), C = 1.0 - c;
+        T.row0 = {c + k.x * k.x * C, k.x * k.y * C - k.z * s, k.x * k.z * C + k.y * s};
+        T.row1 = {k.y * k.x * C + k.z * s, c + k.y * k.y * C, k.y * k.z * C - k.x * s};
+        T.row2 = {k.z * k.x * C - k.y * s, k.z * k.y * C + k.x * s, c + k.z * k.z * C};
+        T.translation = pivot - T.rotate(pivot);
+        return T;
+    }
+
+    // Exakt die Einheitstransformation (dann rechnet der Schnitttest ohne Umweg in Weltkoordinaten)
+    bool isIdentity() const {
+        return row0.x == 1.0 && row0.y == 0.0 && row0.z == 0.0 && row1.x == 0.0 && row1.y == 1.0 &&
+               row1.z == 0.0 && row2.x == 0.0 && row2.y == 0.0 && row2.z == 1.0 && translation.x == 0.0 &&
+               translation.y == 0.0 && translation.z == 0.0;
+    }
+};
@@ -0,0 +1,130 @@
+#pragma once
+#include "PerfCounters.h"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+// Stufen der Pipeline, die im Laufbericht getrennt ausgewiesen werden
+enum class Stage {
+    Config, MeshLoad, AccelBuild, Generation, Scatter,
+    Intersect, Reflect, Accumulate, Reduce, Export,
+    Count
+};
+
+const char* stageName(Stage stage);
+
+using StageClock = std::chrono::steady_clock;
+
+inline double secondsSince(StageClock::time_point start) {
+    return std::chrono::duration<double>(StageClock::now() - start).count();
+}
+
+// Zähler der Dreiecks- bzw. Knotentests einer Schnittpunktsuche
+struct TraversalStats {
+    uint64_t primitiveTests = 0;
+    uint64_t nodeTests = 0;      // Boxtests beider BVH-Ebenen
+};
+
+/**
+ * Timers and counters of one thread.
+ *
+ * Only the owning thread writes to it, so increments need no atomics; the
+ * alignment keeps neighbouring threads on separate cache lines.
+ */
+struct alignas(64) ThreadCounters {
+    static constexpr int maxDepth = 16;  // letzter Histogramm-Eintrag = ≥ maxDepth
+
+    std::array<double, static_cast<size_t>(Stage::Count)> seconds{};
+    uint64_t rays = 0;
+    uint64_t intersectCalls = 0;
+    uint64_t hits = 0;
+    TraversalStats traversal;
+    HardwareCounts hardware;     // nur mit perfCounters = true
+    std::array<uint64_t, maxDepth + 1> bounceHistogram{};
+
+    void add(Stage stage, double sec) { seconds[static_cast<size_t>(stage)] += sec; }
+    double get(Stage stage) const { return seconds[static_cast<size_t>(stage)]; }
+
+    void recordRay(int bounces);
+    void merge(const ThreadCounters& other);
+};
+
+// Misst die Dauer eines Blocks und bucht sie beim Verlassen auf eine Stufe
+class ScopedStage {
+public:
+    ScopedStage(ThreadCounters& counters, Stage stage)
+        : counters(counters), stage(stage), start(StageClock::now()) {}
+    ~ScopedStage() { counters.add(stage, secondsSince(start)); }
+
+    ScopedStage(const ScopedStage&) = delete;
+    ScopedStage& operator=(const ScopedStage&) = delete;
+
+private:
+    ThreadCounters& counters;
+    Stage stage;
+    StageClock::time_point start;
+};
+
+// Zusammenfassung eines MPI-Rangs, als festes double-Array per MPI übertragbar
+struct RankSummary {
+    ThreadCounters counters;     // Rang-Stufen + Summe aller Threads
+    double loopSeconds = 0.0;    // Wandzeit der Strahlschleife
+    double threadBusyMax = 0.0;
+    double threadBusyMean = 0.0;
+    double maxRssMB = 0.0;       // Speicher-Hochwassermarke des Prozesses
+    int threads = 1;
+
+    static constexpr size_t packedSize =
+        static_cast<size_t>(Stage::Count) + 5 + 5 + (ThreadCounters::maxDepth + 1) + 5;
+
+    void pack(double* out) const;
+    static RankSummary unpack(const double* in);
+};
+
+/**
+ * Per-rank profiler: one ThreadCounters per OpenMP thread for the hot path
+ * plus one for the serial stages of the rank.
+ */
+class RunProfiler {
+public:
+    // Hot-Path-Zeiten werden nur für jeden timingStride-ten Strahl gemessen und hochskaliert
+    static constexpr int timingStride = 8;
+
+    explicit RunProfiler(int threads = 1);
+
+    ThreadCounters& rank() { return rankCounters; }
+    ThreadCounters& thread(int tid) { return threadCounters[tid]; }
+
+    // Wandzeit der Strahlschleife des Rangs und Arbeitszeit je Thread
+    void setLoopSeconds(double sec) { loopSeconds = sec; }
+    void setThreadBusy(int tid, double sec) { threadBusy[tid] = sec; }
+
+    RankSummary summarize() const;
+
+private:
+    ThreadCounters rankCounters;
+    std::vector<ThreadCounters> threadCounters;
+    std::vector<double> threadBusy;
+    double loopSeconds = 0.0;
+};
+
+/**
+ * Machine-readable run report (JSON): run metadata, per-stage times, hot-path
+ * counters, hardware counters (if collected), bounce-depth histogram and
+ * rank/thread imbalance.
+ */
+class RunReport {
+public:
+    void set(const std::string& key, const std::string& value);
+    void set(const std::string& key, double value);
+    void setResult(const std::string& key, double value);
+
+    bool write(const std::string& filename, const std::vector<RankSummary>& ranks) const;
+
+private:
+    std::map<std::string, std::string> run;      // bereits als JSON-Wert formatiert
+    std::map<std::string, std::string> results;
+};
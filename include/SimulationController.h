@@ -5,6 +5,7 @@
 #include "Ray.h"
 #include "PanelStats.h"
 #include "MeshLoader.h"
+#include "Attitude.h"
 #include <vector>
 #include <map>
 #include <string>
@@ -17,14 +18,22 @@ class SimulationController {
 public:
     void loadMesh(const std::string& path);
     void setSurfaceModel(SurfaceInteractionModel* model);
-    void setIntersectionEngine(IntersectionEngine* engine);
+    void setIntersectionEngine(const IntersectionEngine* engine);
+
+    // Konsolenausgabe und ray_debug.vtk bei der Strahlerzeugung (aus für Bibliotheksaufrufe)
+    void setVerbose(bool enabled) { verbose = enabled; }
+
+    // Lage des Körpers zur Anströmung; config.flowVelocity gilt dann im Referenzsystem
+    void setAttitude(const Attitude& a) { attitude = a; }
+    const Attitude& getAttitude() const { return attitude; }
 
     void generateMixedRays(const SimulationConfig& config,
                            const std::vector<Triangle>& triangles,
                            const std::vector<Vector3>& vertices,
                            double paddingFraction,
                            int rayCount,
-                           int totalRayCount); // <- NEU
+                           int totalRayCount, // <- NEU
+                           const std::vector<int>* targetPanels = nullptr);
 
 
     int getHitCount() const;
@@ -46,12 +55,14 @@ public:
 private:
     MeshLoader meshLoader;
     SurfaceInteractionModel* surfaceModel = nullptr;
-    IntersectionEngine* intersectionEngine = nullptr;
+    const IntersectionEngine* intersectionEngine = nullptr;
 
     std::vector<Ray> rays;
     std::map<int, PanelStats> panelStats;
 
     double raySourceArea = 1.0;
+    bool verbose = true;
+    Attitude attitude;   // Standard: Referenz- = Körpersystem
 
     DragForceCalculator dragCalculator;
 };
@@ -3,27 +3,219 @@
 #include "Ray.h"
 #include "HitInfo.h"
 #include "ConfigLoader.h"
-#include "Triangle.h"
+#include "TriangleTable.h"
+#include "CLLTable.h"
+#include "MaterialTable.h"
+#include <memory>
 #include <vector>
+#include <string>
+#include <random>
+#include <cmath>
+
+// Einmal beim Setup aus cfg.model aufgelöst, danach nur noch Template-Parameter
+enum class SurfaceModelType { DRIA, Sentman, CLL, Classic };
+
+SurfaceModelType parseSurfaceModel(const std::string& name);
+
+// Zufallszahlen der Reflexionskerne, ein Generator pro Thread
+struct SurfaceRandom {
+    std::mt19937 gen{std::random_device{}()};
+    std::uniform_real_distribution<> uniform{0.0, 1.0};
+    std::normal_distribution<> normal{0.0, 1.0};
+};
+
+inline SurfaceRandom& surfaceRandom() {
+    static thread_local SurfaceRandom rng;
+    return rng;
+}
+
+// Setzt den Generator des aufrufenden Threads auf eine feste Folge
+inline void seedSurfaceRandom(unsigned seed) {
+    SurfaceRandom& rng = surfaceRandom();
+    rng.gen.seed(seed);
+    rng.uniform.reset();
+    rng.normal.reset();
+}
+
+// Gleichverteilte Zufallszahl in [0, 1)
+inline double surfaceRand01() {
+    SurfaceRandom& rng = surfaceRandom();
+    return rng.uniform(rng.gen);
+}
+
+// Standardnormalverteilte Zufallszahl
+inline double surfaceNormal01() {
+    SurfaceRandom& rng = surfaceRandom();
+    return rng.normal(rng.gen);
+}
+
+// Kosinusgewichtete Richtung in der Hemisphäre um die (Einheits-)Normale
+inline Vector3 randomDiffuseDirection(const Vector3& normal) {
+    double u1 = surfaceRand01();
+    double u2 = surfaceRand01();
+
+    double r = std::sqrt(u1);
+    double theta = 2.0 * M_PI * u2;
+
+    double x = r * std::cos(theta);
+    double y = r * std::sin(theta);
+    double z = std::sqrt(std::max(0.0, 1.0 - u1));
+
+    // Local coordinate frame aligned to the normal
+    const Vector3& ez = normal;
+    Vector3 ex = (std::abs(ez.x) > 0.9 ? Vector3(0, 1, 0) : Vector3(1, 0, 0)).cross(ez).normalize();
+    Vector3 ey = ez.cross(ex);
+
+    return (ex * x + ey * y + ez * z).normalize();
+}
+
+// Ursprung des reflektierten Strahls: um wenige float-Rundungsschritte der Koordinatengröße
+// zur Gasseite versetzt. Das Startpanel schließt IntersectionEngine über Ray::panelId aus, der
+// Versatz schützt nur vor Nachbarpanels an gemeinsamen Kanten und bleibt weit unter jeder Panelgröße.
+inline Vector3 offsetRayOrigin(const Vector3& point, const Vector3& normal) {
+    constexpr double relativeOffset = 1e-6;   // ≈ 16 float-ULP
+    constexpr double minScale = 1e-9;         // Treffer am Koordinatenursprung
+    const double scale = std::max({std::abs(point.x), std::abs(point.y), std::abs(point.z), minScale});
+    return point + normal * (relativeOffset * scale);
+}
 
 class SurfaceInteractionModel {
 public:
     SurfaceInteractionModel(double reflection = 1.0, double absorption = 0.0);
 
+    // Laufzeit-Dispatch über cfg.model (für Tests und einzelne Aufrufe)
     Ray generateReflection(const SimulationConfig& cfg, const Ray& incidentRay, const HitInfo& hit) const;
 
-    void setMesh(const std::vector<Vector3>& verts, const std::vector<Triangle>& tris);
+    // Zur Compile-Zeit spezialisierter Reflexionskern (Hot Path)
+    template <SurfaceModelType Model>
+    Ray reflect(const SimulationConfig& cfg, const Ray& incidentRay, const HitInfo& hit) const;
+
+    // Baut Materialtabelle und modellabhängige Tabellen (CLL) einmal beim Setup
+    void prepare(const SimulationConfig& cfg,
+                 const std::vector<std::string>& meshMaterialNames = {});
+
+    const MaterialTable& getMaterials() const { return materials; }
+
+    void setMesh(std::shared_ptr<const TriangleTable> table);
 
     double getPanelArea(int panelId) const;
 
 private:
-    Ray generateDRIAReflection(const SimulationConfig& cfg, const Ray& incidentRay, const HitInfo& hit) const;
-    Ray generateSentmanReflection(const SimulationConfig& cfg, const Ray& incidentRay, const HitInfo& hit) const;
-
     double reflectionRatio;
     double absorptionRatio;
 
-    std::vector<Vector3> vertices;
-    std::vector<Triangle> triangles;
-    std::vector<double> triangleAreas; // Fläche je Panel
+    std::shared_ptr<const TriangleTable> triangleTable;   // Fläche je Panel
+
+    MaterialTable materials;
 };
+
+/**
+ * Reflection kernel for one surface model, resolved at compile time.
+ *
+ * Surface parameters come from the material of the hit panel (O(1) lookup by
+ * HitInfo::materialId); unknown IDs use the default material (entry 0). Without
+ * prepare() the material is rebuilt from the global configuration on every call,
+ * which is meant for single calls only; traceBounces() requires prepare().
+ *
+ * DRIA: diffuse re-emission with energy accommodation towards the wall temperature.
+ *       Energies follow the flux-weighted convention of the closed forms in
+ *       PanelMethodEngine: T_i = E_in/(2k), T_r = αT_w + (1−α)T_i, and the
+ *       re-emitted velocity is drawn from the half-range (flux) Maxwellian at
+ *       T_r, which carries 2kT_r per molecule on average.
+ * Sentman: like DRIA, but a fraction specularFraction is reflected specularly
+ *          with the mean energy 2kT_r.
+ * CLL: Cercignani–Lampis–Lord with normal (α_n) and tangential (α_t) energy accommodation;
+ *      the normal speed comes from the precomputed CLLTable. Each tangential component
+ *      is Gaussian with mean √(1−α_t)·u_t and variance α_t/2 (in units of c_w), so a
+ *      tangential momentum accommodation σ_t corresponds to α_t = σ_t(2 − σ_t).
+ * Classic: specular with probability reflectionRatio, otherwise diffuse;
+ *          the energy is reduced by energyLoss.
+ */
+template <SurfaceModelType Model>
+inline Ray SurfaceInteractionModel::reflect(const SimulationConfig& cfg,
+                                            const Ray& incidentRay,
+                                            const HitInfo& hit) const {
+    const Vector3& n = hit.normal;   // Einheitsnormale aus der Dreieckstabelle
+    const double m = incidentRay.speciesMass;
+    SurfaceMaterial fallback;
+    const SurfaceMaterial& mat = materials.contains(hit.materialId) ? materials[hit.materialId]
+        : !materials.empty() ? materials[0] : (fallback = SurfaceMaterial::fromConfig(cfg));
+
+    Vector3 reflectedDir;
+    double newEnergy;
+
+    if constexpr (Model == SurfaceModelType::CLL) {
+        const CLLTable& table = *mat.cllTable;   // beim Setup aufgelöst (SurfaceMaterial::fromConfig)
+        const double c_w = std::sqrt(2.0 * cfg.kB * table.getWallTemperature() / m);
+
+        // Zerlegung der Einfallsgeschwindigkeit (n zeigt zur Einfallsseite)
+        Vector3 v_in = incidentRay.velocity;
+        double vn = -v_in.dot(n);
+        Vector3 vt = v_in + n * vn;
+        double vtMag = vt.norm();
+        Vector3 t1 = vtMag > 0.0 ? vt * (1.0 / vtMag)
+                   : (std::abs(n.x) > 0.9 ? Vector3(0, 1, 0) : Vector3(1, 0, 0)).cross(n).normalize();
+        Vector3 t2 = n.cross(t1);
+
+        double aT = table.getTangentialAccommodation();
+        double sigmaT = std::sqrt(0.5 * aT);
+        double un = table.sampleNormalSpeed(std::max(vn, 0.0) / c_w, surfaceRand01());
+        double ut1 = std::sqrt(1.0 - aT) * vtMag / c_w + sigmaT * surfaceNormal01();
+        double ut2 = sigmaT * surfaceNormal01();
+
+        Vector3 v_out = (n * un + t1 * ut1 + t2 * ut2) * c_w;
+        reflectedDir = v_out.normalize();
+        newEnergy = 0.5 * m * v_out.squaredNorm();
+    } else if constexpr (Model == SurfaceModelType::Classic) {
+        Vector3 dir = incidentRay.direction;
+        if (surfaceRand01() < mat.reflectionRatio) {
+            reflectedDir = (dir - n * 2.0 * dir.dot(n)).normalize();  // Specular
+        } else {
+            reflectedDir = randomDiffuseDirection(n);                 // Diffuse
+        }
+        newEnergy = incidentRay.energy * (1.0 - mat.energyLoss);
+    } else {
+        // Flussgewichtet wie die geschlossene Form: einfallend E = 2kT_i, re-emittiert im Mittel 2kT_r
+        double T_w = mat.wallTemperature;
+        double T_i = 0.5 * incidentRay.energy / cfg.kB;
+        double alpha = mat.energyAccommodation;
+        double T_r = alpha * T_w + (1.0 - alpha) * T_i;
+
+        bool specular = false;
+        if constexpr (Model == SurfaceModelType::Sentman) specular = surfaceRand01() < mat.specularFraction;
+
+        if (specular) {
+            Vector3 v_in = incidentRay.direction.normalize();
+            reflectedDir = v_in - n * 2.0 * v_in.dot(n);
+            newEnergy = 2.0 * cfg.kB * T_r;
+        } else {
+            // Halbraum-Maxwell-Verteilung bei T_r: v_n = c_r √(−ln u), tangential je N(0, c_r²/2)
+            const double c_r = std::sqrt(2.0 * cfg.kB * T_r / m);
+            const Vector3 t1 = (std::abs(n.x) > 0.9 ? Vector3(0, 1, 0) : Vector3(1, 0, 0)).cross(n).normalize();
+            const Vector3 t2 = n.cross(t1);
+            const double vn = c_r * std::sqrt(-std::log(1.0 - surfaceRand01()));
+            const double sigmaT = c_r * std::sqrt(0.5);
+            Vector3 v_out = n * vn + t1 * (sigmaT * surfaceNormal01()) + t2 * (sigmaT * surfaceNormal01());
+            reflectedDir = v_out.normalize();
+            newEnergy = 0.5 * m * v_out.squaredNorm();
+        }
+    }
+
+    double v_mag = std::sqrt(2.0 * newEnergy / m);
+    Vector3 newVelocity = reflectedDir * v_mag;
+
+    Ray reflected;
+    reflected.origin = offsetRayOrigin(hit.point, n);
+    reflected.direction = reflectedDir;
+    reflected.velocity = newVelocity;
+    reflected.energy = newEnergy;
+    reflected.speciesMass = m;
+    reflected.speciesDensity = incidentRay.speciesDensity;
+    reflected.momentum = newVelocity * m;
+    reflected.active = true;
+    reflected.speciesId = incidentRay.speciesId;
+    reflected.weight = incidentRay.weight;
+    reflected.panelId = hit.panelId;
+
+    return reflected;
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include "AtmosphereTable.h"
+#include <array>
+#include <vector>
+
+// Ort, Zeit und Sonnen-/Geomagnetikindizes eines Auswertepunkts
+struct ThermosphereInput {
+    double altitude = 400.0;    // [km], gültig ab 120 km
+    double latitude = 0.0;      // [deg]
+    double longitude = 0.0;     // [deg], östlich positiv
+    double dayOfYear = 1.0;     // 1 … 366
+    double utSeconds = 0.0;     // Weltzeit [s]
+    double f107 = 150.0;        // F10.7 des Vortags [sfu]
+    double f107a = 150.0;       // 81-Tage-Mittel von F10.7 [sfu]
+    double ap = 4.0;            // Tages-Ap
+};
+
+// Viele Auswertepunkte spaltenweise: Eingaben füllen, evaluate() schreibt die Ergebnisspalten
+struct ThermosphereBatch {
+    std::vector<double> altitude, latitude, longitude, dayOfYear, utSeconds, f107, f107a, ap;
+
+    std::vector<double> temperature;             // [K]
+    std::vector<double> exosphericTemperature;   // [K]
+    std::vector<double> massDensity;             // [kg/m³]
+    std::array<std::vector<double>, AtmosphereTable::speciesCount> densities;   // [1/m³], AtmosphereTable::speciesNames
+
+    size_t size() const { return altitude.size(); }
+    void push_back(const ThermosphereInput& point);
+    // Zustand eines Punkts für AtmosphereState::applyTo() (ohne Staudruck)
+    AtmosphereState state(size_t i) const;
+};
+
+/**
+ * Empirical thermosphere model for drag runs without precomputed tables.
+ *
+ * Same structure as the upper thermosphere of MSIS and Jacchia: the
+ * exospheric temperature follows Jacchia (1970/71) from F10.7, its
+ * 81-day mean, Ap and the diurnal/latitudinal bulge. The temperature
+ * rises from the 120 km boundary along a Bates profile. Every species is
+ * in diffusive equilibrium above it, with US Standard Atmosphere 1976
+ * boundary densities; hydrogen starts from Jacchia's 500 km density.
+ * Jacchia's semiannual density variation applies on top. Species: N2, O2,
+ * O, HE, H, AR; N, AO and NO are zero.
+ *
+ * With T∞ = 1000 K the profile reproduces the US Standard Atmosphere 1976
+ * between 200 and 500 km to about 1 %. It is not NRLMSISE-00: no
+ * longitude/UT harmonics or Ap history, so expect the 15–30 % density
+ * error of Jacchia-class models.
+ */
+class ThermosphereModel {
+public:
+    AtmosphereState evaluate(const ThermosphereInput& point) const;
+    // Alle Punkte spaltenweise, OpenMP-parallel
+    void evaluate(ThermosphereBatch& batch) const;
+
+    // Einzelne Bausteine (auch für Tests)
+    static double exosphericTemperature(const ThermosphereInput& point);
+    static double semiannualFactor(double altitude, double dayOfYear, double utSeconds);
+    // Temperatur und Dichten bei T∞ ohne Jahresgang
+    static AtmosphereState diffusiveProfile(double altitude, double exosphericTemperature);
+};
@@ -0,0 +1,75 @@
+#pragma once
+#include "RunProfiler.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Ein Zeitabschnitt (Begin/Ende) auf einem Thread; Namen sind String-Literale
+struct TraceEvent {
+    const char* name = "";
+    const char* category = "";
+    int64_t beginNs = 0;
+    int64_t endNs = 0;
+    int64_t arg = -1;       // z. B. erster Strahlindex eines Batches
+};
+
+/**
+ * Timeline recorder for the Chrome trace / Perfetto JSON format.
+ *
+ * Every thread writes into its own fixed-size ring buffer, so recording
+ * needs neither locks nor atomics; when a buffer is full the oldest events
+ * are overwritten and counted as dropped. Disabled recorders ignore all
+ * calls. Timestamps are relative to a common epoch, taken right after an
+ * MPI barrier so the ranks line up on one timeline.
+ */
+class TraceRecorder {
+public:
+    // Gemeinsamer Zeitnullpunkt aller Ränge
+    void setEpoch(StageClock::time_point t) { epoch = t; }
+
+    void enable(int threads, size_t eventsPerThread = 1 << 16);
+    bool isEnabled() const { return enabled; }
+
+    void record(int tid, const char* name, const char* category,
+                StageClock::time_point begin, StageClock::time_point end, int64_t arg = -1);
+
+    // Ereignisse dieses Rangs als JSON-Array-Elemente (ohne Klammern)
+    std::string serialize(int rank) const;
+
+    // Fügt die serialisierten Ränge zu einer Chrome-Trace-Datei zusammen
+    static bool writeChromeTrace(const std::string& filename, const std::vector<std::string>& rankEvents);
+
+    uint64_t droppedEvents() const;
+
+private:
+    struct alignas(64) ThreadBuffer {
+        std::vector<TraceEvent> events;
+        uint64_t written = 0;
+    };
+
+    bool enabled = false;
+    StageClock::time_point epoch = StageClock::now();
+    std::vector<ThreadBuffer> buffers;
+};
+
+// Zeichnet den umschlossenen Block als ein Ereignis auf
+class TraceScope {
+public:
+    TraceScope(TraceRecorder& trace, int tid, const char* name, const char* category, int64_t arg = -1)
+        : trace(trace), tid(tid), name(name), category(category), arg(arg),
+          begin(trace.isEnabled() ? StageClock::now() : StageClock::time_point{}) {}
+    ~TraceScope() {
+        if (trace.isEnabled()) trace.record(tid, name, category, begin, StageClock::now(), arg);
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    TraceRecorder& trace;
+    int tid;
+    const char* name;
+    const char* category;
+    int64_t arg;
+    StageClock::time_point begin;
+};
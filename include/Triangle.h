@@ -4,8 +4,9 @@
 
 struct Triangle {
     int v1, v2, v3;
-    Vector3 normal;
     int panelId = 0; // optional: z.B. zur Gruppierung
+    int materialId = 0; // Index in die MaterialTable (0 = Standardmaterial)
+    int bodyId = 0; // starrer Teilkörper (OBJ o/g), 0 = Hauptkörper
 
     // Berechnet die Fläche des Dreiecks mit gegebenen Vertex-Koordinaten
     double area(const std::vector<Vector3>& vertices) const {
@@ -0,0 +1,71 @@
+#pragma once
+#include "Vector3.h"
+#include "Triangle.h"
+#include "RigidTransform.h"
+#include <memory>
+#include <vector>
+
+// Unveränderliche Attribute eines Dreiecks (nach der Windungskorrektur des MeshLoader)
+struct TriangleAttributes {
+    Vector3 p0, p1, p2;       // Eckpunkte (Kopie, damit der wasserdichte Test exakt gleiche Kanten sieht)
+    Vector3 edge1, edge2;     // p1 − p0, p2 − p0
+    Vector3 normal;           // nach außen zeigende Einheitsnormale
+    Vector3 centroid;
+    double area = 0.0;
+    int panelId = -1;
+    int materialId = 0;
+    int bodyId = 0;
+};
+
+/**
+ * Per-triangle attribute table shared by intersection, panel method and
+ * force code.
+ *
+ * Built once from the corrected mesh and never modified afterwards, so it is
+ * passed around as std::shared_ptr<const TriangleTable>. Rows follow the
+ * triangle order of the mesh; indexOf() maps panel IDs to rows.
+ */
+class TriangleTable {
+public:
+    TriangleTable() = default;
+    TriangleTable(const std::vector<Vector3>& vertices, const std::vector<Triangle>& triangles);
+
+    static std::shared_ptr<const TriangleTable> build(const std::vector<Vector3>& vertices,
+                                                      const std::vector<Triangle>& triangles);
+
+    // Kopie mit starr bewegten Teilkörpern (Transformation je bodyId; fehlende Einträge = geladene Lage),
+    // die Tabelle selbst, wenn sich nichts bewegt
+    static std::shared_ptr<const TriangleTable> posed(std::shared_ptr<const TriangleTable> table,
+                                                      const std::vector<RigidTransform>& bodyTransforms);
+
+    size_t size() const { return rows.size(); }
+    bool empty() const { return rows.empty(); }
+    const TriangleAttributes& operator[](size_t i) const { return rows[i]; }
+    std::vector<TriangleAttributes>::const_iterator begin() const { return rows.begin(); }
+    std::vector<TriangleAttributes>::const_iterator end() const { return rows.end(); }
+
+    // Zeile eines Panels, −1 wenn unbekannt
+    int indexOf(int panelId) const {
+        if (panelId < 0 || static_cast<size_t>(panelId) >= panelIndex.size()) return -1;
+        return panelIndex[panelId];
+    }
+
+    // Größte Panel-ID + 1
+    size_t panelIdCount() const { return panelIndex.size(); }
+
+    double getTotalArea() const { return totalArea; }
+    const Vector3& getBoundsMin() const { return boundsMin; }
+    const Vector3& getBoundsMax() const { return boundsMax; }
+
+    // Panelflächen nach Panel-ID (0 für Lücken), z. B. für DragForceCalculator
+    std::vector<double> areasByPanel() const;
+
+private:
+    std::vector<TriangleAttributes> rows;
+    std::vector<int> panelIndex;    // panelId → Zeile
+    double totalArea = 0.0;
+    Vector3 boundsMin, boundsMax;   // über alle Eckpunkte
+
+    // Gesamtfläche, Bounding Box und Panelindex aus den Zeilen
+    void computeSummary();
+};
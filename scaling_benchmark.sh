@@ -0,0 +1,156 @@
+#!/bin/bash
+# Strong/weak scaling of the full pipeline (TestMain) on a single machine.
+#
+# Every configuration runs with a fixed seed and writes its runReport JSON;
+# the harness collects rays/s, parallel efficiency and the memory
+# high-water mark into <out>/scaling_results.csv.
+#
+# Usage: ./scaling_benchmark.sh [strong|weak|both]
+# Settings via environment, e.g.:
+#   MODELS="Opt_Sat SOAR" THREADS="1 2 4 8" RANKS="1 2 4" ./scaling_benchmark.sh strong
+
+set -e
+set -o pipefail
+
+MODE=${1:-both}
+REPO=$(cd "$(dirname "$0")" && pwd)
+BUILD_DIR=${BUILD_DIR:-$REPO/build}
+EXE=${EXE:-$BUILD_DIR/TestMain}
+ASSETS=${ASSETS:-$REPO/assets}
+OUT=${OUT:-$REPO/scaling_$(date +%Y%m%d_%H%M%S)}
+
+MODELS=${MODELS:-"Cube Opt_Sat SOAR Triple_Cube"}
+RAYS=${RAYS:-"100000 400000"}          # strong: feste Gesamtzahl
+RAYS_PER_WORKER=${RAYS_PER_WORKER:-50000}  # weak: Strahlen pro Rang×Thread
+THREADS=${THREADS:-"1 2 4 8"}
+RANKS=${RANKS:-"1 2 4"}
+SOLVER=${SOLVER:-raytrace}             # raytrace: alle Panels per Monte Carlo
+SEED=${SEED:-12345}
+ALT=${ALT:-300}
+AOA=${AOA:-0}
+INDEX=${INDEX:-0}
+MPIRUN=${MPIRUN:-mpirun}
+MPI_FLAGS=${MPI_FLAGS:---bind-to none}
+OVERSUBSCRIBE=${OVERSUBSCRIBE:-0}
+CORES=$(nproc)
+
+if [[ ! -x "$EXE" ]]; then
+    echo "❌ TestMain not found: $EXE (run ./install.sh or set EXE)"
+    exit 1
+fi
+if [[ ! -d "$ASSETS/atmos_data" ]]; then
+    echo "❌ Atmospheric data not found: $ASSETS/atmos_data (set ASSETS)"
+    exit 1
+fi
+
+mkdir -p "$OUT/runs"
+RESULTS="$OUT/scaling_results.csv"
+echo "model,mode,ranks,threads,workers,rays,wall_s,loop_s,rays_per_s,efficiency,max_rss_mb_rank,max_rss_mb_total,rank_imbalance,thread_imbalance,cd" > "$RESULTS"
+
+echo "📁 Output: $OUT"
+echo "🖥️  Cores: $CORES, ranks: $RANKS, threads: $THREADS, seed: $SEED"
+
+# Einzelnen Lauf ausführen; gibt das Arbeitsverzeichnis des Laufs aus
+run_case() {
+    local model=$1 ranks=$2 threads=$3 rays=$4 tag=$5
+    local dir="$OUT/runs/$tag"
+    mkdir -p "$dir/work"
+    ln -sfn "$ASSETS" "$dir/assets"
+    ln -sfn "$REPO/models" "$dir/work/models"
+
+    cp "$REPO/config.ini" "$dir/work/config.ini"
+    cat >> "$dir/work/config.ini" <<EOF
+
+[general]
+geometryFile = models/$model.obj
+rayCount = $rays
+solver = $SOLVER
+seed = $SEED
+EOF
+
+    local start end
+    start=$(date +%s.%N)
+    (cd "$dir/work" && OMP_NUM_THREADS=$threads OMP_PROC_BIND=false \
+        $MPIRUN $MPI_FLAGS -np "$ranks" "$EXE" "$ALT" "$AOA" "$INDEX" > run.log 2>&1) || true
+    end=$(date +%s.%N)
+
+    awk -v a="$start" -v b="$end" 'BEGIN { printf "%.3f\n", b - a }' > "$dir/work/wall_s"
+    echo "$dir/work"
+}
+
+# Kennzahlen aus dem Laufbericht; Effizienz relativ zu 1 Rang × 1 Thread (leer ohne diesen Lauf)
+append_result() {
+    local model=$1 mode=$2 ranks=$3 threads=$4 rays=$5 report=$6 wall=$7 base_rps=$8
+    python3 - "$report" "$wall" "$model" "$mode" "$ranks" "$threads" "$rays" "$base_rps" >> "$RESULTS" <<'PY'
+import json, sys
+report, wall, model, mode, ranks, threads, rays, base = sys.argv[1:]
+ranks, threads, rays, wall = int(ranks), int(threads), int(rays), float(wall)
+rep = json.load(open(report))
+rps = rep["counters"]["rays_per_s"] or 0.0
+workers = ranks * threads
+base = float(base) if base else 0.0
+eff = f"{rps / (workers * base):.3f}" if base > 0 else ""
+loop = max(r["loop_s"] for r in rep["imbalance"]["ranks"])
+thread_imb = max(r["thread_max_over_mean"] for r in rep["imbalance"]["ranks"])
+print(f'{model},{mode},{ranks},{threads},{workers},{rays},{wall:.3f},{loop:.4f},{rps:.1f},{eff},'
+      f'{rep["memory"]["max_rss_mb_rank_max"]:.1f},{rep["memory"]["max_rss_mb_total"]:.1f},'
+      f'{rep["imbalance"]["rank_max_over_mean"]:.3f},{thread_imb:.3f},{rep["results"].get("cd", "")}')
+PY
+}
+
+rays_per_s() {
+    python3 -c "import json,sys; print(json.load(open(sys.argv[1]))['counters']['rays_per_s'])" "$1"
+}
+
+sweep() {
+    local mode=$1 model=$2 strong_rays=$3
+    local base_rps=""
+
+    # 1 Rang × 1 Thread zuerst, falls in RANKS und THREADS enthalten: Referenz der Effizienz
+    local configs=() ranks threads
+    for ranks in $RANKS; do
+        for threads in $THREADS; do
+            if (( ranks == 1 && threads == 1 )); then configs=("1 1" "${configs[@]}")
+            else configs+=("$ranks $threads"); fi
+        done
+    done
+    [[ " ${configs[0]} " == " 1 1 " ]] || echo "⚠️  No 1×1 configuration in RANKS/THREADS, efficiency left empty"
+
+    for config in "${configs[@]}"; do
+        read -r ranks threads <<< "$config"
+        local workers=$((ranks * threads))
+        if (( workers > CORES )) && [[ "$OVERSUBSCRIBE" != "1" ]]; then
+            echo "⚠️  Skipping $ranks×$threads ($workers > $CORES cores, OVERSUBSCRIBE=1 to force)"
+            continue
+        fi
+
+        local rays=$strong_rays
+        [[ "$mode" == "weak" ]] && rays=$((RAYS_PER_WORKER * workers))
+        local tag="${model}_${mode}_r${rays}_np${ranks}_t${threads}"
+
+        echo "🚀 $model $mode: $ranks rank(s) × $threads thread(s), $rays rays"
+        local work
+        work=$(run_case "$model" "$ranks" "$threads" "$rays" "$tag")
+        local report="$work/runReport_${ALT}km_idx${INDEX}.json"
+        if [[ ! -f "$report" ]]; then
+            echo "❌ Run failed, see $work/run.log"
+            (( ranks == 1 && threads == 1 )) && echo "⚠️  1×1 reference failed, efficiency left empty"
+            continue
+        fi
+
+        (( ranks == 1 && threads == 1 )) && base_rps=$(rays_per_s "$report")
+        append_result "$model" "$mode" "$ranks" "$threads" "$rays" "$report" "$(cat "$work/wall_s")" "$base_rps"
+        tail -n 1 "$RESULTS"
+    done
+}
+
+for model in $MODELS; do
+    if [[ "$MODE" == "strong" || "$MODE" == "both" ]]; then
+        for rays in $RAYS; do sweep strong "$model" "$rays"; done
+    fi
+    if [[ "$MODE" == "weak" || "$MODE" == "both" ]]; then
+        sweep weak "$model" 0
+    fi
+done
+
+echo "✅ Scaling results written: $RESULTS"
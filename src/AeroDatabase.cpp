@@ -0,0 +1,300 @@
+#include "AeroDatabase.h"
+#include "DragSolver.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <type_traits>
+
+namespace {
+    constexpr char fileMagic[8] = {'V', 'L', 'E', 'O', 'A', 'D', 'B', '1'};
+
+    // Little-endian unabhängig vom Host: Bytes einzeln aus dem Bitmuster schieben
+    template <typename T>
+    void encodeLE(const T& v, unsigned char* bytes) {
+        static_assert(sizeof(T) == 4 || sizeof(T) == 8);
+        using U = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+        U bits;
+        std::memcpy(&bits, &v, sizeof(T));
+        for (size_t b = 0; b < sizeof(T); ++b) bytes[b] = static_cast<unsigned char>(bits >> (8 * b));
+    }
+
+    template <typename T>
+    T decodeLE(const unsigned char* bytes) {
+        using U = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+        U bits = 0;
+        for (size_t b = 0; b < sizeof(T); ++b) bits |= static_cast<U>(bytes[b]) << (8 * b);
+        T v;
+        std::memcpy(&v, &bits, sizeof(T));
+        return v;
+    }
+
+    template <typename T>
+    void writeRaw(std::ofstream& out, const T& v) {
+        unsigned char bytes[sizeof(T)];
+        encodeLE(v, bytes);
+        out.write(reinterpret_cast<const char*>(bytes), sizeof(T));
+    }
+
+    template <typename T>
+    bool readRaw(std::ifstream& in, T& v) {
+        unsigned char bytes[sizeof(T)];
+        if (!in.read(reinterpret_cast<char*>(bytes), sizeof(T))) return false;
+        v = decodeLE<T>(bytes);
+        return true;
+    }
+}
+
+AeroAxis AeroAxis::fromRange(const GridRange& range) {
+    AeroAxis axis;
+    axis.start = range.start;
+    axis.count = std::max(range.count, 1);
+    axis.step = axis.count > 1 ? (range.end - range.start) / (axis.count - 1) : 0.0;
+    return axis;
+}
+
+// Mehrere Punkte brauchen eine endliche Schrittweite ≠ 0 (sonst Division durch null in lookup)
+bool AeroAxis::valid() const {
+    return count >= 1 && std::isfinite(start) && (count == 1 || (std::isfinite(step) && step != 0.0));
+}
+
+Vector3 AeroDatabase::flowDirection(double aoaDeg, double sideslipDeg) {
+    const double a = aoaDeg * M_PI / 180.0;
+    const double b = sideslipDeg * M_PI / 180.0;
+    return {std::sin(a) * std::cos(b), std::cos(a) * std::cos(b), std::sin(b)};
+}
+
+void AeroDatabase::updateStrides() {
+    size_t s = 1;
+    for (int a = axisCount - 1; a >= 0; --a) {
+        strides[a] = s;
+        s *= static_cast<size_t>(axes[a].count);
+    }
+}
+
+size_t AeroDatabase::getNodeCount() const {
+    size_t n = 1;
+    for (const auto& a : axes) n *= static_cast<size_t>(a.count);
+    return n;
+}
+
+bool AeroDatabase::setTable(const std::array<AeroAxis, axisCount>& newAxes, std::vector<float> newValues) {
+    for (const auto& a : newAxes)
+        if (!a.valid()) {
+            std::cerr << "❌ AeroDatabase: axis with " << a.count << " points needs a finite, non-zero step\n";
+            return false;
+        }
+    axes = newAxes;
+    updateStrides();
+    values = std::move(newValues);
+    values.resize(getNodeCount() * valuesPerNode, 0.0f);
+    return true;
+}
+
+/**
+ * @brief Evaluates the coefficient table on the configured grid.
+ *
+ * The wall temperature stays at cfg.WallTemp; each node sets the gas
+ * temperature T = T_w / (T_w/T) and the speed V = s·√(2kT/m̄) with the mean
+ * molecular mass m̄ of the configured species mix. Absolute densities cancel
+ * in the coefficients.
+ *
+ * @param solver Solver with the mesh loaded (reference point and area are taken from it).
+ * @param cfg Grid ranges, species, wall temperature and referenceLength.
+ * @return false if the solver has no mesh, no species has a density, an axis has
+ *         several points but start == end, or a node failed.
+ */
+bool AeroDatabase::generate(const DragSolver& solver, const SimulationConfig& cfg) {
+    const std::array<AeroAxis, axisCount> grid = {
+        AeroAxis::fromRange(cfg.databaseAoA), AeroAxis::fromRange(cfg.databaseSideslip),
+        AeroAxis::fromRange(cfg.databaseSpeedRatio), AeroAxis::fromRange(cfg.databaseTemperatureRatio)};
+    const char* names[axisCount] = {"databaseAoA", "databaseSideslip", "databaseSpeedRatio", "databaseTemperatureRatio"};
+    for (int a = 0; a < axisCount; ++a)
+        if (!grid[a].valid()) {
+            std::cerr << "❌ AeroDatabase: " << names[a] << " has " << grid[a].count
+                      << " points but no finite, non-zero step (start == end?)\n";
+            return false;
+        }
+    axes = grid;
+    updateStrides();
+    referenceArea = solver.getReferenceArea();
+    referenceLength = cfg.referenceLength;
+    referencePoint = solver.getReferencePoint();
+
+    double nSum = 0.0, mSum = 0.0;
+    std::map<std::string, double> densities;
+    for (const auto& [name, sp] : cfg.species) {
+        if (sp.density <= 0.0 || sp.mass <= 0.0) continue;
+        densities[name] = sp.density;
+        nSum += sp.density;
+        mSum += sp.density * sp.mass;
+    }
+    if (!solver.isReady() || nSum <= 0.0) {
+        std::cerr << "❌ AeroDatabase: need a loaded mesh and at least one species with density\n";
+        return false;
+    }
+    const double meanMass = mSum / nSum;
+
+    // Alle Knoten in Tabellenreihenfolge als Anströmzustände
+    const size_t nodes = getNodeCount();
+    std::vector<FlowState> states;
+    states.reserve(nodes);
+    for (int i0 = 0; i0 < axes[0].count; ++i0)
+        for (int i1 = 0; i1 < axes[1].count; ++i1)
+            for (int i2 = 0; i2 < axes[2].count; ++i2)
+                for (int i3 = 0; i3 < axes[3].count; ++i3) {
+                    FlowState s;
+                    s.direction = flowDirection(axes[0].value(i0), axes[1].value(i1));
+                    s.temperature = cfg.WallTemp / axes[3].value(i3);
+                    s.velocity = axes[2].value(i2) * std::sqrt(2.0 * cfg.kB * s.temperature / meanMass);
+                    s.densities = densities;
+                    states.push_back(std::move(s));
+                }
+
+    std::cout << "🚀 Aero database: " << nodes << " nodes (" << axes[0].count << " AoA × "
+              << axes[1].count << " sideslip × " << axes[2].count << " speed ratio × "
+              << axes[3].count << " T_w/T)\n";
+    std::vector<DragResult> results = solver.computeBatch(states);
+
+    values.assign(nodes * valuesPerNode, 0.0f);
+    for (size_t n = 0; n < nodes; ++n) {
+        const DragResult& r = results[n];
+        const double qA = r.dynamicPressure * referenceArea;
+        const double qAL = qA * referenceLength;
+        if (!r.valid || qA <= 0.0 || qAL <= 0.0) return false;
+
+        float* v = &values[n * valuesPerNode];
+        for (int k = 0; k < 3; ++k) {
+            v[k] = static_cast<float>(r.force[k] / qA);
+            v[3 + k] = static_cast<float>(r.torque[k] / qAL);
+            v[6 + k] = static_cast<float>(r.forceError[k] / qA);
+            v[9 + k] = static_cast<float>(r.torqueError[k] / qAL);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Writes the table: magic, axes, reference values, node count, float32 values.
+ *
+ * All numbers are stored little-endian regardless of the host byte order.
+ */
+bool AeroDatabase::save(const std::string& filename) const {
+    std::ofstream out(filename, std::ios::binary);
+    if (!out) {
+        std::cerr << "❌ Could not write aero database: " << filename << "\n";
+        return false;
+    }
+
+    out.write(fileMagic, sizeof(fileMagic));
+    writeRaw(out, static_cast<uint32_t>(axisCount));
+    for (const auto& a : axes) {
+        writeRaw(out, a.start);
+        writeRaw(out, a.step);
+        writeRaw(out, static_cast<int32_t>(a.count));
+    }
+    writeRaw(out, referenceArea);
+    writeRaw(out, referenceLength);
+    writeRaw(out, referencePoint.x);
+    writeRaw(out, referencePoint.y);
+    writeRaw(out, referencePoint.z);
+    writeRaw(out, static_cast<uint64_t>(getNodeCount()));
+    std::vector<unsigned char> block(values.size() * sizeof(float));
+    for (size_t i = 0; i < values.size(); ++i) encodeLE(values[i], &block[i * sizeof(float)]);
+    out.write(reinterpret_cast<const char*>(block.data()), static_cast<std::streamsize>(block.size()));
+
+    if (!out) return false;
+    std::cout << "✅ Aero database written: " << filename << " (" << getNodeCount() << " nodes)\n";
+    return true;
+}
+
+bool AeroDatabase::load(const std::string& filename) {
+    std::ifstream in(filename, std::ios::binary);
+    char magic[sizeof(fileMagic)];
+    uint32_t storedAxes = 0;
+    if (!in || !in.read(magic, sizeof(magic)) || std::memcmp(magic, fileMagic, sizeof(magic)) != 0 ||
+        !readRaw(in, storedAxes) || storedAxes != axisCount) {
+        std::cerr << "❌ Not an aero database: " << filename << "\n";
+        return false;
+    }
+
+    for (auto& a : axes) {
+        int32_t count = 0;
+        if (!readRaw(in, a.start) || !readRaw(in, a.step) || !readRaw(in, count) || count < 1) return false;
+        a.count = count;
+        if (!a.valid()) {
+            std::cerr << "❌ Aero database axis without a finite, non-zero step: " << filename << "\n";
+            return false;
+        }
+    }
+    updateStrides();
+    uint64_t nodes = 0;
+    if (!readRaw(in, referenceArea) || !readRaw(in, referenceLength) || !readRaw(in, referencePoint.x) ||
+        !readRaw(in, referencePoint.y) || !readRaw(in, referencePoint.z) || !readRaw(in, nodes) ||
+        nodes != getNodeCount()) {
+        std::cerr << "❌ Corrupt aero database header: " << filename << "\n";
+        return false;
+    }
+
+    std::vector<unsigned char> block(nodes * valuesPerNode * sizeof(float));
+    if (!in.read(reinterpret_cast<char*>(block.data()), static_cast<std::streamsize>(block.size()))) {
+        std::cerr << "❌ Truncated aero database: " << filename << "\n";
+        return false;
+    }
+    values.resize(nodes * valuesPerNode);
+    for (size_t i = 0; i < values.size(); ++i) values[i] = decodeLE<float>(&block[i * sizeof(float)]);
+    return true;
+}
+
+/**
+ * @brief Multilinear interpolation of all coefficients at one query point.
+ *
+ * Each axis contributes a lower index and a fraction; the 16 surrounding
+ * nodes are blended with float weights (a singleton axis reuses its only
+ * node with weight 0 for the upper neighbour). Queries outside the grid are
+ * clamped to the boundary; a NaN query coordinate falls to the first node.
+ */
+AeroCoefficients AeroDatabase::lookup(double aoaDeg, double sideslipDeg, double speedRatio,
+                                      double temperatureRatio) const {
+    const double query[axisCount] = {aoaDeg, sideslipDeg, speedRatio, temperatureRatio};
+    size_t base = 0;
+    float weight[axisCount][2];
+    size_t offset[axisCount][2];
+
+    for (int a = 0; a < axisCount; ++a) {
+        const AeroAxis& ax = axes[a];
+        double t = ax.count > 1 && ax.step != 0.0 ? (query[a] - ax.start) / ax.step : 0.0;
+        t = t > 0.0 ? std::min(t, static_cast<double>(ax.count - 1)) : 0.0;   // auch NaN → 0 vor dem int-Cast
+        int i = std::min(static_cast<int>(t), std::max(ax.count - 2, 0));
+        const float f = static_cast<float>(t - i);
+        weight[a][0] = 1.0f - f;
+        weight[a][1] = f;
+        offset[a][0] = 0;
+        offset[a][1] = ax.count > 1 ? strides[a] * valuesPerNode : 0;
+        base += static_cast<size_t>(i) * strides[a];
+    }
+
+    // 2⁴ Nachbarknoten; Gewichte werden pro Achse aufmultipliziert
+    const float* node = values.data() + base * valuesPerNode;
+    float acc[valuesPerNode] = {};
+    for (int i0 = 0; i0 < 2; ++i0)
+        for (int i1 = 0; i1 < 2; ++i1) {
+            const float w01 = weight[0][i0] * weight[1][i1];
+            if (w01 == 0.0f) continue;
+            for (int i2 = 0; i2 < 2; ++i2)
+                for (int i3 = 0; i3 < 2; ++i3) {
+                    const float w = w01 * weight[2][i2] * weight[3][i3];
+                    const float* v = node + offset[0][i0] + offset[1][i1] + offset[2][i2] + offset[3][i3];
+                    for (int k = 0; k < valuesPerNode; ++k) acc[k] += w * v[k];
+                }
+        }
+
+    AeroCoefficients c;
+    c.force = {acc[0], acc[1], acc[2]};
+    c.moment = {acc[3], acc[4], acc[5]};
+    c.forceError = {acc[6], acc[7], acc[8]};
+    c.momentError = {acc[9], acc[10], acc[11]};
+    return c;
+}
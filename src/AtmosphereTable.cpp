@@ -0,0 +1,338 @@
+#include "AtmosphereTable.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+namespace {
+    constexpr char fileMagic[8] = {'V', 'L', 'E', 'O', 'A', 'T', 'M', '2'};
+    const std::string filePrefix = "database_", fileSuffix = "km.csv";
+
+    template <typename T>
+    void writeRaw(std::ofstream& out, const T& v) { out.write(reinterpret_cast<const char*>(&v), sizeof(T)); }
+
+    template <typename T>
+    bool readRaw(std::ifstream& in, T& v) { return static_cast<bool>(in.read(reinterpret_cast<char*>(&v), sizeof(T))); }
+
+    // Höhe aus database_<alt>km.csv; leer bei anderen Dateien
+    std::string altitudeOf(const fs::path& path) {
+        const std::string name = path.filename().string();
+        if (name.size() <= filePrefix.size() + fileSuffix.size() || name.rfind(filePrefix, 0) != 0 ||
+            name.compare(name.size() - fileSuffix.size(), fileSuffix.size(), fileSuffix) != 0)
+            return "";
+        return name.substr(filePrefix.size(), name.size() - filePrefix.size() - fileSuffix.size());
+    }
+
+    // Verzeichnis in kanonischer Form, damit verschiedene Schreibweisen als gleich gelten
+    std::string canonicalDirectory(const std::string& directory) {
+        std::error_code ec;
+        const fs::path path = fs::weakly_canonical(fs::absolute(directory, ec), ec);
+        return ec ? directory : path.string();
+    }
+
+    // Größe und Änderungszeit einer CSV, wie sie im Cache stehen
+    bool statFile(const fs::path& path, uint64_t& size, int64_t& mtime) {
+        std::error_code ec;
+        size = fs::file_size(path, ec);
+        if (ec) return false;
+        mtime = static_cast<int64_t>(fs::last_write_time(path, ec).time_since_epoch().count());
+        return !ec;
+    }
+
+    // Höhe → CSV-Pfad aller Tabellen eines Verzeichnisses
+    std::map<std::string, fs::path> listCsvFiles(const std::string& directory) {
+        std::map<std::string, fs::path> files;
+        std::error_code ec;
+        for (const auto& entry : fs::directory_iterator(directory, ec)) {
+            const std::string alt = altitudeOf(entry.path());
+            if (!alt.empty() && entry.is_regular_file()) files[alt] = entry.path();
+        }
+        return files;
+    }
+}
+
+const std::array<std::string, AtmosphereTable::speciesCount> AtmosphereTable::speciesNames = {
+    "N2", "O2", "O", "HE", "H", "AR", "N", "AO", "NO"};
+
+/**
+ * @brief Copies the state into a configuration.
+ *
+ * Only species that already have a [species:<name>] section get their
+ * density, since the masses come from there; the others are left out as
+ * before when TestMain rewrote config.ini.
+ */
+void AtmosphereState::applyTo(SimulationConfig& cfg) const {
+    cfg.temperature = temperature;
+    cfg.mass_density = massDensity;
+    for (int s = 0; s < AtmosphereTable::speciesCount; ++s) {
+        auto it = cfg.species.find(AtmosphereTable::speciesNames[s]);
+        if (it != cfg.species.end()) it->second.density = densities[s];
+    }
+}
+
+/**
+ * @brief Loads all altitudes of a directory, through the binary cache when it is current.
+ *
+ * The cache is current when it was built from the same canonical directory
+ * and holds exactly its altitudes, each with the size and mtime the CSV has
+ * now. Otherwise every CSV is parsed and the cache is rewritten. Without
+ * any CSV in the directory the cache alone is used, with a warning naming
+ * the directory it was built from.
+ *
+ * @param directory Directory with database_<alt>km.csv files.
+ * @param cacheFile Binary cache; empty disables it.
+ * @return false if no table could be read.
+ */
+bool AtmosphereTable::load(const std::string& directory, const std::string& cacheFile) {
+    const auto files = listCsvFiles(directory);
+    const std::string canonical = canonicalDirectory(directory);
+    std::error_code ec;
+    if (!cacheFile.empty() && fs::exists(cacheFile, ec) && loadCache(cacheFile)) {
+        if (files.empty()) {
+            std::cerr << "⚠️  No atmosphere tables in " << directory << "; using cache " << cacheFile
+                      << " built from " << sourceDirectory << "\n";
+            return true;
+        }
+
+        bool current = sourceDirectory == canonical && sources.size() == files.size();
+        for (const auto& [alt, path] : files) {
+            auto it = sources.find(alt);
+            uint64_t size = 0;
+            int64_t mtime = 0;
+            current = current && it != sources.end() && statFile(path, size, mtime) &&
+                      it->second.size == size && it->second.mtime == mtime;
+        }
+        if (current) return true;
+    }
+
+    if (!loadCsvDirectory(directory)) return false;
+    if (!cacheFile.empty()) saveCache(cacheFile);
+    return true;
+}
+
+/**
+ * @brief Parses every database_<alt>km.csv of a directory (replaces the table).
+ */
+bool AtmosphereTable::loadCsvDirectory(const std::string& directory) {
+    blocks.clear();
+    sources.clear();
+    values.clear();
+    sourceDirectory = canonicalDirectory(directory);
+    const auto files = listCsvFiles(directory);
+    if (files.empty()) {
+        std::cerr << "❌ No atmosphere tables (database_<alt>km.csv) in " << directory << "\n";
+        return false;
+    }
+    for (const auto& [alt, path] : files) {
+        // Vor dem Lesen erfassen: eine während des Lesens geänderte CSV gilt beim nächsten Start als neuer
+        Source& src = sources[alt];
+        if (!statFile(path, src.size, src.mtime) || !readCsv(alt, path.string())) return false;
+    }
+
+    size_t rows = 0;
+    for (const auto& [_, b] : blocks) rows += b.rows;
+    std::cout << "✔️  Atmosphere: " << blocks.size() << " altitude table(s), " << rows << " rows parsed.\n";
+    return true;
+}
+
+/**
+ * @brief Parses one CSV into the block of an altitude.
+ *
+ * The header line is skipped; empty lines are ignored. Every other line
+ * needs at least the 11 leading columns plus the dynamic pressure.
+ *
+ * @param altitude Key used by getState() (the <alt> of the file name).
+ * @param filename CSV file.
+ */
+bool AtmosphereTable::readCsv(const std::string& altitude, const std::string& filename) {
+    std::ifstream in(filename, std::ios::binary);
+    if (!in) {
+        std::cerr << "❌ Could not open atmosphere table: " << filename << "\n";
+        return false;
+    }
+    std::ostringstream buffer;
+    buffer << in.rdbuf();
+    const std::string text = buffer.str();
+
+    std::vector<std::array<double, columnCount>> rows;
+    std::vector<std::pair<const char*, const char*>> cells;
+    const char* p = text.data();
+    const char* end = p + text.size();
+    bool header = true;
+    size_t lineNumber = 0;
+    while (p < end) {
+        const char* eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+        if (!eol) eol = end;
+        const char* lineEnd = (eol > p && eol[-1] == '\r') ? eol - 1 : eol;
+        ++lineNumber;
+
+        if (header) {
+            header = false;
+        } else if (lineEnd > p) {
+            cells.clear();
+            for (const char* c = p;;) {
+                const char* comma = std::find(c, lineEnd, ',');
+                cells.emplace_back(c, comma);
+                if (comma == lineEnd) break;
+                c = comma + 1;
+            }
+            if (cells.size() < static_cast<size_t>(columnCount)) {
+                std::cerr << "❌ " << filename << ":" << lineNumber << ": expected at least " << columnCount
+                          << " columns, got " << cells.size() << "\n";
+                return false;
+            }
+
+            // Nur ρ, Spezies, T und q werden gelesen; Spalten dazwischen dürfen beliebig sein
+            std::array<double, columnCount> row;
+            for (int k = 0; k < columnCount; ++k) {
+                auto [s, e] = cells[k < columnCount - 1 ? k : cells.size() - 1];
+                while (s < e && (*s == ' ' || *s == '\t')) ++s;
+                if (s < e && *s == '+') ++s;
+                if (std::from_chars(s, e, row[k]).ec != std::errc()) {
+                    std::cerr << "❌ " << filename << ":" << lineNumber << ": column " << k + 1
+                              << " is not a number\n";
+                    return false;
+                }
+            }
+            rows.push_back(row);
+        }
+        p = eol + 1;
+    }
+
+    addBlock(altitude, rows);
+    return true;
+}
+
+void AtmosphereTable::addBlock(const std::string& altitude, const std::vector<std::array<double, columnCount>>& rows) {
+    Block block;
+    block.offset = values.size();
+    block.rows = rows.size();
+    values.resize(values.size() + rows.size() * columnCount);
+    for (int c = 0; c < columnCount; ++c)
+        for (size_t r = 0; r < rows.size(); ++r)
+            values[block.offset + c * block.rows + r] = rows[r][c];
+    blocks[altitude] = block;
+}
+
+/**
+ * @brief Writes magic, column count, source directory, altitude count, then
+ *        per altitude its name, row count and CSV size and mtime, followed by
+ *        all values as float64 in host byte order.
+ *
+ * The file is written under a temporary name and renamed into place, so a
+ * crash or a concurrent reader never sees a half-written cache.
+ */
+bool AtmosphereTable::saveCache(const std::string& filename) const {
+    const std::string temporary = filename + ".tmp" + std::to_string(getpid());
+    {
+        std::ofstream out(temporary, std::ios::binary);
+        if (!out) {
+            std::cerr << "⚠️  Could not write atmosphere cache: " << filename << "\n";
+            return false;
+        }
+        out.write(fileMagic, sizeof(fileMagic));
+        writeRaw(out, static_cast<uint32_t>(columnCount));
+        writeRaw(out, static_cast<uint32_t>(sourceDirectory.size()));
+        out.write(sourceDirectory.data(), static_cast<std::streamsize>(sourceDirectory.size()));
+        writeRaw(out, static_cast<uint32_t>(blocks.size()));
+        for (const auto& [alt, b] : blocks) {
+            const auto src = sources.find(alt);
+            writeRaw(out, static_cast<uint32_t>(alt.size()));
+            out.write(alt.data(), static_cast<std::streamsize>(alt.size()));
+            writeRaw(out, static_cast<uint64_t>(b.rows));
+            writeRaw(out, src != sources.end() ? src->second.size : uint64_t{0});
+            writeRaw(out, src != sources.end() ? src->second.mtime : int64_t{0});
+        }
+        // Blöcke in Map-Reihenfolge, so dass die Offsets beim Laden fortlaufend sind
+        for (const auto& [_, b] : blocks)
+            out.write(reinterpret_cast<const char*>(values.data() + b.offset),
+                      static_cast<std::streamsize>(b.rows * columnCount * sizeof(double)));
+        if (!out.flush()) {
+            std::cerr << "⚠️  Could not write atmosphere cache: " << filename << "\n";
+            out.close();
+            std::remove(temporary.c_str());
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    fs::rename(temporary, filename, ec);
+    if (ec) {
+        std::cerr << "⚠️  Could not replace atmosphere cache " << filename << ": " << ec.message() << "\n";
+        fs::remove(temporary, ec);
+        return false;
+    }
+    return true;
+}
+
+bool AtmosphereTable::loadCache(const std::string& filename) {
+    blocks.clear();
+    sources.clear();
+    values.clear();
+    sourceDirectory.clear();
+    std::ifstream in(filename, std::ios::binary);
+    char magic[sizeof(fileMagic)];
+    uint32_t columns = 0, dirLength = 0, altitudes = 0;
+    if (!in || !in.read(magic, sizeof(magic)) || std::memcmp(magic, fileMagic, sizeof(magic)) != 0 ||
+        !readRaw(in, columns) || columns != columnCount || !readRaw(in, dirLength) || dirLength > 4096) {
+        std::cerr << "⚠️  Not an atmosphere cache (or an older format): " << filename << "\n";
+        return false;
+    }
+    sourceDirectory.resize(dirLength);
+    if (!in.read(sourceDirectory.data(), dirLength) || !readRaw(in, altitudes)) return false;
+
+    size_t offset = 0;
+    for (uint32_t a = 0; a < altitudes; ++a) {
+        uint32_t length = 0;
+        uint64_t rows = 0;
+        Source src;
+        if (!readRaw(in, length) || length > 256) return false;
+        std::string alt(length, '\0');
+        if (!in.read(alt.data(), length) || !readRaw(in, rows) || !readRaw(in, src.size) || !readRaw(in, src.mtime))
+            return false;
+        blocks[alt] = Block{offset, static_cast<size_t>(rows)};
+        sources[alt] = src;
+        offset += static_cast<size_t>(rows) * columnCount;
+    }
+    values.resize(offset);
+    if (!in.read(reinterpret_cast<char*>(values.data()), static_cast<std::streamsize>(offset * sizeof(double)))) {
+        std::cerr << "⚠️  Truncated atmosphere cache: " << filename << "\n";
+        blocks.clear();
+        sources.clear();
+        values.clear();
+        return false;
+    }
+    return true;
+}
+
+size_t AtmosphereTable::getRowCount(const std::string& altitude) const {
+    auto it = blocks.find(altitude);
+    return it == blocks.end() ? 0 : it->second.rows;
+}
+
+std::vector<std::string> AtmosphereTable::getAltitudes() const {
+    std::vector<std::string> alts;
+    for (const auto& [alt, _] : blocks) alts.push_back(alt);
+    return alts;
+}
+
+bool AtmosphereTable::getState(const std::string& altitude, size_t row, AtmosphereState& state) const {
+    auto it = blocks.find(altitude);
+    if (it == blocks.end() || row >= it->second.rows) return false;
+    const Block& b = it->second;
+    auto column = [&](int c) { return values[b.offset + c * b.rows + row]; };
+
+    state.massDensity = column(0);
+    for (int s = 0; s < speciesCount; ++s) state.densities[s] = column(1 + s);
+    state.temperature = column(1 + speciesCount);
+    state.dynamicPressure = column(columnCount - 1);
+    return true;
+}
@@ -0,0 +1,143 @@
+#include "Bvh.h"
+#include <algorithm>
+#include <array>
+#include <numeric>
+
+namespace {
+    constexpr int sahBins = 12;
+    constexpr int medianSplitDepth = 64;   // darunter nur noch Medianteilung (Tiefe ≤ 64 + log2 n)
+}
+
+/**
+ * @brief Builds the hierarchy over the given primitive boxes.
+ *
+ * Primitive indices refer to positions in primitiveBounds; after the build,
+ * primitiveOrder() lists them leaf by leaf.
+ *
+ * @param primitiveBounds One box per primitive.
+ */
+void Bvh::build(const std::vector<Aabb>& primitiveBounds) {
+    const uint32_t n = static_cast<uint32_t>(primitiveBounds.size());
+    nodes.clear();
+    order.resize(n);
+    std::iota(order.begin(), order.end(), 0u);
+    if (n == 0) return;
+
+    std::vector<Vector3> centers(n);
+    for (uint32_t i = 0; i < n; ++i) centers[i] = primitiveBounds[i].center();
+
+    nodes.reserve(2 * static_cast<size_t>(n));
+    nodes.emplace_back();
+    subdivide(0, 0, n, 0, primitiveBounds, centers);
+    nodes.shrink_to_fit();
+}
+
+/**
+ * @brief Puts all primitives into the root leaf.
+ *
+ * For a handful of rays a linear scan is cheaper than building the tree.
+ *
+ * @param bounds Union of all primitive boxes.
+ * @param primitiveCount Number of primitives.
+ */
+void Bvh::buildSingleLeaf(const Aabb& bounds, uint32_t primitiveCount) {
+    nodes.clear();
+    order.resize(primitiveCount);
+    std::iota(order.begin(), order.end(), 0u);
+    if (primitiveCount == 0) return;
+
+    BvhNode root;
+    root.box = bounds;
+    root.count = primitiveCount;
+    nodes.assign(1, root);
+}
+
+/**
+ * @brief Splits order[begin, end) below a node, recursively.
+ *
+ * Splits along the largest axis of the centroid bounds at the best of
+ * sahBins bin boundaries by surface area heuristic, or at the median when
+ * the heuristic finds no separating split or the tree gets too deep. A range
+ * becomes a leaf when it is small enough and no split is cheaper.
+ */
+void Bvh::subdivide(uint32_t node, uint32_t begin, uint32_t end, int depth, const std::vector<Aabb>& boxes,
+                    const std::vector<Vector3>& centers) {
+    Aabb box, centerBox;
+    for (uint32_t i = begin; i < end; ++i) {
+        box.grow(boxes[order[i]]);
+        centerBox.grow(centers[order[i]]);
+    }
+    nodes[node].box = box;
+    const uint32_t count = end - begin;
+    if (count <= maxLeafSize) {
+        nodes[node].first = begin;
+        nodes[node].count = count;
+        return;
+    }
+
+    const Vector3 extent = centerBox.hi - centerBox.lo;
+    const int axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+    const double lo = centerBox.lo[axis], width = extent[axis];
+    uint32_t mid = begin;
+
+    if (width > 0.0 && depth < medianSplitDepth) {
+        auto binOf = [&](uint32_t p) {
+            return std::min(sahBins - 1, static_cast<int>((centers[p][axis] - lo) / width * sahBins));
+        };
+        std::array<Aabb, sahBins> binBox;
+        std::array<uint32_t, sahBins> binCount{};
+        for (uint32_t i = begin; i < end; ++i) {
+            const int b = binOf(order[i]);
+            binBox[b].grow(boxes[order[i]]);
+            ++binCount[b];
+        }
+
+        // Kosten der Teilung hinter Bin k: A_links · N_links + A_rechts · N_rechts
+        std::array<double, sahBins - 1> leftCost;
+        Aabb acc;
+        uint32_t accCount = 0;
+        for (int k = 0; k < sahBins - 1; ++k) {
+            acc.grow(binBox[k]);
+            accCount += binCount[k];
+            leftCost[k] = acc.surfaceArea() * accCount;
+        }
+        acc = Aabb();
+        accCount = 0;
+        double bestCost = std::numeric_limits<double>::infinity();
+        int bestSplit = -1;
+        for (int k = sahBins - 1; k > 0; --k) {
+            acc.grow(binBox[k]);
+            accCount += binCount[k];
+            const double cost = leftCost[k - 1] + acc.surfaceArea() * accCount;
+            if (accCount < count && accCount > 0 && cost < bestCost) {
+                bestCost = cost;
+                bestSplit = k - 1;
+            }
+        }
+
+        if (bestSplit >= 0) {
+            if (count <= maxLeafCount && bestCost >= box.surfaceArea() * count) {
+                nodes[node].first = begin;
+                nodes[node].count = count;
+                return;
+            }
+            mid = static_cast<uint32_t>(
+                std::partition(order.begin() + begin, order.begin() + end,
+                               [&](uint32_t p) { return binOf(p) <= bestSplit; }) - order.begin());
+        }
+    }
+
+    if (mid == begin || mid == end) {
+        mid = begin + count / 2;
+        std::nth_element(order.begin() + begin, order.begin() + mid, order.begin() + end,
+                         [&](uint32_t a, uint32_t b) { return centers[a][axis] < centers[b][axis]; });
+    }
+
+    const uint32_t left = static_cast<uint32_t>(nodes.size());
+    nodes.emplace_back();
+    nodes.emplace_back();
+    nodes[node].first = left;
+    nodes[node].count = 0;
+    subdivide(left, begin, mid, depth + 1, boxes, centers);
+    subdivide(left + 1, mid, end, depth + 1, boxes, centers);
+}
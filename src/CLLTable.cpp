@@ -0,0 +1,135 @@
+#include "CLLTable.h"
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <memory>
+#include <algorithm>
+
+/**
+ * @brief Logarithm of the modified Bessel function I0, stable for large arguments.
+ */
+static double logBesselI0(double x) {
+    if (x < 50.0) return std::log(std::cyl_bessel_i(0.0, x));
+
+    // Asymptotische Entwicklung, relativer Fehler < 1e-6 für x ≥ 50
+    double inv = 1.0 / x;
+    return x - 0.5 * std::log(2.0 * M_PI * x)
+             + std::log(1.0 + inv / 8.0 + 9.0 * inv * inv / 128.0);
+}
+
+/**
+ * @brief Builds the inverse-CDF table for the given accommodation coefficients.
+ *
+ * @param alphaN Normal energy accommodation α_n ∈ (0, 1].
+ * @param alphaT Tangential energy accommodation α_t ∈ [0, 1] (stored for the kernel); the
+ *               tangential momentum accommodation σ_t corresponds to α_t = σ_t(2 − σ_t).
+ * @param wallTemp Wall temperature in Kelvin (stored for the kernel).
+ * @param speedBins Number of tabulated incident normal speeds.
+ * @param quantiles Number of quantile intervals per row.
+ * @param maxSpeed Largest tabulated dimensionless incident normal speed.
+ */
+CLLTable::CLLTable(double alphaN, double alphaT, double wallTemp,
+                   int speedBins, int quantiles, double maxSpeed)
+    : alphaN(std::clamp(alphaN, 1e-3, 1.0)),
+      alphaT(std::clamp(alphaT, 0.0, 1.0)),
+      wallTemp(wallTemp),
+      speedBins(std::max(speedBins, 2)),
+      quantiles(std::max(quantiles, 2)),
+      maxSpeed(maxSpeed),
+      speedStep(maxSpeed / (std::max(speedBins, 2) - 1)) {
+    inverseCdf.resize(static_cast<size_t>(this->speedBins) * (this->quantiles + 1));
+    for (int row = 0; row < this->speedBins; ++row) {
+        buildRow(row, row * speedStep);
+    }
+}
+
+/**
+ * @brief Integrates the normal kernel for one incident speed and inverts its CDF.
+ */
+void CLLTable::buildRow(int row, double uIn) {
+    const int fine = 2048;
+    const double shift = std::sqrt(1.0 - alphaN) * uIn;
+    const double uMax = shift + 7.0 * std::sqrt(alphaN) + 1.0;
+    const double du = uMax / fine;
+
+    // Logarithmische Dichte, damit große Argumente nicht überlaufen
+    std::vector<double> logPdf(fine + 1);
+    double logMax = -1e300;
+    for (int k = 0; k <= fine; ++k) {
+        double u = k * du;
+        if (u <= 0.0) { logPdf[k] = -1e300; continue; }
+        double x = 2.0 * std::sqrt(1.0 - alphaN) * u * uIn / alphaN;
+        logPdf[k] = std::log(2.0 * u / alphaN) + logBesselI0(x)
+                  - (u * u + (1.0 - alphaN) * uIn * uIn) / alphaN;
+        logMax = std::max(logMax, logPdf[k]);
+    }
+
+    std::vector<double> cdf(fine + 1, 0.0);
+    for (int k = 1; k <= fine; ++k) {
+        double p0 = std::exp(logPdf[k - 1] - logMax);
+        double p1 = std::exp(logPdf[k] - logMax);
+        cdf[k] = cdf[k - 1] + 0.5 * (p0 + p1) * du;
+    }
+    const double total = cdf[fine];
+
+    // Quantile bei p_q = ½(1 − cos(πq/Q)), verdichtet an beiden Enden;
+    // die äußersten 1e-7 werden abgeschnitten, damit die Randintervalle schmal bleiben
+    double* out = &inverseCdf[static_cast<size_t>(row) * (quantiles + 1)];
+    int k = 0;
+    for (int q = 0; q <= quantiles; ++q) {
+        double p = 0.5 * (1.0 - std::cos(M_PI * q / quantiles));
+        double target = total * std::clamp(p, 1e-7, 1.0 - 1e-7);
+        while (k < fine && cdf[k + 1] < target) ++k;
+        if (k >= fine) { out[q] = uMax; continue; }
+
+        double span = cdf[k + 1] - cdf[k];
+        double frac = span > 0.0 ? (target - cdf[k]) / span : 0.0;
+        out[q] = (k + std::clamp(frac, 0.0, 1.0)) * du;
+    }
+}
+
+/**
+ * @brief Samples the reflected dimensionless normal speed.
+ *
+ * Bilinear interpolation in incident speed and quantile (cosine-spaced, dense at both ends). Beyond the tabulated
+ * range the kernel is nearly translation invariant, so the last row is shifted
+ * by √(1−α_n)·(u_i − u_max).
+ *
+ * @param uIn Incident normal speed in units of √(2kT_w/m), ≥ 0.
+ * @param xi Uniform random number in [0, 1).
+ */
+double CLLTable::sampleNormalSpeed(double uIn, double xi) const {
+    double extra = 0.0;
+    if (uIn > maxSpeed) {
+        extra = std::sqrt(1.0 - alphaN) * (uIn - maxSpeed);
+        uIn = maxSpeed;
+    }
+
+    double fu = std::max(uIn, 0.0) / speedStep;
+    int r0 = std::min(static_cast<int>(fu), speedBins - 2);
+    double wu = fu - r0;
+
+    double fq = std::acos(1.0 - 2.0 * std::clamp(xi, 0.0, 1.0)) / M_PI * quantiles;
+    int q0 = std::min(static_cast<int>(fq), quantiles - 1);
+    double wq = fq - q0;
+
+    const double* a = &inverseCdf[static_cast<size_t>(r0) * (quantiles + 1)];
+    const double* b = a + (quantiles + 1);
+    double sa = a[q0] + wq * (a[q0 + 1] - a[q0]);
+    double sb = b[q0] + wq * (b[q0 + 1] - b[q0]);
+    return sa + wu * (sb - sa) + extra;
+}
+
+/**
+ * @brief Returns the table for (α_n, α_t, T_w), building it on first use.
+ */
+const CLLTable& CLLTable::cached(double alphaN, double alphaT, double wallTemp) {
+    static std::mutex mutex;
+    static std::map<std::tuple<double, double, double>, std::unique_ptr<CLLTable>> tables;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& entry = tables[{alphaN, alphaT, wallTemp}];
+    if (!entry) entry = std::make_unique<CLLTable>(alphaN, alphaT, wallTemp);
+    return *entry;
+}
@@ -1,9 +1,12 @@
 #include "ConfigLoader.h"
 #include "ini.h"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <stdexcept>
 #include <string>
 #include <sstream>
+#include <vector>
 
 /// @brief Internal context structure used during INI parsing.
 struct INIContext {
@@ -11,6 +14,36 @@ struct INIContext {
     std::string currentSection;
 };
 
+/// @brief Parse a grid range "start,end,count" (a single value gives a one-point grid).
+GridRange parseGridRange(const std::string& value) {
+    std::stringstream ss(value);
+    std::string part;
+    std::vector<double> parts;
+    while (std::getline(ss, part, ',')) parts.push_back(std::stod(part));
+
+    GridRange range;
+    if (parts.size() == 1) {
+        range.start = range.end = parts[0];
+    } else if (parts.size() == 3) {
+        range.start = parts[0];
+        range.end = parts[1];
+        range.count = std::max(1, static_cast<int>(parts[2]));
+    } else {
+        std::cerr << "⚠️  Expected start,end,count: " << value << "\n";
+    }
+    return range;
+}
+
+/// @brief Parse a vector "x,y,z"; other component counts leave the target unchanged.
+static void parseVector(const std::string& value, Vector3& target) {
+    std::stringstream ss(value);
+    std::string component;
+    std::vector<double> c;
+    while (std::getline(ss, component, ',')) c.push_back(std::stod(component));
+    if (c.size() == 3) target = Vector3{c[0], c[1], c[2]};
+    else std::cerr << "⚠️  Expected x,y,z: " << value << "\n";
+}
+
 /// @brief Handler function for each key-value pair encountered by the INI parser.
 static int iniHandler(void* user, const char* section, const char* name, const char* value) {
     INIContext* context = static_cast<INIContext*>(user);
@@ -20,6 +53,44 @@ static int iniHandler(void* user, const char* section, const char* name, const c
 
     context->currentSection = sectionStr;
 
+    // Per-material surface parameters (OBJ usemtl names)
+    if (sectionStr.find("material:") == 0) {
+        MaterialInfo& mat = cfg->materials[sectionStr.substr(9)]; // Skip "material:"
+
+        if (key == "energyAccommodation") {
+            mat.energyAccommodation = std::stod(value);
+        } else if (key == "wallTemperature") {
+            mat.wallTemperature = std::stod(value);
+        } else if (key == "specularFraction") {
+            mat.specularFraction = std::stod(value);
+        } else if (key == "reflectionRatio") {
+            mat.reflectionRatio = std::stod(value);
+        } else if (key == "energyLoss") {
+            mat.energyLoss = std::stod(value);
+        } else if (key == "normalAccommodation") {
+            mat.normalAccommodation = std::stod(value);
+        } else if (key == "tangentialAccommodation") {
+            mat.tangentialAccommodation = std::stod(value);
+        }
+        return 1;
+    }
+
+    // Rigid sub-body poses (OBJ o/g names)
+    if (sectionStr.find("body:") == 0) {
+        BodyPose& pose = cfg->bodies[sectionStr.substr(5)]; // Skip "body:"
+
+        if (key == "axis") {
+            parseVector(value, pose.axis);
+        } else if (key == "angle") {
+            pose.angle = std::stod(value);
+        } else if (key == "pivot") {
+            parseVector(value, pose.pivot);
+        } else if (key == "translation") {
+            parseVector(value, pose.translation);
+        }
+        return 1;
+    }
+
     // Read basic configuration options
     if (key == "geometryFile") {
         cfg->geometryFile = value;
@@ -34,7 +105,88 @@ static int iniHandler(void* user, const char* section, const char* name, const c
     } else if (key == "temperature") {
         cfg->temperature = std::stod(value);
     } else if (key == "mass_density") {
-        cfg->massDensity = std::stod(value);
+        cfg->mass_density = std::stod(value);
+    } else if (key == "model") {
+        cfg->model = value;
+    } else if (key == "energyAccommodation") {
+        cfg->energyAccommodation = std::stod(value);
+    } else if (key == "wallTemperature") {
+        cfg->WallTemp = std::stod(value);
+    } else if (key == "specularFraction") {
+        cfg->specularFraction = std::stod(value);
+    } else if (key == "normalAccommodation") {
+        cfg->normalAccommodation = std::stod(value);
+    } else if (key == "tangentialAccommodation") {
+        cfg->tangentialAccommodation = std::stod(value);
+    } else if (key == "solver") {
+        cfg->solver = value;
+    } else if (key == "tracePrecision") {
+        cfg->tracePrecision = value;
+    } else if (key == "visibilitySamples") {
+        cfg->visibilitySamples = std::stoi(value);
+    } else if (key == "seed") {
+        cfg->seed = std::stoi(value);
+    } else if (key == "traceFile") {
+        cfg->traceFile = value;
+    } else if (key == "traceBufferEvents") {
+        cfg->traceBufferEvents = std::stoi(value);
+    } else if (key == "perfCounters") {
+        cfg->perfCounters = (std::string(value) == "true" || std::string(value) == "1");
+    } else if (key == "serviceCacheSize") {
+        cfg->serviceCacheSize = std::stoi(value);
+    } else if (key == "serviceQuantization") {
+        cfg->serviceQuantization = std::stod(value);
+    } else if (key == "atmosphereDirectory") {
+        cfg->atmosphereDirectory = value;
+    } else if (key == "atmosphereCache") {
+        cfg->atmosphereCache = value;
+    } else if (key == "atmosphereModel") {
+        cfg->atmosphereModel = value;
+    } else if (key == "latitude") {
+        cfg->latitude = std::stod(value);
+    } else if (key == "longitude") {
+        cfg->longitude = std::stod(value);
+    } else if (key == "dayOfYear") {
+        cfg->dayOfYear = std::stod(value);
+    } else if (key == "utSeconds") {
+        cfg->utSeconds = std::stod(value);
+    } else if (key == "f107") {
+        cfg->f107 = std::stod(value);
+    } else if (key == "f107a") {
+        cfg->f107a = std::stod(value);
+    } else if (key == "ap") {
+        cfg->ap = std::stod(value);
+    } else if (key == "databaseFile") {
+        cfg->databaseFile = value;
+    } else if (key == "databaseAoA") {
+        cfg->databaseAoA = parseGridRange(value);
+    } else if (key == "databaseSideslip") {
+        cfg->databaseSideslip = parseGridRange(value);
+    } else if (key == "databaseSpeedRatio") {
+        cfg->databaseSpeedRatio = parseGridRange(value);
+    } else if (key == "databaseTemperatureRatio") {
+        cfg->databaseTemperatureRatio = parseGridRange(value);
+    } else if (key == "attitudeSideslip") {
+        cfg->attitudeSideslip = parseGridRange(value);
+    } else if (key == "attitudeRoll") {
+        cfg->attitudeRoll = parseGridRange(value);
+    } else if (key == "attitudeQuaternion") {
+        std::stringstream ss(value);
+        std::string component;
+        std::vector<double> q;
+        while (std::getline(ss, component, ',')) q.push_back(std::stod(component));
+        if (q.size() == 4) cfg->attitudeQuaternion = std::array<double, 4>{q[0], q[1], q[2], q[3]};
+        else std::cerr << "⚠️  Expected w,x,y,z: " << value << "\n";
+    } else if (key == "heatmapOutputFile") {
+        cfg->heatmapOutputFile = value;
+    } else if (key == "referenceLength") {
+        cfg->referenceLength = std::stod(value);
+    } else if (key == "centerOfMass") {
+        std::stringstream ss(value);
+        std::string component;
+        std::vector<double> c;
+        while (std::getline(ss, component, ',')) c.push_back(std::stod(component));
+        if (c.size() == 3) cfg->centerOfMass = Vector3{c[0], c[1], c[2]};
     } else if (key == "direction") {
         // Parse flow direction from comma-separated values
         std::stringstream ss(value);
@@ -63,6 +215,31 @@ static int iniHandler(void* user, const char* section, const char* name, const c
     return 1; // Success
 }
 
+/// @brief Rotation by angle about the axis through pivot, followed by the translation.
+RigidTransform BodyPose::transform() const {
+    RigidTransform T = RigidTransform::rotation(axis, angle * M_PI / 180.0, pivot);
+    T.translation = T.translation + translation;
+    return T;
+}
+
+/// @brief Map configured body poses onto the sub-bodies of a loaded mesh.
+/// @param poses Poses by OBJ o/g name.
+/// @param bodyNames Body names of the mesh, index = Triangle::bodyId.
+/// @return One transform per body (identity where no pose is given).
+std::vector<RigidTransform> resolveBodyTransforms(const std::map<std::string, BodyPose>& poses,
+                                                  const std::vector<std::string>& bodyNames) {
+    std::vector<RigidTransform> transforms(bodyNames.size());
+    for (const auto& [name, pose] : poses) {
+        auto it = std::find(bodyNames.begin(), bodyNames.end(), name);
+        if (name.empty() || it == bodyNames.end()) {
+            std::cerr << "⚠️  [body:" << name << "] names no o/g group of the mesh, ignored.\n";
+            continue;
+        }
+        transforms[it - bodyNames.begin()] = pose.transform();
+    }
+    return transforms;
+}
+
 /// @brief Load configuration from an INI file.
 /// @param filename The path to the config file.
 /// @return True if successful, false on failure.
@@ -75,12 +252,19 @@ bool ConfigLoader::loadFromFile(const std::string& filename) {
         return false;
     }
 
+    // Rasterweite der Cache-Schlüssel: 0, negativ oder NaN ergäbe Division durch null
+    if (!std::isfinite(config.serviceQuantization) || config.serviceQuantization <= 0.0) {
+        std::cerr << "❌ serviceQuantization must be positive, got " << config.serviceQuantization
+                  << " in " << filename << std::endl;
+        return false;
+    }
+
     return true;
 }
 
 /// @brief Get the parsed configuration object.
 /// @return Parsed SimulationConfig instance.
-SimulationConfig ConfigLoader::getConfig() const {
+const SimulationConfig& ConfigLoader::getConfig() const {
     return config;
 }
 
@@ -1,5 +1,17 @@
 #include "DragForceCalculator.h"
+#include <algorithm>
 #include <iostream>
+#include <fstream>
+
+/// @brief Initialise the per-panel area of every panel from the triangle table.
+/// @param table Precomputed triangle attributes (panel IDs index the per-panel table).
+void DragForceCalculator::setMesh(const TriangleTable& table) {
+    perPanelForces.reserve(table.panelIdCount());
+    used.reserve(table.panelIdCount());
+    for (const auto& tri : table) {
+        if (PanelForce* pf = panel(tri.panelId)) pf->area = tri.area;
+    }
+}
 
 /// @brief Accumulate drag force contributions from a single ray interaction.
 /// @param incidentRay Incoming ray before surface hit.
@@ -16,36 +28,144 @@ void DragForceCalculator::accumulateForce(const Ray& incidentRay, const Ray& ref
     totalForce += weightedForce;
 
     // Accumulate per-panel force
-    perPanelForces[incidentRay.panelId] += weightedForce;
+    if (PanelForce* pf = panel(incidentRay.panelId)) {
+        pf->force += weightedForce;
+        if (panelArea > 0.0) pf->area = panelArea;
+    }
+}
+
+/// @brief Split a gas momentum change rate into wall pressure and shear and add the heat load.
+/// @param pf Panel receiving the load.
+/// @param deltaP Momentum change rate of the gas in [N].
+/// @param normal Unit normal pointing to the gas side of the panel.
+/// @param heat Energy transferred to the wall per unit time in [W].
+void DragForceCalculator::addSurfaceLoad(PanelForce& pf, const Vector3& deltaP, const Vector3& normal, double heat) {
+    const double dpn = deltaP.dot(normal);
+    pf.normalForce += dpn;
+    pf.shear += (normal * dpn - deltaP);
+    pf.heat += heat;
+}
 
-    // Store this ray pair for debugging or analysis (optional)
-    rayContributions.push_back({incidentRay, reflectedRay, panelArea});
+/// @brief Accumulate force, moment, pressure, shear and heat load of a single surface hit.
+///
+/// The energy given to the wall is the difference of incident and reflected
+/// ray energy, so DRIA/Sentman accommodation and CLL re-emission all feed the
+/// heat load directly.
+///
+/// @param incidentRay Incoming ray before surface hit.
+/// @param reflectedRay Reflected ray after surface interaction.
+/// @param panelArea Area of the surface panel the ray hit.
+/// @param hit Hit record; the contribution is booked on hit.panelId at hit.point.
+void DragForceCalculator::accumulateForce(const Ray& incidentRay, const Ray& reflectedRay, double panelArea,
+                                          const HitInfo& hit) {
+    Vector3 weightedForce = (reflectedRay.momentum - incidentRay.momentum) * incidentRay.weight;
+    Vector3 moment = (hit.point - referencePoint).cross(weightedForce);
+
+    totalForce += weightedForce;
+    totalMoment += moment;
+
+    PanelForce* pf = panel(hit.panelId);
+    if (!pf) return;
+    pf->force += weightedForce;
+    pf->moment += moment;
+    if (panelArea > 0.0) pf->area = panelArea;
+    addSurfaceLoad(*pf, weightedForce, hit.normal,
+                   (incidentRay.energy - reflectedRay.energy) * incidentRay.weight);
 }
 
-/// @brief Return the total accumulated drag force vector.
-/// @return Vector3 total force.
-Vector3 DragForceCalculator::getTotalDragForce() const {
-    return totalForce;
+/// @brief Add a precomputed (e.g. analytic) momentum change rate for one panel.
+/// @param panelId Panel receiving the contribution.
+/// @param deltaP Momentum change rate of the gas in [N] (same sign convention as accumulateForce).
+void DragForceCalculator::addPanelForce(int panelId, const Vector3& deltaP) {
+    totalForce += deltaP;
+    if (PanelForce* pf = panel(panelId)) pf->force += deltaP;
 }
 
-/// @brief Get all per-panel forces (map from panel ID to total force on that panel).
-/// @return Map of panel ID to force vector.
-std::map<int, Vector3> DragForceCalculator::getPanelForces() const {
-    return perPanelForces;
+/// @brief Add a precomputed momentum change rate acting at a given point (e.g. the panel centroid).
+/// @param panelId Panel receiving the contribution.
+/// @param deltaP Momentum change rate of the gas in [N].
+/// @param point Point of application for the moment about the reference point.
+void DragForceCalculator::addPanelForce(int panelId, const Vector3& deltaP, const Vector3& point) {
+    Vector3 moment = (point - referencePoint).cross(deltaP);
+    totalForce += deltaP;
+    totalMoment += moment;
+    if (PanelForce* pf = panel(panelId)) {
+        pf->force += deltaP;
+        pf->moment += moment;
+    }
+}
+
+/// @brief Add a precomputed panel load (force at a point, pressure/shear split and heat).
+/// @param panelId Panel receiving the contribution.
+/// @param deltaP Momentum change rate of the gas in [N].
+/// @param point Point of application for the moment about the reference point.
+/// @param normal Unit normal pointing to the gas side of the panel.
+/// @param heat Energy transferred to the wall per unit time in [W].
+void DragForceCalculator::addPanelLoad(int panelId, const Vector3& deltaP, const Vector3& point,
+                                       const Vector3& normal, double heat) {
+    addPanelForce(panelId, deltaP, point);
+    if (PanelForce* pf = panel(panelId)) addSurfaceLoad(*pf, deltaP, normal, heat);
 }
 
 /// @brief Merge data from another DragForceCalculator instance.
 /// @param other The other instance to merge into this one.
 void DragForceCalculator::merge(const DragForceCalculator& other) {
     totalForce += other.totalForce;
+    totalMoment += other.totalMoment;
 
-    for (const auto& [id, force] : other.perPanelForces) {
-        perPanelForces[id] += force;
+    for (size_t id = 0; id < other.perPanelForces.size(); ++id) {
+        if (!other.used[id]) continue;
+        const PanelForce& pf = other.perPanelForces[id];
+        PanelForce& mine = *panel(static_cast<int>(id));
+        mine.force += pf.force;
+        mine.moment += pf.moment;
+        mine.heat += pf.heat;
+        mine.normalForce += pf.normalForce;
+        mine.shear += pf.shear;
+        if (mine.area == 0.0) mine.area = pf.area;
     }
+}
 
-    rayContributions.insert(rayContributions.end(),
-                            other.rayContributions.begin(),
-                            other.rayContributions.end());
+/// @brief Copy of all panels with an entry (from setMesh or a contribution), keyed by panel ID.
+std::map<int, PanelForce> DragForceCalculator::getPanelForces() const {
+    std::map<int, PanelForce> panels;
+    for (size_t id = 0; id < perPanelForces.size(); ++id)
+        if (used[id]) panels.emplace_hint(panels.end(), static_cast<int>(id), perPanelForces[id]);
+    return panels;
+}
+
+/// @brief Pack force, moment, heat, normal force and shear of panels 0..panelCount-1 densely.
+/// @param panelCount Number of panel IDs (panels without contributions are zero).
+/// @return panelCount · panelLoadStride values, summable element-wise across ranks.
+std::vector<double> DragForceCalculator::packPanelLoads(size_t panelCount) const {
+    std::vector<double> packed(panelCount * panelLoadStride, 0.0);
+    for (size_t id = 0; id < std::min(panelCount, perPanelForces.size()); ++id) {
+        const PanelForce& pf = perPanelForces[id];
+        double* p = &packed[id * panelLoadStride];
+        for (int k = 0; k < 3; ++k) {
+            p[k] = pf.force[k];
+            p[3 + k] = pf.moment[k];
+            p[8 + k] = pf.shear[k];
+        }
+        p[6] = pf.heat;
+        p[7] = pf.normalForce;
+    }
+    return packed;
+}
+
+/// @brief Replace the per-panel loads with a packed table (e.g. after MPI_Reduce).
+/// Areas already known are kept; totals are not touched.
+void DragForceCalculator::unpackPanelLoads(const std::vector<double>& packed) {
+    const size_t panelCount = packed.size() / panelLoadStride;
+    for (size_t id = 0; id < panelCount; ++id) {
+        const double* p = &packed[id * panelLoadStride];
+        PanelForce& pf = *panel(static_cast<int>(id));
+        pf.force = {p[0], p[1], p[2]};
+        pf.moment = {p[3], p[4], p[5]};
+        pf.heat = p[6];
+        pf.normalForce = p[7];
+        pf.shear = {p[8], p[9], p[10]};
+    }
 }
 
 /// @brief Computes a scaled drag force based on total incoming mass flux.
@@ -54,8 +174,8 @@ void DragForceCalculator::merge(const DragForceCalculator& other) {
 Vector3 DragForceCalculator::computeScaledForce(double totalMassFlux) const {
     // Compute total unscaled force magnitude (i.e., sum of ray contributions)
     double summedWeights = 0.0;
-    for (const auto& [_, force] : perPanelForces) {
-        summedWeights += force.norm();  // Could alternatively use ray weight sum
+    for (const auto& pf : perPanelForces) {
+        summedWeights += pf.force.norm();  // Could alternatively use ray weight sum
     }
 
     // If weights available, scale force to match physical mass flux
@@ -65,3 +185,23 @@ Vector3 DragForceCalculator::computeScaledForce(double totalMassFlux) const {
         return totalForce;  // No scaling possible
 }
 
+/// @brief Write the per-panel force table as CSV
+/// (panelId, area, fx, fy, fz, mx, my, mz, heat, normalForce, shearx, sheary, shearz).
+/// @param filename Output file name.
+void DragForceCalculator::exportPanelForcesCSV(const std::string& filename) const {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "❌ Failed to open CSV file: " << filename << "\n";
+        return;
+    }
+
+    file << "panelId,area,fx,fy,fz,mx,my,mz,heat,normalForce,shearx,sheary,shearz\n";
+    for (const auto& [id, pf] : getPanelForces()) {
+        file << id << "," << pf.area << ","
+             << pf.force.x << "," << pf.force.y << "," << pf.force.z << ","
+             << pf.moment.x << "," << pf.moment.y << "," << pf.moment.z << ","
+             << pf.heat << "," << pf.normalForce << ","
+             << pf.shear.x << "," << pf.shear.y << "," << pf.shear.z << "\n";
+    }
+    std::cout << "✅ Panel force CSV written: " << filename << "\n";
+}
@@ -0,0 +1,293 @@
+#include "DragService.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+
+DragService::DragService(const SimulationConfig& cfg) : cfg(cfg) {
+    if (!quantizationValid(cfg.serviceQuantization))
+        std::cerr << "❌ DragService: serviceQuantization must be positive and finite, got "
+                  << cfg.serviceQuantization << "; all requests will fail\n";
+}
+
+/// @brief True for a usable cache grid step (finite and > 0).
+bool DragService::quantizationValid(double q) {
+    return std::isfinite(q) && q > 0.0;
+}
+
+/**
+ * @brief Loads a geometry and keeps its solver resident.
+ *
+ * @param id Name used in requests.
+ * @param path OBJ file.
+ * @return false if the mesh could not be loaded.
+ */
+bool DragService::addGeometry(const std::string& id, const std::string& path) {
+    auto solver = std::make_unique<DragSolver>(cfg);
+    if (!solver->loadMesh(path)) return false;
+    solvers[id] = std::move(solver);
+    std::cout << "✔️  Geometry '" << id << "' resident (" << path << ")\n";
+    return true;
+}
+
+// Nur beim Start registrierte Geometrien; unbekannte IDs werden nie als Pfad geöffnet
+DragSolver* DragService::findSolver(const std::string& id) {
+    auto it = solvers.find(id);
+    return it != solvers.end() ? it->second.get() : nullptr;
+}
+
+/**
+ * @brief Rotates an inertial vector into the body frame: v_b = q* v q.
+ *
+ * @param attitude Unit quaternion (w, x, y, z) from body to inertial frame.
+ * @param v Vector in the inertial frame.
+ */
+Vector3 DragService::toBodyFrame(const double attitude[4], const Vector3& v) {
+    const double n = std::sqrt(attitude[0] * attitude[0] + attitude[1] * attitude[1] +
+                               attitude[2] * attitude[2] + attitude[3] * attitude[3]);
+    const double w = attitude[0] / n;
+    const Vector3 u = Vector3{-attitude[1], -attitude[2], -attitude[3]} * (1.0 / n);   // konjugiert
+
+    // v' = v + 2w (u × v) + 2 u × (u × v)
+    Vector3 t = u.cross(v) * 2.0;
+    return v + t * w + u.cross(t);
+}
+
+/**
+ * @brief Quantized cache key of a request (body frame).
+ *
+ * Direction components are rounded to steps of serviceQuantization, speed,
+ * temperature and densities to relative steps of the same size.
+ */
+std::string DragService::cacheKey(const DragRequest& request) const {
+    const double q = cfg.serviceQuantization;
+    const Vector3 vBody = toBodyFrame(request.attitude, request.velocity);
+    const Vector3 dir = vBody.normalize();
+
+    auto linear = [q](double x) { return static_cast<long long>(std::llround(x / q)); };
+    auto relative = [q](double x) {
+        return x > 0.0 ? static_cast<long long>(std::llround(std::log(x) / std::log1p(q))) : LLONG_MIN;
+    };
+
+    std::ostringstream key;
+    key << request.geometry << '|' << linear(dir.x) << ',' << linear(dir.y) << ',' << linear(dir.z)
+        << '|' << relative(vBody.norm()) << '|' << relative(request.temperature);
+    for (const auto& [name, density] : request.densities)
+        key << '|' << name << '=' << relative(density);
+    return key.str();
+}
+
+void DragService::storeResult(const std::string& key, const DragResult& result) {
+    if (cfg.serviceCacheSize <= 0) return;
+    if (cache.emplace(key, result).second) cacheOrder.push_back(key);
+    while (cache.size() > static_cast<size_t>(cfg.serviceCacheSize)) {
+        cache.erase(cacheOrder.front());
+        cacheOrder.pop_front();
+    }
+}
+
+/**
+ * @brief Answers a batch of requests.
+ *
+ * Cached keys are answered directly; the remaining requests are grouped by
+ * geometry and evaluated with one computeBatch call per geometry. Requests
+ * of the same batch with equal keys are computed once.
+ *
+ * @param requests Requests in arrival order.
+ * @param cached Optional output: 1 where the result came from the cache.
+ * @return Body-frame results in the same order (valid = false on error, and for
+ *         every request if serviceQuantization is not positive).
+ */
+std::vector<DragResult> DragService::handleBatch(const std::vector<DragRequest>& requests,
+                                                 std::vector<char>* cached) {
+    const size_t n = requests.size();
+    std::vector<DragResult> results(n);
+    std::vector<std::string> keys(n);
+    std::vector<long> sameAs(n, -1);                           // Duplikat eines früheren Eintrags
+    std::map<DragSolver*, std::vector<size_t>> pending;
+    std::unordered_map<std::string, size_t> firstPending;
+    if (cached) cached->assign(n, 0);
+    ++stats.batches;
+
+    // Ohne gültige Rasterweite gibt es keinen Cache-Schlüssel
+    if (!quantizationValid(cfg.serviceQuantization)) {
+        stats.requests += n;
+        stats.errors += n;
+        return results;
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        ++stats.requests;
+        DragSolver* solver = findSolver(requests[i].geometry);
+        if (!solver) {
+            std::cerr << "❌ Unknown geometry: " << requests[i].geometry << "\n";
+            ++stats.errors;
+            continue;
+        }
+
+        keys[i] = cacheKey(requests[i]);
+        auto hit = cache.find(keys[i]);
+        if (hit != cache.end()) {
+            results[i] = hit->second;
+            if (cached) (*cached)[i] = 1;
+            ++stats.cacheHits;
+            continue;
+        }
+
+        auto [first, inserted] = firstPending.emplace(keys[i], i);
+        if (!inserted) {
+            sameAs[i] = static_cast<long>(first->second);
+            if (cached) (*cached)[i] = 1;
+            ++stats.cacheHits;
+            continue;
+        }
+        pending[solver].push_back(i);
+    }
+
+    for (const auto& [solver, indices] : pending) {
+        std::vector<FlowState> states;
+        states.reserve(indices.size());
+        for (size_t i : indices) {
+            const DragRequest& r = requests[i];
+            const Vector3 vBody = toBodyFrame(r.attitude, r.velocity);
+            FlowState s;
+            s.direction = vBody.normalize();
+            s.velocity = vBody.norm();
+            s.temperature = r.temperature;
+            s.densities = r.densities;
+            states.push_back(std::move(s));
+        }
+
+        std::vector<DragResult> computed = solver->computeBatch(states);
+        for (size_t k = 0; k < indices.size(); ++k) {
+            results[indices[k]] = computed[k];
+            ++stats.computed;
+            if (computed[k].valid) storeResult(keys[indices[k]], computed[k]);
+            else ++stats.errors;
+        }
+    }
+
+    for (size_t i = 0; i < n; ++i)
+        if (sameAs[i] >= 0) results[i] = results[sameAs[i]];
+    return results;
+}
+
+/**
+ * @brief Parses one request line.
+ *
+ * Format: `<geometry> <qw> <qx> <qy> <qz> <vx> <vy> <vz> <T> <species>=<density> ...`
+ */
+bool DragService::parseRequest(const std::string& line, DragRequest& request, std::string& error) {
+    std::istringstream in(line);
+    request = DragRequest{};
+    if (!(in >> request.geometry >> request.attitude[0] >> request.attitude[1] >> request.attitude[2]
+             >> request.attitude[3] >> request.velocity.x >> request.velocity.y >> request.velocity.z
+             >> request.temperature)) {
+        error = "expected: geometry qw qx qy qz vx vy vz T species=density...";
+        return false;
+    }
+
+    const double qNorm = std::abs(request.attitude[0]) + std::abs(request.attitude[1]) +
+                         std::abs(request.attitude[2]) + std::abs(request.attitude[3]);
+    if (qNorm <= 0.0) {
+        error = "attitude quaternion is zero";
+        return false;
+    }
+    if (request.velocity.norm() <= 0.0 || request.temperature <= 0.0) {
+        error = "velocity and temperature must be positive";
+        return false;
+    }
+
+    std::string token;
+    while (in >> token) {
+        size_t eq = token.find('=');
+        if (eq == std::string::npos || eq == 0) {
+            error = "bad species token: " + token;
+            return false;
+        }
+        try {
+            request.densities[token.substr(0, eq)] = std::stod(token.substr(eq + 1));
+        } catch (const std::exception&) {
+            error = "bad density: " + token;
+            return false;
+        }
+    }
+    if (request.densities.empty()) {
+        error = "no species densities given";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Response line: `OK fx fy fz mx my mz cd σfx σfy σfz σmx σmy σmz σcd rays cached`.
+ */
+std::string DragService::formatResult(const DragResult& r, bool cached) {
+    if (!r.valid) return "ERR query failed (unknown species or geometry, or invalid service configuration)";
+
+    std::ostringstream out;
+    out.precision(9);
+    out << "OK " << r.force.x << ' ' << r.force.y << ' ' << r.force.z << ' '
+        << r.torque.x << ' ' << r.torque.y << ' ' << r.torque.z << ' ' << r.cd << ' '
+        << r.forceError.x << ' ' << r.forceError.y << ' ' << r.forceError.z << ' '
+        << r.torqueError.x << ' ' << r.torqueError.y << ' ' << r.torqueError.z << ' ' << r.cdError << ' '
+        << r.rays << ' ' << (cached ? 1 : 0);
+    return out.str();
+}
+
+/**
+ * @brief Answers protocol lines; all valid requests form one batch.
+ *
+ * `STATS` returns the service counters (after this batch) instead of a drag result. Blank and
+ * comment lines get an empty reply, so replies[i] always belongs to lines[i].
+ */
+std::vector<std::string> DragService::handleLines(const std::vector<std::string>& lines) {
+    std::vector<std::string> replies;
+    std::vector<DragRequest> requests;
+    std::vector<size_t> replyIndex;
+    std::vector<size_t> statsIndex;
+
+    for (const auto& line : lines) {
+        size_t start = line.find_first_not_of(" \t\r");
+        if (start == std::string::npos || line[start] == '#') {
+            replies.emplace_back();
+            continue;
+        }
+
+        if (line.compare(start, 5, "STATS") == 0) {
+            statsIndex.push_back(replies.size());
+            replies.emplace_back();
+            continue;
+        }
+
+        DragRequest request;
+        std::string error;
+        if (!parseRequest(line, request, error)) {
+            ++stats.errors;
+            replies.push_back("ERR " + error);
+            continue;
+        }
+        replyIndex.push_back(replies.size());
+        replies.emplace_back();
+        requests.push_back(std::move(request));
+    }
+
+    if (!requests.empty()) {
+        std::vector<char> cached;
+        std::vector<DragResult> results = handleBatch(requests, &cached);
+        for (size_t k = 0; k < results.size(); ++k)
+            replies[replyIndex[k]] = formatResult(results[k], cached[k]);
+    }
+
+    // Zähler erst nach dem Batch, damit STATS die Anfragen derselben Runde enthält
+    for (size_t k : statsIndex) {
+        std::ostringstream out;
+        out << "STATS requests=" << stats.requests << " cache_hits=" << stats.cacheHits
+            << " computed=" << stats.computed << " batches=" << stats.batches
+            << " errors=" << stats.errors << " geometries=" << solvers.size()
+            << " cache_entries=" << cache.size();
+        replies[k] = out.str();
+    }
+    return replies;
+}
@@ -0,0 +1,289 @@
+#include "DragSolver.h"
+#include "BounceKernel.h"
+#include "MeshLoader.h"
+#include "SimulationController.h"
+#include <omp.h>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace {
+    constexpr int maxBouncesPerRay = 10;   // wie TestMain
+}
+
+/**
+ * @brief Stores the base configuration; call loadMesh() before the first query.
+ *
+ * @param base Configuration providing surface model, solver, ray count, seed,
+ *             material sections and species masses.
+ */
+DragSolver::DragSolver(const SimulationConfig& base)
+    : base(base),
+      hybrid(base.solver == "hybrid"),
+      modelType(parseSurfaceModel(base.model)),
+      model(base.reflectionRatio, base.absorptionRatio) {
+    panelMethod.setVerbose(false);
+}
+
+/**
+ * @brief Loads the mesh and builds everything that does not depend on the flow.
+ *
+ * Panel IDs are the triangle indices (as in TestMain). The default reference
+ * point is the bounding-box centre of the loaded file and the default
+ * reference area half the wetted surface; both can be overridden afterwards.
+ * Body poses from [body:<name>] sections of the base configuration are
+ * applied right away.
+ *
+ * @param path OBJ file.
+ * @return false if the mesh could not be loaded or is empty.
+ */
+bool DragSolver::loadMesh(const std::string& path) {
+    if (!mesh.load(path) || mesh.getTriangles().empty()) {
+        std::cerr << "❌ DragSolver: could not load mesh " << path << "\n";
+        mesh = MeshLoader();
+        return false;
+    }
+
+    bodyTransforms = resolveBodyTransforms(base.bodies, mesh.getBodyNames());
+    vertices = mesh.getPosedVertices(bodyTransforms);
+    triangleTable = hybrid ? TriangleTable::posed(mesh.getTriangleTable(), bodyTransforms) : mesh.getTriangleTable();
+    referenceArea = 0.5 * triangleTable->getTotalArea();
+    auto [bbMin, bbMax] = mesh.getBoundingBox();
+    referencePoint = (bbMin + bbMax) * 0.5;
+
+    model.prepare(base, mesh.getMaterialNames());
+    engine.setPrecision(parseTracePrecision(base.tracePrecision));
+    engine.setMesh(mesh.getInstancedMesh());
+    engine.setBodyTransforms(bodyTransforms);
+    preparePanelMethod();
+    return true;
+}
+
+/**
+ * @brief Moves one named sub-body.
+ *
+ * @param body OBJ o/g name.
+ * @param transform Pose relative to the loaded file (replaces the previous one).
+ * @return false if the mesh has no such body.
+ */
+bool DragSolver::setBodyTransform(const std::string& body, const RigidTransform& transform) {
+    const auto& names = mesh.getBodyNames();
+    auto it = std::find(names.begin(), names.end(), body);
+    if (body.empty() || it == names.end()) {
+        std::cerr << "❌ DragSolver: mesh has no sub-body " << body << "\n";
+        return false;
+    }
+    std::vector<RigidTransform> transforms = bodyTransforms;
+    transforms[it - names.begin()] = transform;
+    setBodyTransforms(transforms);
+    return true;
+}
+
+/**
+ * @brief Moves the sub-bodies for the following queries.
+ *
+ * The triangle BVHs stay as built; the engine only re-places the instances
+ * of moved bodies and rebuilds its top level, and the vertices that bound
+ * the ray source are moved. With solver = hybrid the moved triangle table,
+ * the isolated panels and the visibility graph are recomputed as well,
+ * since moving a body changes which panels see each other; solver =
+ * raytrace needs nothing else.
+ *
+ * @param transforms Transform per body ID; missing entries mean the loaded position.
+ */
+void DragSolver::setBodyTransforms(const std::vector<RigidTransform>& transforms) {
+    if (!isReady()) return;
+    bodyTransforms = transforms;
+    bodyTransforms.resize(mesh.getBodyNames().size());
+    engine.setBodyTransforms(bodyTransforms);
+    vertices = mesh.getPosedVertices(bodyTransforms);
+    if (hybrid) triangleTable = TriangleTable::posed(mesh.getTriangleTable(), bodyTransforms);
+    preparePanelMethod();
+}
+
+/**
+ * @brief Panel-method state for the current body poses.
+ */
+void DragSolver::preparePanelMethod() {
+    panelMethod.setMesh(triangleTable);
+    panelMethod.setMaterials(model.getMaterials());
+    panelMethod.setSurfaceModel(base);
+
+    coupledPanels.clear();
+    if (hybrid) {
+        panelMethod.detectIsolatedPanels();
+        panelMethod.buildVisibilityGraph(engine, base.visibilitySamples);
+        coupledPanels = panelMethod.getCoupledPanels();
+    } else {
+        for (const auto& t : mesh.getTriangles()) coupledPanels.push_back(t.panelId);
+    }
+}
+
+size_t DragSolver::getCoupledPanelCount() const {
+    return coupledPanels.size();
+}
+
+/**
+ * @brief Base configuration with the flow state of one query.
+ */
+SimulationConfig DragSolver::makeConfig(const FlowState& state) const {
+    SimulationConfig cfg = base;
+    cfg.flowVelocity = state.direction.normalize() * state.velocity;
+    cfg.temperature = state.temperature;
+    for (auto& [_, sp] : cfg.species) sp.density = 0.0;
+    for (const auto& [name, density] : state.densities) cfg.species[name].density = density;
+    return cfg;
+}
+
+/**
+ * @brief Force, torque and C_D for a single flow state.
+ *
+ * Isolated panels use the closed-form Sentman force at their centroid;
+ * coupled panels (all panels for solver = raytrace) are traced with the
+ * compile-time surface model. With a seed ≥ 0 the result is reproducible
+ * for a fixed thread count. The error fields are the 1σ standard errors of
+ * the Monte Carlo part, estimated from the spread of the per-ray contributions
+ * (zero for purely analytic results).
+ *
+ * @param state Flow direction, speed, temperature and species densities.
+ * @return Result in memory; valid = false on error.
+ */
+DragResult DragSolver::compute(const FlowState& state) const {
+    DragResult result;
+    if (!isReady()) {
+        std::cerr << "❌ DragSolver: no mesh loaded\n";
+        return result;
+    }
+    for (const auto& [name, _] : state.densities) {
+        auto it = base.species.find(name);
+        if (it == base.species.end() || it->second.mass <= 0.0) {
+            std::cerr << "❌ DragSolver: species " << name << " has no mass in the base configuration\n";
+            return result;
+        }
+    }
+
+    const SimulationConfig cfg = makeConfig(state);
+    const Vector3 flowDir = cfg.flowVelocity.normalize();
+
+    double rho = 0.0;
+    for (const auto& [_, sp] : cfg.species) rho += sp.density * sp.mass;
+
+    Vector3 force = {0, 0, 0}, torque = {0, 0, 0};
+    double dragError = 0.0;
+
+    // --- Analytischer Anteil
+    if (hybrid) {
+        for (const auto& tri : *triangleTable) {
+            if (!panelMethod.isIsolated(tri.panelId)) continue;
+            Vector3 f = panelMethod.computePanelForce(cfg, tri.panelId);
+            force += f;
+            torque += (tri.centroid - referencePoint).cross(f);
+        }
+    }
+
+    // --- Monte Carlo für gekoppelte Panels
+    const int rayCount = (coupledPanels.empty() || rho <= 0.0) ? 0 : cfg.rayCount;
+    if (rayCount > 0) {
+        SimulationController sim;
+        sim.setVerbose(false);
+        sim.setIntersectionEngine(&engine);
+        sim.generateMixedRays(cfg, mesh.getTriangles(), vertices, 0.1, rayCount, rayCount,
+                              hybrid ? &coupledPanels : nullptr);
+        const std::vector<Ray>& rays = sim.getRays();
+        const int n = static_cast<int>(rays.size());
+
+        // Summen und Quadratsummen der Beiträge pro Strahl für den Standardfehler
+        Vector3 mcForce = {0, 0, 0}, mcTorque = {0, 0, 0};
+        Vector3 force2 = {0, 0, 0}, torque2 = {0, 0, 0};
+        double drag2 = 0.0, dragSum = 0.0;
+
+        dispatchSurfaceModel(modelType, [&](auto modelTag) {
+            constexpr SurfaceModelType Model = decltype(modelTag)::value;
+
+            #pragma omp parallel
+            {
+                const int tid = omp_get_thread_num();
+                if (cfg.seed >= 0)
+                    seedSurfaceRandom(static_cast<unsigned>(cfg.seed) + 7919u * (tid + 1));
+                Vector3 localForce = {0, 0, 0}, localTorque = {0, 0, 0};
+                Vector3 localForce2 = {0, 0, 0}, localTorque2 = {0, 0, 0};
+                double localDrag = 0.0, localDrag2 = 0.0;
+
+                #pragma omp for schedule(dynamic, 256) nowait
+                for (int i = 0; i < n; ++i) {
+                    Vector3 rayForce = {0, 0, 0}, rayTorque = {0, 0, 0};
+                    traceBounces<Model>(engine, model, cfg, rays[i], maxBouncesPerRay,
+                        [&](const Ray& in, const Ray& refl, const HitInfo& hit, int bounce) {
+                            if (hybrid && bounce == 0 && panelMethod.isIsolated(hit.panelId)) return false;
+
+                            // Kraft auf den Körper = −Impulsänderung des Gases
+                            Vector3 f = (in.momentum - refl.momentum) * in.weight;
+                            rayForce += f;
+                            rayTorque += (hit.point - referencePoint).cross(f);
+                            return true;
+                        });
+
+                    const double rayDrag = rayForce.dot(flowDir);
+                    localForce += rayForce;
+                    localTorque += rayTorque;
+                    localForce2 += Vector3{rayForce.x * rayForce.x, rayForce.y * rayForce.y, rayForce.z * rayForce.z};
+                    localTorque2 += Vector3{rayTorque.x * rayTorque.x, rayTorque.y * rayTorque.y, rayTorque.z * rayTorque.z};
+                    localDrag += rayDrag;
+                    localDrag2 += rayDrag * rayDrag;
+                }
+
+                #pragma omp critical
+                {
+                    mcForce += localForce;
+                    mcTorque += localTorque;
+                    force2 += localForce2;
+                    torque2 += localTorque2;
+                    dragSum += localDrag;
+                    drag2 += localDrag2;
+                }
+            }
+        });
+
+        // Summe über n unabhängige Strahlen: Var(Σx) = Σx² − (Σx)²/n
+        auto sumError = [n](double sum, double sumSq) {
+            return n > 0 ? std::sqrt(std::max(0.0, sumSq - sum * sum / n)) : 0.0;
+        };
+        result.forceError = {sumError(mcForce.x, force2.x), sumError(mcForce.y, force2.y), sumError(mcForce.z, force2.z)};
+        result.torqueError = {sumError(mcTorque.x, torque2.x), sumError(mcTorque.y, torque2.y),
+                              sumError(mcTorque.z, torque2.z)};
+        dragError = sumError(dragSum, drag2);
+        force += mcForce;
+        torque += mcTorque;
+        result.rays = n;
+    }
+
+    result.force = force;
+    result.torque = torque;
+    result.drag = force.dot(flowDir);
+    result.dynamicPressure = 0.5 * rho * state.velocity * state.velocity;
+    const double qA = result.dynamicPressure * referenceArea;
+    result.cd = qA > 0.0 ? result.drag / qA : 0.0;
+    result.cdError = qA > 0.0 ? dragError / qA : 0.0;
+    result.valid = true;
+    return result;
+}
+
+/**
+ * @brief Evaluates many flow states with one mesh setup.
+ *
+ * The states are distributed over the OpenMP threads; the ray loop inside
+ * each query then runs on a single thread (no nested parallelism).
+ *
+ * @param states Flow states, e.g. one per propagator step.
+ * @return One result per state, in the same order.
+ */
+std::vector<DragResult> DragSolver::computeBatch(const std::vector<FlowState>& states) const {
+    std::vector<DragResult> results(states.size());
+    const long n = static_cast<long>(states.size());
+
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (long i = 0; i < n; ++i)
+        results[i] = compute(states[i]);
+
+    return results;
+}
@@ -1,6 +1,7 @@
 #include "HeatmapExporter.h"
 #include <fstream>
 #include <iostream>
+#include <map>
 
 /// @brief Export a VTK file visualizing per-panel scalar values (e.g. temperature, force magnitude).
 /// @param filename Output filename (e.g. "heatmap.vtk").
@@ -10,7 +11,7 @@
 void HeatmapExporter::exportHeatmapAsVTK(const std::string& filename,
                                          const std::map<int, double>& values,
                                          const std::vector<Triangle>& tris,
-                                         const std::vector<Vector3>& vertices) const {
+                                         const std::vector<Vector3>& vertices) {
     std::ofstream file(filename);
     if (!file.is_open()) {
         std::cerr << "❌ Could not open VTK output file: " << filename << "\n";
@@ -49,6 +50,78 @@ void HeatmapExporter::exportHeatmapAsVTK(const std::string& filename,
     std::cout << "✅ Heatmap VTK file written: " << filename << "\n";
 }
 
+/// @brief Export per-panel surface loads as VTK cell data.
+///
+/// Fields: force on the body [N] (vector), heat_flux [W/m²], pressure [Pa],
+/// shear_stress [Pa] (vector and magnitude). Fluxes are divided by the
+/// triangle area computed from the geometry; panels without an entry are zero.
+///
+/// @param filename Output filename (e.g. "surfaceLoads.vtk").
+/// @param loads Accumulated panel loads keyed by panel ID (DragForceCalculator).
+/// @param tris Triangular surface geometry (each with a panelId).
+/// @param vertices Vertex coordinates.
+void HeatmapExporter::exportPanelLoadsAsVTK(const std::string& filename,
+                                            const std::map<int, PanelForce>& loads,
+                                            const std::vector<Triangle>& tris,
+                                            const std::vector<Vector3>& vertices) {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "❌ Could not open VTK output file: " << filename << "\n";
+        return;
+    }
+
+    file << "# vtk DataFile Version 3.0\n";
+    file << "Panel surface loads\n";
+    file << "ASCII\n";
+    file << "DATASET POLYDATA\n";
+
+    file << "POINTS " << vertices.size() << " float\n";
+    for (const auto& v : vertices) {
+        file << v.x << " " << v.y << " " << v.z << "\n";
+    }
+
+    file << "POLYGONS " << tris.size() << " " << tris.size() * 4 << "\n";
+    for (const auto& tri : tris) {
+        file << "3 " << tri.v1 << " " << tri.v2 << " " << tri.v3 << "\n";
+    }
+
+    // Lasten je Dreieck in Dateireihenfolge
+    const PanelForce none;
+    std::vector<const PanelForce*> cell(tris.size(), &none);
+    std::vector<double> area(tris.size());
+    for (size_t i = 0; i < tris.size(); ++i) {
+        auto it = loads.find(tris[i].panelId);
+        if (it != loads.end()) cell[i] = &it->second;
+        area[i] = tris[i].area(vertices);
+    }
+    auto perArea = [&](size_t i, double value) { return area[i] > 0.0 ? value / area[i] : 0.0; };
+
+    file << "CELL_DATA " << tris.size() << "\n";
+    file << "VECTORS force float\n";
+    for (size_t i = 0; i < tris.size(); ++i) {
+        Vector3 f = -cell[i]->force;   // Kraft auf den Körper
+        file << f.x << " " << f.y << " " << f.z << "\n";
+    }
+
+    file << "SCALARS heat_flux float 1\nLOOKUP_TABLE default\n";
+    for (size_t i = 0; i < tris.size(); ++i) file << perArea(i, cell[i]->heat) << "\n";
+
+    file << "SCALARS pressure float 1\nLOOKUP_TABLE default\n";
+    for (size_t i = 0; i < tris.size(); ++i) file << perArea(i, cell[i]->normalForce) << "\n";
+
+    file << "VECTORS shear float\n";
+    for (size_t i = 0; i < tris.size(); ++i) {
+        Vector3 t = cell[i]->shear * perArea(i, 1.0);
+        file << t.x << " " << t.y << " " << t.z << "\n";
+    }
+
+    file << "SCALARS shear_stress float 1\nLOOKUP_TABLE default\n";
+    for (size_t i = 0; i < tris.size(); ++i) file << perArea(i, cell[i]->shear.norm()) << "\n";
+
+    file.close();
+    std::cout << "✅ Surface load VTK file written: " << filename << "\n";
+}
+
 /// @brief Export rays as lines to a VTK file (e.g., for debugging or visualization).
 /// @param filename Output file name.
 /// @param raySegments Each ray segment is a pair of (start point, end point).
@@ -59,7 +132,7 @@ void HeatmapExporter::exportRaysAsVTK(const std::string& filename,
                                       const std::vector<std::pair<Vector3, Vector3>>& raySegments,
                                       const std::vector<Vector3>& vertices,
                                       const std::vector<Triangle>& tris,
-                                      double lineScale) const {
+                                      double lineScale) {
     std::ofstream file(filename);
     if (!file.is_open()) {
         std::cerr << "❌ Could not open VTK ray output file: " << filename << "\n";
@@ -0,0 +1,198 @@
+#include "InstancedMesh.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <numeric>
+#include <utility>
+
+namespace {
+    constexpr size_t minInstanceTriangles = 4;      // kleinere Teile bleiben im Rest-Prototyp
+    constexpr double congruenceTolerance = 1e-9;    // Eckpunktabstand relativ zur Diagonale des Teils
+    constexpr double identityTolerance = 1e-12;     // Rotation näher an I → reine Verschiebung
+
+    // Zeilen [begin, end) derselben Komponente mit fortlaufenden Panel-IDs
+    struct Part {
+        uint32_t begin, end;
+    };
+
+    // Prototyp-Kandidat: erstes Vorkommen, Referenzdreieck (größte Fläche) und Toleranz²
+    struct Candidate {
+        uint32_t part;
+        uint32_t reference;
+        double tolerance2;
+        std::vector<std::pair<uint32_t, RigidTransform>> occurrences;
+    };
+
+    // R bildet das Rechtssystem (Kante, Normale, Kante × Normale) von a auf das von b ab, t verschiebt a.p0 auf b.p0
+    RigidTransform alignTriangles(const TriangleAttributes& a, const TriangleAttributes& b) {
+        const Vector3 ea = a.edge1.normalize(), na = a.normal, ba = ea.cross(na);
+        const Vector3 eb = b.edge1.normalize(), nb = b.normal, bb = eb.cross(nb);
+        RigidTransform T;
+        T.row0 = ea * eb.x + na * nb.x + ba * bb.x;
+        T.row1 = ea * eb.y + na * nb.y + ba * bb.y;
+        T.row2 = ea * eb.z + na * nb.z + ba * bb.z;
+
+        const RigidTransform identity;
+        const double deviation = std::max({(T.row0 - identity.row0).norm(), (T.row1 - identity.row1).norm(),
+                                           (T.row2 - identity.row2).norm()});
+        if (deviation <= identityTolerance) T = identity;
+        T.translation = b.p0 - T.rotate(a.p0);
+        return T;
+    }
+
+    bool congruent(const TriangleTable& table, const Part& proto, const Part& part, const RigidTransform& T,
+                   double tolerance2) {
+        for (uint32_t i = 0; i < proto.end - proto.begin; ++i) {
+            const TriangleAttributes& a = table[proto.begin + i];
+            const TriangleAttributes& b = table[part.begin + i];
+            if (a.materialId != b.materialId) return false;
+            if ((T.apply(a.p0) - b.p0).squaredNorm() > tolerance2) return false;
+            if ((T.apply(a.p1) - b.p1).squaredNorm() > tolerance2) return false;
+            if ((T.apply(a.p2) - b.p2).squaredNorm() > tolerance2) return false;
+        }
+        return true;
+    }
+}
+
+/**
+ * @brief Wraps a whole table as one prototype per sub-body, each placed once at identity.
+ */
+InstancedMesh::InstancedMesh(std::shared_ptr<const TriangleTable> triangleTable)
+    : table(std::move(triangleTable)) {
+    std::map<int, uint32_t> prototypeOf;   // Teilkörper → Prototyp
+    for (uint32_t i = 0; i < table->size(); ++i) {
+        auto [it, inserted] = prototypeOf.try_emplace((*table)[i].bodyId, static_cast<uint32_t>(prototypes.size()));
+        if (inserted) {
+            prototypes.emplace_back();
+            instances.push_back(MeshInstance{it->second, RigidTransform{}, 0, it->first});
+        }
+        prototypes[it->second].push_back(i);
+    }
+}
+
+/**
+ * @brief Assembles prototypes and instances explicitly.
+ *
+ * @param protos Table rows per prototype, in the prototype's own coordinates.
+ * @param placements Placements; panel IDs of a hit are row panel ID + panelOffset.
+ */
+InstancedMesh::InstancedMesh(std::shared_ptr<const TriangleTable> triangleTable,
+                             std::vector<std::vector<uint32_t>> protos, std::vector<MeshInstance> placements)
+    : table(std::move(triangleTable)), prototypes(std::move(protos)), instances(std::move(placements)) {}
+
+/**
+ * @brief Detects repeated sub-meshes and shares their geometry.
+ *
+ * The table is cut into parts: runs of rows of one connected component and
+ * one sub-body with consecutive panel IDs. Parts with the same triangle count and total area
+ * are compared by aligning their largest triangle (rigid transform, no
+ * mirroring) and checking every corner in row order within a tolerance of
+ * 1e-9 of the part's diagonal, plus equal materials. Matches become
+ * instances of the first occurrence; panel IDs stay those of the flat table,
+ * so panel results are unchanged. Everything that is not repeated forms one
+ * more prototype per sub-body, placed at identity.
+ *
+ * @param triangleTable Oriented triangle table of the loaded mesh.
+ * @param componentOf Connected component per row.
+ * @return Instanced view (a single identity instance if nothing repeats).
+ */
+std::shared_ptr<const InstancedMesh> InstancedMesh::detect(std::shared_ptr<const TriangleTable> triangleTable,
+                                                           const std::vector<int>& componentOf) {
+    const TriangleTable& t = *triangleTable;
+    const uint32_t n = static_cast<uint32_t>(t.size());
+    if (componentOf.size() != t.size()) return std::make_shared<const InstancedMesh>(std::move(triangleTable));
+
+    std::vector<Part> parts;
+    for (uint32_t i = 0; i < n; ++i) {
+        if (i == 0 || componentOf[i] != componentOf[i - 1] || t[i].bodyId != t[i - 1].bodyId ||
+            t[i].panelId != t[i - 1].panelId + 1)
+            parts.push_back({i, i});
+        parts.back().end = i + 1;
+    }
+
+    // Gruppierung nach (Dreiecksanzahl, Gesamtfläche); nur Kandidaten eines Schlüssels werden verglichen
+    std::vector<Candidate> candidates;
+    std::map<std::pair<uint32_t, long long>, std::vector<uint32_t>> byKey;
+    for (uint32_t p = 0; p < parts.size(); ++p) {
+        const Part& part = parts[p];
+        const uint32_t size = part.end - part.begin;
+        if (size < minInstanceTriangles) continue;
+
+        double area = 0.0, largest = -1.0;
+        uint32_t reference = 0;
+        for (uint32_t i = part.begin; i < part.end; ++i) {
+            area += t[i].area;
+            if (t[i].area > largest) {
+                largest = t[i].area;
+                reference = i - part.begin;
+            }
+        }
+        if (!(area > 0.0)) continue;
+
+        auto& bucket = byKey[{size, std::llround(std::log(area) * 1e6)}];
+        bool matched = false;
+        for (uint32_t c : bucket) {
+            Candidate& cand = candidates[c];
+            const Part& proto = parts[cand.part];
+            const RigidTransform T = alignTriangles(t[proto.begin + cand.reference], t[part.begin + cand.reference]);
+            if (congruent(t, proto, part, T, cand.tolerance2)) {
+                cand.occurrences.emplace_back(p, T);
+                matched = true;
+                break;
+            }
+        }
+        if (matched) continue;
+
+        Vector3 lo = t[part.begin].p0, hi = lo;
+        for (uint32_t i = part.begin; i < part.end; ++i) {
+            for (const Vector3* q : {&t[i].p0, &t[i].p1, &t[i].p2}) {
+                lo = Vector3::min(lo, *q);
+                hi = Vector3::max(hi, *q);
+            }
+        }
+        const double tolerance = congruenceTolerance * (hi - lo).norm();
+        bucket.push_back(static_cast<uint32_t>(candidates.size()));
+        candidates.push_back({p, reference, tolerance * tolerance, {{p, RigidTransform{}}}});
+    }
+
+    std::vector<char> shared(parts.size(), 0);
+    for (const Candidate& cand : candidates)
+        if (cand.occurrences.size() > 1)
+            for (const auto& occurrence : cand.occurrences) shared[occurrence.first] = 1;
+    if (std::find(shared.begin(), shared.end(), 1) == shared.end())
+        return std::make_shared<const InstancedMesh>(std::move(triangleTable));
+
+    std::vector<std::vector<uint32_t>> protos;
+    std::vector<MeshInstance> placements;
+
+    std::map<int, std::vector<uint32_t>> rest;   // nicht wiederholte Zeilen je Teilkörper
+    for (uint32_t p = 0; p < parts.size(); ++p)
+        if (!shared[p])
+            for (uint32_t i = parts[p].begin; i < parts[p].end; ++i) rest[t[i].bodyId].push_back(i);
+    for (auto& [body, rows] : rest) {
+        placements.push_back(MeshInstance{static_cast<uint32_t>(protos.size()), RigidTransform{}, 0, body});
+        protos.push_back(std::move(rows));
+    }
+
+    for (const Candidate& cand : candidates) {
+        if (cand.occurrences.size() < 2) continue;
+        const Part& proto = parts[cand.part];
+        const uint32_t index = static_cast<uint32_t>(protos.size());
+        protos.emplace_back(proto.end - proto.begin);
+        std::iota(protos.back().begin(), protos.back().end(), proto.begin);
+        for (const auto& [p, T] : cand.occurrences) {
+            placements.push_back({index, T, t[parts[p].begin].panelId - t[proto.begin].panelId,
+                                  t[parts[p].begin].bodyId});
+        }
+    }
+    return std::make_shared<const InstancedMesh>(std::move(triangleTable), std::move(protos), std::move(placements));
+}
+
+/**
+ * @brief Number of triangles stored in prototypes (each repeated part counted once).
+ */
+size_t InstancedMesh::uniqueTriangleCount() const {
+    size_t count = 0;
+    for (const auto& rows : prototypes) count += rows.size();
+    return count;
+}
@@ -3,95 +3,359 @@
 #include <iostream>
 #include <limits>
 #include <cmath>
+#include <string>
+#include <algorithm>
+#include <utility>
+
+TracePrecision parseTracePrecision(const std::string& name) {
+    return name == "float" ? TracePrecision::Float : TracePrecision::Double;
+}
+
+namespace {
+    constexpr uint32_t floatBlock = 64;   // Dreiecke pro SIMD-Block im Float-Pfad (große Blätter)
+    constexpr float boxPadding = 2.0f * std::numeric_limits<float>::epsilon();   // Float-Ecken liegen in der Box
+
+    // Startpanel des Strahls in Prototyp-IDs; Strahlen ohne Panel (−1) schließen nichts aus
+    int excludedPanel(const Ray& ray, int panelOffset) {
+        return ray.panelId >= 0 ? ray.panelId - panelOffset : std::numeric_limits<int>::min();
+    }
+
+    Aabb triangleBounds(const TriangleAttributes& tri) {
+        Aabb box;
+        box.grow(tri.p0);
+        box.grow(tri.p1);
+        box.grow(tri.p2);
+        const Vector3 pad = Vector3::max(Vector3(std::abs(box.lo.x), std::abs(box.lo.y), std::abs(box.lo.z)),
+                                         Vector3(std::abs(box.hi.x), std::abs(box.hi.y), std::abs(box.hi.z))) * boxPadding;
+        box.lo = box.lo - pad;
+        box.hi = box.hi + pad;
+        return box;
+    }
+
+    // Weltbox einer Instanz: die acht transformierten Ecken der Prototypbox, gegen Rundung leicht vergrößert
+    Aabb instanceBounds(const Aabb& local, const RigidTransform& T) {
+        Aabb box;
+        for (int c = 0; c < 8; ++c) {
+            box.grow(T.apply(Vector3(c & 1 ? local.hi.x : local.lo.x, c & 2 ? local.hi.y : local.lo.y,
+                                     c & 4 ? local.hi.z : local.lo.z)));
+        }
+        const double pad = 1e-12 * (box.hi - box.lo).norm() +
+                           1e-15 * std::max(box.lo.norm(), box.hi.norm());
+        box.lo = box.lo - Vector3(pad, pad, pad);
+        box.hi = box.hi + Vector3(pad, pad, pad);
+        return box;
+    }
+
+    bool sameTransform(const RigidTransform& a, const RigidTransform& b) {
+        auto same = [](const Vector3& u, const Vector3& v) { return u.x == v.x && u.y == v.y && u.z == v.z; };
+        return same(a.row0, b.row0) && same(a.row1, b.row1) && same(a.row2, b.row2) &&
+               same(a.translation, b.translation);
+    }
+
+    // Achsenpermutation und Scherung eines Strahls für den wasserdichten Test
+    template <typename T>
+    struct ShearedRay {
+        int kx, ky, kz;
+        T sx, sy, sz;
+        T ox, oy, oz;
+
+        ShearedRay(const Vector3& origin, const Vector3& direction) {
+            const double adx = std::abs(direction.x), ady = std::abs(direction.y), adz = std::abs(direction.z);
+            kz = (adx > ady) ? (adx > adz ? 0 : 2) : (ady > adz ? 1 : 2);
+            kx = (kz + 1) % 3;
+            ky = (kx + 1) % 3;
+            if (direction[kz] < 0.0) std::swap(kx, ky);   // Umlaufsinn erhalten
+            const T dz = static_cast<T>(direction[kz]);
+            sx = static_cast<T>(direction[kx]) / dz;
+            sy = static_cast<T>(direction[ky]) / dz;
+            sz = T(1) / dz;
+            ox = static_cast<T>(origin[kx]);
+            oy = static_cast<T>(origin[ky]);
+            oz = static_cast<T>(origin[kz]);
+        }
+    };
+
+    /**
+     * Watertight ray/triangle test in double precision (scalar form of the
+     * float kernel in intersectPrototype).
+     *
+     * @param t Output parametric distance, only set on a hit with t > 0.
+     */
+    bool intersectsWatertight(const ShearedRay<double>& r, const Vector3& v0, const Vector3& v1,
+                              const Vector3& v2, double& t) {
+        const double Az = v0[r.kz] - r.oz, Bz = v1[r.kz] - r.oz, Cz = v2[r.kz] - r.oz;
+        const double Ax = v0[r.kx] - r.ox - r.sx * Az, Ay = v0[r.ky] - r.oy - r.sy * Az;
+        const double Bx = v1[r.kx] - r.ox - r.sx * Bz, By = v1[r.ky] - r.oy - r.sy * Bz;
+        const double Cx = v2[r.kx] - r.ox - r.sx * Cz, Cy = v2[r.ky] - r.oy - r.sy * Cz;
+
+        const double u = Cx * By - Cy * Bx;
+        const double v = Ax * Cy - Ay * Cx;
+        const double w = Bx * Ay - By * Ax;
+        if ((u < 0.0 || v < 0.0 || w < 0.0) && (u > 0.0 || v > 0.0 || w > 0.0)) return false;
+
+        const double det = u + v + w;
+        if (det == 0.0) return false;   // Strahl in der Dreiecksebene oder entartetes Dreieck
+
+        const double T = (u * Az + v * Bz + w * Cz) * r.sz;
+        if (det < 0.0 ? T >= 0.0 : T <= 0.0) return false;   // hinter dem Ursprung
+        t = T / det;
+        return true;
+    }
+}
+
+/**
+ * @brief Assigns the instanced mesh and builds both acceleration levels.
+ * 
+ * Every prototype gets a bottom-level BVH over its table rows (built in
+ * parallel over prototypes), so the build cost and memory follow the unique
+ * geometry (with setLinearScan(true), one leaf holding all rows instead).
+ * The top level is a BVH over the world boxes of the instances; all
+ * sub-bodies start in their loaded position.
+ * The float path additionally keeps single-precision copies of the corners
+ * in leaf order.
+ * 
+ * @param instancedMesh Prototypes and instances over the shared triangle table.
+ */
+void IntersectionEngine::setMesh(std::shared_ptr<const InstancedMesh> instancedMesh) {
+    mesh = std::move(instancedMesh);
+    const TriangleTable& triangles = mesh->getTriangleTable();
+    const auto& prototypes = mesh->getPrototypes();
+    const auto& instances = mesh->getInstances();
+
+    bottom.assign(prototypes.size(), BottomLevel{});
+    const long prototypeCount = static_cast<long>(prototypes.size());
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (long p = 0; p < prototypeCount; ++p) {
+        const std::vector<uint32_t>& rows = prototypes[p];
+        BottomLevel& level = bottom[p];
+
+        if (linearScan) {
+            Aabb bounds;
+            for (uint32_t row : rows) bounds.grow(triangleBounds(triangles[row]));
+            level.bvh.buildSingleLeaf(bounds, static_cast<uint32_t>(rows.size()));
+        } else {
+            std::vector<Aabb> boxes(rows.size());
+            for (size_t i = 0; i < rows.size(); ++i) boxes[i] = triangleBounds(triangles[rows[i]]);
+            level.bvh.build(boxes);
+        }
+
+        const std::vector<uint32_t>& order = level.bvh.primitiveOrder();
+        level.rows.resize(rows.size());
+        for (size_t k = 0; k < rows.size(); ++k) level.rows[k] = rows[order[k]];
+
+        if (precision != TracePrecision::Float) continue;
+        for (auto& c : level.cornersF) c.resize(rows.size());
+        for (size_t k = 0; k < rows.size(); ++k) {
+            const TriangleAttributes& tri = triangles[level.rows[k]];
+            const Vector3* corners[3] = {&tri.p0, &tri.p1, &tri.p2};
+            for (int c = 0; c < 3; ++c)
+                for (int a = 0; a < 3; ++a)
+                    level.cornersF[3 * c + a][k] = static_cast<float>((*corners[c])[a]);
+        }
+    }
+
+    bodyPose.clear();
+    placement.resize(instances.size());
+    identity.assign(instances.size(), 0);
+    instanceBoxes.resize(instances.size());
+    for (size_t i = 0; i < instances.size(); ++i) placeInstance(i, RigidTransform{});
+    top.build(instanceBoxes);
+}
+
+/**
+ * @brief World transform, identity flag and world box of one instance.
+ */
+void IntersectionEngine::placeInstance(size_t i, const RigidTransform& body) {
+    const MeshInstance& instance = mesh->getInstances()[i];
+    const BottomLevel& level = bottom[instance.prototype];
+    placement[i] = body.isIdentity() ? instance.transform : body * instance.transform;
+    identity[i] = placement[i].isIdentity() ? 1 : 0;
+    if (level.bvh.empty()) instanceBoxes[i] = Aabb{Vector3(), Vector3()};   // leerer Prototyp, nie getroffen
+    else instanceBoxes[i] = identity[i] ? level.bvh.bounds() : instanceBounds(level.bvh.bounds(), placement[i]);
+}
 
 /**
- * @brief Assigns the triangle mesh used for ray intersections.
+ * @brief Moves rigid sub-bodies without touching their triangle hierarchies.
+ *
+ * Only instances of bodies whose transform changed since the last call get
+ * a new placement and world box; the bottom-level BVHs stay as built, and
+ * the top level is rebuilt over the instance boxes (one box per instance,
+ * so this costs microseconds even for large meshes). Transforms are relative
+ * to the loaded geometry, not cumulative.
+ *
+ * @param bodyTransforms Transform per body ID; missing entries mean the loaded position.
+ */
+void IntersectionEngine::setBodyTransforms(const std::vector<RigidTransform>& bodyTransforms) {
+    const auto& instances = mesh->getInstances();
+    const RigidTransform unmoved;
+    auto poseOf = [&](const std::vector<RigidTransform>& poses, int body) -> const RigidTransform& {
+        return body >= 0 && static_cast<size_t>(body) < poses.size() ? poses[body] : unmoved;
+    };
+
+    bool changed = false;
+    for (size_t i = 0; i < instances.size(); ++i) {
+        const RigidTransform& next = poseOf(bodyTransforms, instances[i].body);
+        if (sameTransform(next, poseOf(bodyPose, instances[i].body))) continue;
+        placeInstance(i, next);
+        changed = true;
+    }
+    bodyPose = bodyTransforms;
+    if (changed) top.build(instanceBoxes);
+}
+
+/**
+ * @brief Assigns a flat triangle table (one prototype, placed once).
  * 
- * This function stores the vertex and triangle data for the mesh
- * against which incoming rays will be tested.
+ * @param triangleTable Precomputed triangle attributes of the mesh.
+ */
+void IntersectionEngine::setMesh(std::shared_ptr<const TriangleTable> triangleTable) {
+    setMesh(std::make_shared<const InstancedMesh>(std::move(triangleTable)));
+}
+
+/**
+ * @brief Builds a triangle table from raw mesh data and assigns it.
  * 
  * @param verts A list of 3D vertex positions.
  * @param tris A list of triangles, defined by indices into the vertex list.
  */
 void IntersectionEngine::setMesh(const std::vector<Vector3>& verts, const std::vector<Triangle>& tris) {
-    vertices = verts;
-    triangles = tris;
+    setMesh(TriangleTable::build(verts, tris));
 }
 
 /**
  * @brief Computes the nearest intersection between a ray and the loaded mesh.
  * 
- * Iterates through all triangles and returns the closest intersection point, if any.
+ * Traverses the instance BVH; for every instance box hit, the ray is moved
+ * into the prototype's coordinates (skipped for identity placements) and
+ * the prototype's BVH is traversed with the same nearest distance, which a
+ * rigid transform leaves unchanged. Equal distances resolve to the smaller
+ * panel ID, as in a linear scan over the panels.
+ * Both precisions use a watertight test, so rays cannot slip through edges
+ * shared by two triangles. The panel a ray starts on (Ray::panelId ≥ 0) is
+ * excluded: a flat panel cannot be hit again by a ray leaving it, so no
+ * minimum distance is needed against self-intersection.
  * 
  * @param ray The ray to trace.
+ * @param stats Optional traversal counters (triangle and box tests).
  * @return Optional HitInfo object containing the hit point, normal, and metadata.
  */
-std::optional<HitInfo> IntersectionEngine::intersect(const Ray& ray) const {
-    std::optional<HitInfo> closestHit;
-    double closestT = std::numeric_limits<double>::infinity();  // Start with max distance
-    const double epsilon = 1e-12;  // Ignore very close hits (e.g., self-intersection)
-
-    for (const auto& tri : triangles) {
-        const Vector3& v0 = vertices[tri.v1];
-        const Vector3& v1 = vertices[tri.v2];
-        const Vector3& v2 = vertices[tri.v3];
-
-        double t;
-        if (!intersects(ray, v0, v1, v2, t)) continue;  // No intersection with this triangle
-        if (t < epsilon || t >= closestT) continue;    // Not closer than current closest
-
-        // Compute exact intersection point and normal
-        Vector3 intersection = ray.origin + ray.direction * t;
-        Vector3 normal = (v1 - v0).cross(v2 - v0).normalize();
-
-        // Flip normal if pointing in the same direction as the ray (backface culling)
-        if (normal.dot(ray.direction) > 0) normal = normal * -1.0;
-
-        closestT = t;
-        closestHit = HitInfo{
-            .point    = intersection,
-            .normal   = normal,
-            .panelId  = tri.panelId,
-            .nextRay  = {},         // To be filled later
-            .t        = t
-        };
-    }
+std::optional<HitInfo> IntersectionEngine::intersect(const Ray& ray, TraversalStats* stats) const {
+    const auto& instances = mesh->getInstances();
+    const std::vector<uint32_t>& order = top.primitiveOrder();
+    Nearest nearest;
 
-    return closestHit;
+    top.traverse(ray.origin, ray.direction, nearest.t, [&](uint32_t first, uint32_t count) {
+        for (uint32_t k = first; k < first + count; ++k) {
+            const uint32_t i = order[k];
+            const MeshInstance& instance = instances[i];
+            const int skipPanel = excludedPanel(ray, instance.panelOffset);
+            if (identity[i]) {
+                intersectPrototype(i, ray.origin, ray.direction, skipPanel, nearest, stats);
+            } else {
+                intersectPrototype(i, placement[i].applyInverse(ray.origin),
+                                   placement[i].rotateInverse(ray.direction), skipPanel, nearest, stats);
+            }
+        }
+    }, stats);
+    if (!nearest.row) return std::nullopt;
+
+    Vector3 normal = identity[nearest.instance] ? nearest.row->normal : placement[nearest.instance].rotate(nearest.row->normal);
+    // Flip normal if pointing in the same direction as the ray (backface culling)
+    if (normal.dot(ray.direction) > 0) normal = -normal;
+
+    return HitInfo{
+        .point    = ray.origin + ray.direction * nearest.t,
+        .normal   = normal,
+        .panelId  = nearest.panelId,
+        .nextRay  = {},         // To be filled later
+        .t        = nearest.t,
+        .materialId = nearest.row->materialId
+    };
 }
 
 /**
- * @brief Ray-triangle intersection test using the Möller–Trumbore algorithm.
- * 
- * Tests whether a given ray intersects with a triangle defined by three vertices.
- * 
- * @param ray The ray to test.
- * @param v0 First vertex of the triangle.
- * @param v1 Second vertex of the triangle.
- * @param v2 Third vertex of the triangle.
- * @param t Output distance to intersection point along the ray.
- * @return true if the ray intersects the triangle, false otherwise.
+ * @brief Nearest hit within one instance, in prototype coordinates.
+ *
+ * Double: watertight test against the table rows of each leaf.
+ *
+ * Float: watertight ray/triangle test after Woop, Benthin and Wald (2013) on
+ * single-precision corners: the triangle is translated to the ray origin
+ * and sheared so the ray runs along +z; the 2D edge functions U, V, W then
+ * decide the hit. A shared edge gives exactly negated edge functions in both
+ * triangles (same sheared corners), so no ray slips between them, and there
+ * is no parallel-ray epsilon. The test runs branch-free over the triangles
+ * of a leaf (SIMD over the float corner arrays in leaf order); the hit point
+ * is evaluated in double from the ray origin, so forces and moments keep
+ * double precision.
  */
-bool IntersectionEngine::intersects(const Ray& ray, const Vector3& v0, const Vector3& v1, const Vector3& v2, double& t) const {
-    const double EPSILON = 1e-8;
+void IntersectionEngine::intersectPrototype(uint32_t instance, const Vector3& origin, const Vector3& direction,
+                                            int skipPanel, Nearest& nearest, TraversalStats* stats) const {
+    const TriangleTable& triangles = mesh->getTriangleTable();
+    const int panelOffset = mesh->getInstances()[instance].panelOffset;
+    const BottomLevel& level = bottom[mesh->getInstances()[instance].prototype];
 
-    Vector3 edge1 = v1 - v0;
-    Vector3 edge2 = v2 - v0;
-    Vector3 h = ray.direction.cross(edge2);
-    double a = edge1.dot(h);
+    auto consider = [&](uint32_t k, double t) {
+        const TriangleAttributes& tri = triangles[level.rows[k]];
+        if (tri.panelId == skipPanel) return;   // Startpanel
+        const int panelId = tri.panelId + panelOffset;
+        if (t < nearest.t || (t == nearest.t && panelId < nearest.panelId)) {
+            nearest = {t, panelId, &tri, instance};
+        }
+    };
 
-    if (std::abs(a) < EPSILON) return false;  // Ray is parallel to triangle
+    if (precision == TracePrecision::Float) {
+        const ShearedRay<float> r(origin, direction);
+        const int kx = r.kx, ky = r.ky, kz = r.kz;
+        const float sx = r.sx, sy = r.sy, sz = r.sz;
+        const float ox = r.ox, oy = r.oy, oz = r.oz;
+        const auto& c = level.cornersF;
+        const float* ax = c[kx].data();     const float* ay = c[ky].data();     const float* az = c[kz].data();
+        const float* bx = c[3 + kx].data(); const float* by = c[3 + ky].data(); const float* bz = c[3 + kz].data();
+        const float* cx = c[6 + kx].data(); const float* cy = c[6 + ky].data(); const float* cz = c[6 + kz].data();
+        const float inf = std::numeric_limits<float>::infinity();
 
-    double f = 1.0 / a;
-    Vector3 s = ray.origin - v0;
-    double u = f * s.dot(h);
-    if (u < 0.0 || u > 1.0) return false;
+        level.bvh.traverse(origin, direction, nearest.t, [&](uint32_t first, uint32_t count) {
+            if (stats) stats->primitiveTests += count;
+            float tBlock[floatBlock];
 
-    Vector3 q = s.cross(edge1);
-    double v = f * ray.direction.dot(q);
-    if (v < 0.0 || u + v > 1.0) return false;
+            for (uint32_t base = first; base < first + count; base += floatBlock) {
+                const uint32_t blockCount = std::min<uint32_t>(floatBlock, first + count - base);
 
-    t = f * edge2.dot(q);  // Distance along ray
-    return t > EPSILON;
-}
+                #pragma omp simd
+                for (uint32_t j = 0; j < blockCount; ++j) {
+                    const uint32_t i = base + j;
+                    const float Az = az[i] - oz, Bz = bz[i] - oz, Cz = cz[i] - oz;
+                    const float Ax = ax[i] - ox - sx * Az, Ay = ay[i] - oy - sy * Az;
+                    const float Bx = bx[i] - ox - sx * Bz, By = by[i] - oy - sy * Bz;
+                    const float Cx = cx[i] - ox - sx * Cz, Cy = cy[i] - oy - sy * Cz;
+
+                    const float u = Cx * By - Cy * Bx;
+                    const float v = Ax * Cy - Ay * Cx;
+                    const float w = Bx * Ay - By * Ax;
+                    // Innen: alle Kantenfunktionen mit gleichem Vorzeichen (bitweise verknüpft, ohne Sprünge)
+                    const float lo = std::min(u, std::min(v, w)), hi = std::max(u, std::max(v, w));
+                    const bool inside = (lo >= 0.0f) | (hi <= 0.0f);
+
+                    // t > 0 verwirft Treffer hinter dem Ursprung; det = 0 ergibt inf/NaN und fällt ebenfalls heraus
+                    const float t = (u * Az + v * Bz + w * Cz) * sz / (u + v + w);
+                    tBlock[j] = (inside & (t > 0.0f)) ? t : inf;
+                }
 
+                for (uint32_t j = 0; j < blockCount; ++j) {
+                    if (tBlock[j] != inf) consider(base + j, static_cast<double>(tBlock[j]));
+                }
+            }
+        }, stats);
+        return;
+    }
+
+    const ShearedRay<double> sheared(origin, direction);
+    level.bvh.traverse(origin, direction, nearest.t, [&](uint32_t first, uint32_t count) {
+        if (stats) stats->primitiveTests += count;
+        for (uint32_t k = first; k < first + count; ++k) {
+            const TriangleAttributes& tri = triangles[level.rows[k]];
+            double t;
+            if (intersectsWatertight(sheared, tri.p0, tri.p1, tri.p2, t)) consider(k, t);
+        }
+    }, stats);
+}
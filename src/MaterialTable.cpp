@@ -0,0 +1,64 @@
+#include "MaterialTable.h"
+#include "CLLTable.h"
+#include "SurfaceInteractionModel.h"
+#include <iostream>
+
+/**
+ * @brief Material with the global surface parameters of the configuration.
+ */
+SurfaceMaterial SurfaceMaterial::fromConfig(const SimulationConfig& cfg) {
+    SurfaceMaterial m;
+    m.energyAccommodation = cfg.energyAccommodation;
+    m.wallTemperature = cfg.WallTemp;
+    m.specularFraction = cfg.specularFraction;
+    m.reflectionRatio = cfg.reflectionRatio;
+    m.energyLoss = cfg.energyLoss;
+    m.normalAccommodation = cfg.normalAccommodation;
+    m.tangentialAccommodation = cfg.tangentialAccommodation;
+    if (parseSurfaceModel(cfg.model) == SurfaceModelType::CLL) {
+        m.cllTable = &CLLTable::cached(m.normalAccommodation, m.tangentialAccommodation, m.wallTemperature);
+    }
+    return m;
+}
+
+/**
+ * @brief Builds the material table for a mesh.
+ *
+ * @param cfg Configuration with global values and optional [material:<name>] sections.
+ * @param meshMaterialNames Material names indexed by Triangle::materialId
+ *                          (index 0 is the default material and may be empty).
+ */
+void MaterialTable::build(const SimulationConfig& cfg, const std::vector<std::string>& meshMaterialNames) {
+    materials.clear();
+    names = meshMaterialNames;
+    if (names.empty()) names.push_back("");
+
+    const bool cll = parseSurfaceModel(cfg.model) == SurfaceModelType::CLL;
+    const SurfaceMaterial defaults = SurfaceMaterial::fromConfig(cfg);
+
+    for (const auto& name : names) {
+        SurfaceMaterial m = defaults;
+
+        auto it = cfg.materials.find(name);
+        if (it != cfg.materials.end()) {
+            const MaterialInfo& info = it->second;
+            if (info.energyAccommodation) m.energyAccommodation = *info.energyAccommodation;
+            if (info.wallTemperature) m.wallTemperature = *info.wallTemperature;
+            if (info.specularFraction) m.specularFraction = *info.specularFraction;
+            if (info.reflectionRatio) m.reflectionRatio = *info.reflectionRatio;
+            if (info.energyLoss) m.energyLoss = *info.energyLoss;
+            if (info.normalAccommodation) m.normalAccommodation = *info.normalAccommodation;
+            if (info.tangentialAccommodation) m.tangentialAccommodation = *info.tangentialAccommodation;
+        } else if (!name.empty()) {
+            std::cerr << "⚠️  No [material:" << name << "] section, using global surface values.\n";
+        }
+
+        // CLL-Tabelle neu auflösen, falls das Material die Parameter überschreibt
+        if (cll && (m.normalAccommodation != defaults.normalAccommodation ||
+                    m.tangentialAccommodation != defaults.tangentialAccommodation ||
+                    m.wallTemperature != defaults.wallTemperature)) {
+            m.cllTable = &CLLTable::cached(m.normalAccommodation, m.tangentialAccommodation, m.wallTemperature);
+        }
+        materials.push_back(m);
+    }
+}
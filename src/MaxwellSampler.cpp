@@ -14,9 +14,10 @@ constexpr double kB = 1.380649e-23;
  * @param temperature Temperature in Kelvin.
  * @param mass Particle mass in kilograms.
  * @param drift Drift velocity vector (bulk flow).
+ * @param seed Fixed RNG seed for reproducible runs; negative values seed from std::random_device.
  */
-MaxwellSampler::MaxwellSampler(double temperature, double mass, Vector3 drift)
-    : rng(std::random_device{}()),
+MaxwellSampler::MaxwellSampler(double temperature, double mass, Vector3 drift, long long seed)
+    : rng(seed >= 0 ? static_cast<std::mt19937::result_type>(seed) : std::random_device{}()),
       normal(0.0, std::sqrt(kB * temperature / mass)),  // Normal distribution for speed
       uniDist(0.0, 1.0),                                // Uniform distribution for angles
       mass(mass),
@@ -1,5 +1,6 @@
 #include "MeshLoader.h"
-#include "tiny_obj_loader.h"
+#include "ObjReader.h"
+#include "MeshOrientation.h"
 #include <iostream>
 #include <fstream>
 #include <algorithm>
@@ -11,7 +12,7 @@
  * @brief Load a mesh from a file.
  * 
  * This function delegates the loading based on file extension.
- * Currently supports only `.obj` files via TinyOBJLoader.
+ * Currently supports only `.obj` files via ObjReader.
  * 
  * @param filename Path to the mesh file.
  * @return true if loading succeeds, false otherwise.
@@ -47,74 +48,58 @@ std::pair<Vector3, Vector3> MeshLoader::getBoundingBox() const {
 /**
  * @brief Load geometry from a Wavefront OBJ file.
  * 
- * Uses TinyOBJLoader to parse the file and build a list of vertices and triangles.
- * Also applies normal correction to ensure outward-facing triangles.
+ * Uses the parallel ObjReader, which memory-maps the file and parses
+ * vertices and faces directly into the mesh arrays (polygons are
+ * triangulated). Faces inherit the material of their `usemtl` group
+ * (materials from the mtllib); faces without a material get the default
+ * material 0. Faces after an `o` or `g` statement belong to the named rigid
+ * sub-body; vertices used by several bodies are duplicated so every body
+ * can be moved on its own. The winding is then made consistent and outward per
+ * connected component (MeshOrientation), which also reports open and
+ * non-manifold edges, and the shared triangle attribute table is built
+ * from the corrected winding. Connected parts that repeat up to a rigid
+ * transform are recorded as instances of one prototype (InstancedMesh).
  * 
  * @param filename Path to .obj file
  * @return true on successful load, false otherwise.
  */
 bool MeshLoader::loadFromOBJ(const std::string& filename) {
-    tinyobj::attrib_t attrib;
-    std::vector<tinyobj::shape_t> shapes;
-    std::vector<tinyobj::material_t> materials;
-    std::string warn, err;
-
-    bool ret = tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err, filename.c_str());
-    if (!warn.empty()) std::cerr << "[TinyOBJ Warning] " << warn << std::endl;
-    if (!err.empty()) std::cerr << "[TinyOBJ Error] " << err << std::endl;
-    if (!ret) return false;
-
-    // Load vertices
-    vertices.clear();
-    for (size_t i = 0; i < attrib.vertices.size(); i += 3) {
-        vertices.emplace_back(Vector3{
-            attrib.vertices[i + 0],
-            attrib.vertices[i + 1],
-            attrib.vertices[i + 2]
-        });
+    if (!ObjReader::read(filename, vertices, triangles, materialNames, bodyNames)) {
+        vertexBody.clear();
+        triangleTable = std::make_shared<const TriangleTable>();
+        instancedMesh = std::make_shared<const InstancedMesh>();
+        topology = MeshTopologyReport{};
+        return false;
     }
 
-    // Load triangles (faces with 3 vertices)
-    triangles.clear();
-    int panelId = 0;
-    for (const auto& shape : shapes) {
-        size_t index_offset = 0;
-        for (size_t f = 0; f < shape.mesh.num_face_vertices.size(); ++f) {
-            size_t fv = shape.mesh.num_face_vertices[f];
-            if (fv == 3) {
-                int v0 = shape.mesh.indices[index_offset + 0].vertex_index;
-                int v1 = shape.mesh.indices[index_offset + 1].vertex_index;
-                int v2 = shape.mesh.indices[index_offset + 2].vertex_index;
-
-                // Avoid degenerate triangles
-                if (v0 != v1 && v1 != v2 && v2 != v0) {
-                    triangles.emplace_back(Triangle{v0, v1, v2, panelId++});
-                }
-            }
-            index_offset += fv;
-        }
+    separateBodies();
+    if (bodyNames.size() > 1)
+        std::cout << "✔️  " << bodyNames.size() - 1 << " named sub-bod" << (bodyNames.size() == 2 ? "y" : "ies")
+                  << " (o/g) can be moved with body transforms.\n";
+
+    // === Orient every connected part consistently and outward ===
+    std::vector<int> componentOf;
+    topology = MeshOrientation::orientOutward(vertices, triangles, &componentOf);
+    if (!triangles.empty()) {
+        std::cout << "✔️  Normals oriented outward: " << topology.components << " component(s), "
+                  << topology.flippedFaces << " face(s) flipped.\n";
+        if (topology.openEdges > 0)
+            std::cerr << "⚠️  Mesh is not closed: " << topology.openEdges << " open edge(s).\n";
+        if (topology.nonManifoldEdges > 0)
+            std::cerr << "⚠️  " << topology.nonManifoldEdges << " non-manifold edge(s) (shared by more than two faces).\n";
+        if (topology.inconsistentEdges > 0)
+            std::cerr << "⚠️  " << topology.inconsistentEdges << " edge(s) could not be oriented consistently.\n";
     }
 
-    // === Correct triangle orientations so normals point outward ===
-    if (!vertices.empty() && !triangles.empty()) {
-        Vector3 center = getCenter(0.0);  // Center of bounding box
-
-        for (auto& tri : triangles) {
-            const Vector3& v0 = vertices[tri.v1];
-            const Vector3& v1 = vertices[tri.v2];
-            const Vector3& v2 = vertices[tri.v3];
-
-            Vector3 faceCenter = (v0 + v1 + v2) / 3.0;
-            Vector3 normal = (v1 - v0).cross(v2 - v0).normalize();
-            Vector3 toCenter = (faceCenter - center).normalize();
+    triangleTable = TriangleTable::build(vertices, triangles);
 
-            if (normal.dot(toCenter) < 0) {
-                std::swap(tri.v1, tri.v2);  // Flip triangle winding
-            }
-        }
-        std::cout << "✔️  Normals corrected: all faces point outward.\n";
+    // === Share repeated parts for ray tracing ===
+    instancedMesh = InstancedMesh::detect(triangleTable, componentOf);
+    if (instancedMesh->uniqueTriangleCount() < triangles.size()) {
+        std::cout << "✔️  Instancing: " << instancedMesh->uniqueTriangleCount() << " unique of "
+                  << triangles.size() << " triangles (" << instancedMesh->getPrototypes().size()
+                  << " prototype(s), " << instancedMesh->getInstances().size() << " instance(s)).\n";
     }
-
     return true;
 }
 
@@ -128,6 +113,76 @@ const std::vector<Vector3>& MeshLoader::getVertices() const { return vertices; }
  */
 const std::vector<Triangle>& MeshLoader::getTriangles() const { return triangles; }
 
+/**
+ * @brief Get the triangle attribute table built after winding correction.
+ */
+std::shared_ptr<const TriangleTable> MeshLoader::getTriangleTable() const { return triangleTable; }
+
+/**
+ * @brief Get the two-level view for ray tracing (repeated parts shared).
+ */
+std::shared_ptr<const InstancedMesh> MeshLoader::getInstancedMesh() const { return instancedMesh; }
+
+/**
+ * @brief Get the topology found while orienting the last loaded mesh.
+ */
+const MeshTopologyReport& MeshLoader::getTopologyReport() const { return topology; }
+
+/**
+ * @brief Get material names indexed by Triangle::materialId.
+ */
+const std::vector<std::string>& MeshLoader::getMaterialNames() const { return materialNames; }
+
+/**
+ * @brief Get rigid sub-body names indexed by Triangle::bodyId.
+ */
+const std::vector<std::string>& MeshLoader::getBodyNames() const { return bodyNames; }
+
+/**
+ * @brief Gives every body its own vertices.
+ *
+ * A vertex belongs to the body of the first face using it; faces of other
+ * bodies get a copy, so a hinge line shared in the file does not tie the
+ * bodies together when one of them moves.
+ */
+void MeshLoader::separateBodies() {
+    vertexBody.assign(vertices.size(), bodyNames.size() > 1 ? -1 : 0);
+    if (bodyNames.size() < 2) return;
+
+    std::map<std::pair<int, int>, int> copies;   // (Vertex, Körper) → Kopie
+    for (auto& tri : triangles) {
+        for (int* v : {&tri.v1, &tri.v2, &tri.v3}) {
+            if (vertexBody[*v] < 0) vertexBody[*v] = tri.bodyId;
+            if (vertexBody[*v] == tri.bodyId) continue;
+
+            auto [it, inserted] = copies.try_emplace({*v, tri.bodyId}, static_cast<int>(vertices.size()));
+            if (inserted) {
+                vertices.push_back(vertices[*v]);
+                vertexBody.push_back(tri.bodyId);
+            }
+            *v = it->second;
+        }
+    }
+    for (int& body : vertexBody) body = std::max(body, 0);   // unbenutzte Vertices
+}
+
+/**
+ * @brief Vertex positions with the rigid sub-bodies moved.
+ *
+ * @param bodyTransforms Transform per body ID; missing entries keep the loaded position.
+ * @return One position per vertex, in the order of getVertices().
+ */
+std::vector<Vector3> MeshLoader::getPosedVertices(const std::vector<RigidTransform>& bodyTransforms) const {
+    std::vector<Vector3> posed = vertices;
+    const long n = static_cast<long>(posed.size());
+    #pragma omp parallel for schedule(static)
+    for (long i = 0; i < n; ++i) {
+        const size_t body = static_cast<size_t>(vertexBody[i]);
+        if (body < bodyTransforms.size()) posed[i] = bodyTransforms[body].apply(posed[i]);
+    }
+    return posed;
+}
+
 /**
  * @brief Compute padded bounding box.
  * 
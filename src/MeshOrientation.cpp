@@ -0,0 +1,302 @@
+#include "MeshOrientation.h"
+#include "IntersectionEngine.h"
+#include "TriangleTable.h"
+#include "Ray.h"
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <utility>
+
+namespace {
+    constexpr int parityRays = 7;              // ungerade → eindeutige Mehrheit
+    constexpr int maxCrossings = 1 << 20;      // Schutz gegen Endlosschleifen
+    constexpr double maxConeCos2 = 0.25;       // Strahlen höchstens 60° von der Normale
+    constexpr double volumeTolerance = 1e-9;   // |V| relativ zu A^1.5, darunter flach → Strahlen
+
+    // Kanonischer Vertexindex: Vertices an identischer Position teilen einen Index
+    std::vector<int> weldVertices(const std::vector<Vector3>& vertices) {
+        std::vector<int> order(vertices.size());
+        std::iota(order.begin(), order.end(), 0);
+        auto less = [&](int a, int b) {
+            const Vector3& p = vertices[a];
+            const Vector3& q = vertices[b];
+            if (p.x != q.x) return p.x < q.x;
+            if (p.y != q.y) return p.y < q.y;
+            if (p.z != q.z) return p.z < q.z;
+            return a < b;
+        };
+        std::sort(order.begin(), order.end(), less);
+
+        std::vector<int> canon(vertices.size());
+        for (size_t i = 0; i < order.size(); ++i) {
+            const Vector3& p = vertices[order[i]];
+            const bool same = i > 0 && p.x == vertices[order[i - 1]].x && p.y == vertices[order[i - 1]].y &&
+                              p.z == vertices[order[i - 1]].z;
+            canon[order[i]] = same ? canon[order[i - 1]] : order[i];
+        }
+        return canon;
+    }
+
+    int findRoot(std::vector<int>& parent, int i) {
+        while (parent[i] != i) {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    }
+
+    // Anzahl der Schnitte eines Strahls mit der Komponente (Startdreieck ausgeschlossen)
+    int countCrossings(const IntersectionEngine& engine, Ray ray) {
+        int crossings = 0;
+        while (crossings < maxCrossings) {
+            auto hit = engine.intersect(ray);
+            if (!hit) break;
+            ++crossings;
+            ray.origin = hit->point;
+            ray.panelId = hit->panelId;
+        }
+        return crossings;
+    }
+}
+
+/**
+ * @brief Orients every connected component consistently and outward.
+ *
+ * Adjacency comes from a vertex → triangle index (CSR) on the welded
+ * vertices, so each triangle edge is resolved by scanning the triangles of
+ * one vertex (parallel over triangles). Components are labelled with a
+ * union-find over the manifold edges. Each component then runs in parallel:
+ * breadth-first winding propagation, then the outward side is chosen. A
+ * closed, consistent component uses the sign of its enclosed volume (its
+ * winding number). Open, non-manifold or flat components cast parity rays
+ * against an intersection engine holding only that component (linear scan,
+ * no hierarchy build for a handful of rays), so the cost stays linear in
+ * the component size.
+ *
+ * @param vertices Vertex coordinates.
+ * @param triangles Triangles; windings are flipped in place (v1 ↔ v2).
+ * @param componentOf Optional output: connected component per triangle.
+ * @return Component count, flipped faces and open/non-manifold/inconsistent edge counts.
+ */
+MeshTopologyReport MeshOrientation::orientOutward(const std::vector<Vector3>& vertices,
+                                                  std::vector<Triangle>& triangles, std::vector<int>* componentOf) {
+    MeshTopologyReport report;
+    const long n = static_cast<long>(triangles.size());
+    if (componentOf) componentOf->clear();
+    if (n == 0) return report;
+
+    const std::vector<int> canon = weldVertices(vertices);
+    auto corner = [&](long t, int k) {
+        const Triangle& tri = triangles[t];
+        return canon[k == 0 ? tri.v1 : (k == 1 ? tri.v2 : tri.v3)];
+    };
+
+    // --- Vertex → Dreiecke (CSR über die verschweißten Indizes)
+    std::vector<int> start(vertices.size() + 1, 0);
+    for (long t = 0; t < n; ++t)
+        for (int k = 0; k < 3; ++k) ++start[corner(t, k) + 1];
+    std::partial_sum(start.begin(), start.end(), start.begin());
+    std::vector<int> incident(static_cast<size_t>(start.back()));
+    {
+        std::vector<int> fill(start.begin(), start.end() - 1);
+        for (long t = 0; t < n; ++t)
+            for (int k = 0; k < 3; ++k) incident[fill[corner(t, k)]++] = static_cast<int>(t);
+    }
+
+    // --- Nachbar jenseits der Kante k (Ecke k → k+1); −1 bei offenen und nichtmannigfaltigen Kanten.
+    // reversed = Nachbar durchläuft die Kante gegenläufig, d. h. gleiche Orientierung.
+    std::vector<int> neighbor(3 * static_cast<size_t>(n), -1);
+    std::vector<char> reversed(3 * static_cast<size_t>(n), 0);
+    std::vector<char> boundary(static_cast<size_t>(n), 0);   // Dreieck hat offene/nichtmannigfaltige Kante
+    size_t openEdges = 0, nonManifoldEdges = 0;
+
+    #pragma omp parallel for schedule(static) reduction(+ : openEdges, nonManifoldEdges)
+    for (long t = 0; t < n; ++t) {
+        for (int k = 0; k < 3; ++k) {
+            const int a = corner(t, k), b = corner(t, (k + 1) % 3);
+            if (a == b) continue;   // nach dem Verschweißen entartet
+
+            int count = 0, other = -1;
+            bool otherReversed = false, lowestIndex = true;
+            for (int j = start[a]; j < start[a + 1]; ++j) {
+                const int u = incident[j];
+                if (u == t || (j > start[a] && incident[j - 1] == u)) continue;
+                for (int m = 0; m < 3; ++m) {
+                    if (corner(u, m) != a) continue;
+                    const bool forward = corner(u, (m + 1) % 3) == b;
+                    const bool backward = corner(u, (m + 2) % 3) == b;
+                    if (!forward && !backward) break;
+                    ++count;
+                    other = u;
+                    otherReversed = backward;
+                    if (u < t) lowestIndex = false;
+                    break;
+                }
+            }
+
+            if (count != 1) boundary[t] = 1;
+            if (count == 0) {
+                ++openEdges;
+            } else if (count == 1) {
+                neighbor[3 * t + k] = other;
+                reversed[3 * t + k] = otherReversed ? 1 : 0;
+            } else if (lowestIndex) {
+                ++nonManifoldEdges;   // einmal pro Kante, vom kleinsten Dreiecksindex gezählt
+            }
+        }
+    }
+    report.openEdges = openEdges;
+    report.nonManifoldEdges = nonManifoldEdges;
+
+    // --- Zusammenhangskomponenten (Union-Find) und Dreiecke je Komponente
+    std::vector<int> parent(static_cast<size_t>(n));
+    std::iota(parent.begin(), parent.end(), 0);
+    for (long t = 0; t < n; ++t) {
+        for (int k = 0; k < 3; ++k) {
+            const int nb = neighbor[3 * t + k];
+            if (nb > t) {
+                const int ra = findRoot(parent, static_cast<int>(t)), rb = findRoot(parent, nb);
+                if (ra != rb) parent[std::max(ra, rb)] = std::min(ra, rb);
+            }
+        }
+    }
+    std::vector<int> label(static_cast<size_t>(n), -1), componentStart(1, 0);
+    std::vector<int> sizes;
+    for (long t = 0; t < n; ++t) {
+        const int root = findRoot(parent, static_cast<int>(t));
+        if (label[root] < 0) {
+            label[root] = static_cast<int>(sizes.size());
+            sizes.push_back(0);
+        }
+        label[t] = label[root];
+        ++sizes[label[t]];
+    }
+    const long componentCount = static_cast<long>(sizes.size());
+    for (int s : sizes) componentStart.push_back(componentStart.back() + s);
+    std::vector<int> members(static_cast<size_t>(n));
+    {
+        std::vector<int> fill(componentStart.begin(), componentStart.end() - 1);
+        for (long t = 0; t < n; ++t) members[fill[label[t]]++] = static_cast<int>(t);
+    }
+    report.components = static_cast<size_t>(componentCount);
+
+    // Größte Komponenten zuerst, damit sie nicht am Ende einen Thread allein belegen
+    std::vector<int> schedule(static_cast<size_t>(componentCount));
+    std::iota(schedule.begin(), schedule.end(), 0);
+    std::stable_sort(schedule.begin(), schedule.end(), [&](int a, int b) { return sizes[a] > sizes[b]; });
+
+    // --- Pro Komponente: Windung fortpflanzen, dann Vorzeichen des Volumens bzw. Paritätsstrahlen
+    std::vector<char> flip(static_cast<size_t>(n), 0), visited(static_cast<size_t>(n), 0);
+    size_t inconsistentEdges = 0;
+
+    #pragma omp parallel for schedule(dynamic, 1) reduction(+ : inconsistentEdges)
+    for (long s = 0; s < componentCount; ++s) {
+        const int c = schedule[s];
+        const int* tris = members.data() + componentStart[c];
+        const int size = componentStart[c + 1] - componentStart[c];
+
+        std::vector<int> queue;
+        queue.reserve(static_cast<size_t>(size));
+        queue.push_back(tris[0]);
+        visited[tris[0]] = 1;
+        size_t localInconsistent = 0;
+        bool closed = true;
+        for (size_t q = 0; q < queue.size(); ++q) {
+            const int t = queue[q];
+            if (boundary[t]) closed = false;
+            for (int k = 0; k < 3; ++k) {
+                const int nb = neighbor[3 * t + k];
+                if (nb < 0) continue;
+                const char expected = flip[t] ^ (reversed[3 * t + k] ? 0 : 1);
+                if (!visited[nb]) {
+                    visited[nb] = 1;
+                    flip[nb] = expected;
+                    queue.push_back(nb);
+                } else if (flip[nb] != expected && t < nb) {
+                    ++localInconsistent;
+                }
+            }
+        }
+        inconsistentEdges += localInconsistent;
+
+        // Geschlossen und konsistent: Vorzeichen des eingeschlossenen Volumens entscheidet
+        if (closed && localInconsistent == 0) {
+            const Vector3 ref = vertices[triangles[tris[0]].v1];
+            double volume = 0.0, area = 0.0;
+            for (int i = 0; i < size; ++i) {
+                const Triangle& tri = triangles[tris[i]];
+                const Vector3 a = vertices[tri.v1] - ref;
+                const Vector3 b = vertices[flip[tris[i]] ? tri.v3 : tri.v2] - ref;
+                const Vector3 c = vertices[flip[tris[i]] ? tri.v2 : tri.v3] - ref;
+                volume += a.dot(b.cross(c));
+                area += (b - a).cross(c - a).norm();
+            }
+            volume /= 6.0;
+            area *= 0.5;
+            if (std::abs(volume) > volumeTolerance * area * std::sqrt(area)) {
+                if (volume < 0.0) {
+                    for (int i = 0; i < size; ++i) flip[tris[i]] ^= 1;
+                }
+                continue;
+            }
+        }
+
+        // Komponente allein mit propagierter Windung; Panel-ID = lokaler Index
+        std::vector<Triangle> local(static_cast<size_t>(size));
+        for (int i = 0; i < size; ++i) {
+            Triangle tri = triangles[tris[i]];
+            if (flip[tris[i]]) std::swap(tri.v1, tri.v2);
+            tri.panelId = i;
+            local[i] = tri;
+        }
+        auto table = TriangleTable::build(vertices, local);
+        IntersectionEngine engine;
+        engine.setLinearScan(true);   // wenige Strahlen: lineare Suche statt Hierarchieaufbau
+        engine.setMesh(table);
+
+        std::mt19937 rng(0x9E3779B9u ^ static_cast<unsigned>(c));
+        std::uniform_real_distribution<double> uni01(0.0, 1.0);
+        const int rays = std::min(parityRays, size);
+        int votes = 0, inward = 0;
+        for (int r = 0; r < rays; ++r) {
+            const TriangleAttributes& row = (*table)[static_cast<size_t>(r) * size / rays];
+            if (row.area <= 0.0) continue;
+
+            // Zufälliger Punkt im Dreieck, Richtung im Kegel um die Normale (keine Kanten-/Eckentreffer)
+            const double r1 = std::sqrt(uni01(rng)), r2 = uni01(rng);
+            const Vector3 p = row.p0 * (1.0 - r1) + row.p1 * (r1 * (1.0 - r2)) + row.p2 * (r1 * r2);
+            const Vector3& ez = row.normal;
+            const Vector3 ex = (std::abs(ez.x) > 0.9 ? Vector3(0, 1, 0) : Vector3(1, 0, 0)).cross(ez).normalize();
+            const Vector3 ey = ez.cross(ex);
+            const double u1 = maxConeCos2 + (1.0 - maxConeCos2) * uni01(rng);   // cos²θ
+            const double phi = 2.0 * M_PI * uni01(rng);
+            const double s = std::sqrt(1.0 - u1);
+
+            Ray ray;
+            ray.origin = p;
+            ray.direction = (ex * (s * std::cos(phi)) + ey * (s * std::sin(phi)) + ez * std::sqrt(u1)).normalize();
+            ray.panelId = row.panelId;
+
+            ++votes;
+            if (countCrossings(engine, ray) % 2 == 1) ++inward;   // Start ins Innere
+        }
+
+        if (2 * inward > votes) {
+            for (int i = 0; i < size; ++i) flip[tris[i]] ^= 1;
+        }
+    }
+    report.inconsistentEdges = inconsistentEdges;
+
+    size_t flipped = 0;
+    #pragma omp parallel for schedule(static) reduction(+ : flipped)
+    for (long t = 0; t < n; ++t) {
+        if (!flip[t]) continue;
+        std::swap(triangles[t].v1, triangles[t].v2);
+        ++flipped;
+    }
+    report.flippedFaces = flipped;
+    if (componentOf) *componentOf = std::move(label);
+    return report;
+}
@@ -0,0 +1,388 @@
+#include "ObjReader.h"
+#include <omp.h>
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string_view>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+    constexpr size_t minChunkBytes = size_t(1) << 20;   // kleinere Dateien werden nicht weiter zerlegt
+    constexpr size_t chunksPerThread = 4;               // Lastausgleich bei ungleich dichten Abschnitten
+
+    // Schreibgeschützte Speicherabbildung einer Datei
+    class MappedFile {
+    public:
+        explicit MappedFile(const std::string& path) {
+            fd = ::open(path.c_str(), O_RDONLY);
+            struct stat st;
+            if (fd < 0 || ::fstat(fd, &st) != 0) return;
+            length = static_cast<size_t>(st.st_size);
+            if (length > 0) {
+                void* p = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (p == MAP_FAILED) return;
+                ::madvise(p, length, MADV_WILLNEED);
+                data = static_cast<const char*>(p);
+            }
+            opened = true;
+        }
+        ~MappedFile() {
+            if (data) ::munmap(const_cast<char*>(data), length);
+            if (fd >= 0) ::close(fd);
+        }
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        bool isOpen() const { return opened; }
+        const char* begin() const { return data; }
+        const char* end() const { return data + length; }
+        size_t size() const { return length; }
+
+    private:
+        int fd = -1;
+        const char* data = nullptr;
+        size_t length = 0;
+        bool opened = false;
+    };
+
+    // Zeilenbereich einer Datei mit Zählern aus dem ersten Durchlauf
+    struct Chunk {
+        const char* begin = nullptr;
+        const char* end = nullptr;
+        size_t vertexCount = 0;
+        size_t triangleCount = 0;
+        size_t vertexOffset = 0;       // Vertices vor diesem Chunk
+        size_t triangleOffset = 0;     // Dreiecke vor diesem Chunk
+        size_t degenerateCount = 0;
+        std::vector<std::string> materialLibraries;
+        std::string lastMaterial;      // letztes usemtl im Chunk
+        bool setsMaterial = false;
+        int startMaterial = 0;         // aktives Material am Chunkanfang
+        std::vector<std::string> bodies;   // o/g-Namen in Reihenfolge des ersten Auftretens
+        std::string lastBody;          // letztes o/g im Chunk
+        bool setsBody = false;
+        int startBody = 0;             // aktiver Teilkörper am Chunkanfang
+        bool failed = false;
+    };
+
+    using MaterialIds = std::map<std::string, int, std::less<>>;
+    using BodyIds = MaterialIds;   // o/g-Name → Triangle::bodyId
+
+    inline bool isBlank(char c) { return c == ' ' || c == '\t'; }
+
+    inline void skipBlanks(const char*& p, const char* end) {
+        while (p < end && isBlank(*p)) ++p;
+    }
+
+    inline std::string_view nextToken(const char*& p, const char* end) {
+        skipBlanks(p, end);
+        const char* b = p;
+        while (p < end && !isBlank(*p)) ++p;
+        return {b, static_cast<size_t>(p - b)};
+    }
+
+    // Ruft f(Anfang, Ende) für jede nichtleere Zeile auf (ohne führenden Leerraum und \r)
+    template <typename F>
+    void forEachLine(const char* p, const char* end, F&& f) {
+        while (p < end) {
+            const char* eol = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+            if (!eol) eol = end;
+            const char* b = p;
+            skipBlanks(b, eol);
+            const char* e = eol;
+            if (e > b && e[-1] == '\r') --e;
+            if (b < e) f(b, e);
+            p = eol + 1;
+        }
+    }
+
+    // Schlüsselwort am Zeilenanfang, gefolgt von Leerraum; p steht danach hinter dem Schlüsselwort
+    inline bool keyword(const char*& p, const char* end, std::string_view kw) {
+        const size_t n = kw.size();
+        if (static_cast<size_t>(end - p) <= n || std::memcmp(p, kw.data(), n) != 0 || !isBlank(p[n])) return false;
+        p += n;
+        return true;
+    }
+
+    inline bool parseDouble(const char*& p, const char* end, double& value) {
+        skipBlanks(p, end);
+        if (p < end && *p == '+') ++p;
+        auto [next, ec] = std::from_chars(p, end, value);
+        if (ec != std::errc()) return false;
+        p = next;
+        return true;
+    }
+
+    size_t countFaceCorners(const char* p, const char* end) {
+        size_t n = 0;
+        while (!nextToken(p, end).empty()) ++n;
+        return n;
+    }
+
+    // Vertexindex eines Face-Eckpunkts ("v", "v/vt", "v//vn", "v/vt/vn"; negativ = relativ), −1 bei Fehler
+    long resolveCorner(std::string_view token, size_t verticesBefore, size_t vertexTotal) {
+        const char* end = token.data() + token.size();
+        long idx = 0;
+        auto [next, ec] = std::from_chars(token.data(), end, idx);
+        if (ec != std::errc() || idx == 0 || (next != end && *next != '/')) return -1;
+        const long resolved = idx > 0 ? idx - 1 : static_cast<long>(verticesBefore) + idx;
+        return (resolved >= 0 && resolved < static_cast<long>(vertexTotal)) ? resolved : -1;
+    }
+
+    // ID eines Material- oder Körpernamens, 0 (Standard) wenn unbekannt
+    int lookupId(const MaterialIds& ids, std::string_view name) {
+        auto it = ids.find(name);
+        return it != ids.end() ? it->second : 0;
+    }
+
+    // Name eines o/g-Statements (erstes Token; ohne Namen = Hauptkörper "")
+    inline bool bodyStatement(const char*& p, const char* end, std::string_view& name) {
+        if (!keyword(p, end, "o") && !keyword(p, end, "g")) {
+            if (end - p == 1 && (*p == 'o' || *p == 'g')) {
+                name = {};
+                return true;
+            }
+            return false;
+        }
+        name = nextToken(p, end);
+        return true;
+    }
+
+    // newmtl-Namen aus den Materialbibliotheken (zuerst neben der OBJ-Datei, dann relativ zum Arbeitsverzeichnis)
+    MaterialIds loadMaterialLibraries(const std::string& objPath, const std::vector<std::string>& libraries,
+                                      std::vector<std::string>& materialNames) {
+        MaterialIds ids;
+        const size_t slash = objPath.find_last_of('/');
+        const std::string dir = slash == std::string::npos ? "" : objPath.substr(0, slash + 1);
+
+        for (const auto& lib : libraries) {
+            std::ifstream in(dir + lib);
+            if (!in) in.open(lib);
+            if (!in) {
+                std::cerr << "⚠️  Material library not found: " << lib << " (faces use the default material)\n";
+                continue;
+            }
+            std::string line;
+            while (std::getline(in, line)) {
+                const char* p = line.data();
+                const char* end = p + line.size();
+                if (!line.empty() && line.back() == '\r') --end;
+                skipBlanks(p, end);
+                if (!keyword(p, end, "newmtl")) continue;
+                const std::string name(nextToken(p, end));
+                if (name.empty() || ids.count(name)) continue;
+                materialNames.push_back(name);
+                ids.emplace(name, static_cast<int>(materialNames.size() - 1));
+            }
+        }
+        return ids;
+    }
+}
+
+/**
+ * @brief Reads an OBJ file into the final vertex and triangle arrays.
+ *
+ * Pass 1 counts `v` lines and triangles (n − 2 per n-gon) per chunk and
+ * collects `mtllib`/`usemtl` and `o`/`g` names. Pass 2 parses all vertices, then all
+ * faces, each chunk writing into its own slice; relative indices resolve
+ * against the chunk's vertex offset. Quads need their corner positions for
+ * the diagonal, hence the vertex pass completes first. Dropped degenerate
+ * faces are compacted at the end so panel IDs stay contiguous.
+ *
+ * @param filename Path to the .obj file.
+ * @param vertices Output vertex coordinates (double precision, as written in the file).
+ * @param triangles Output triangles with panel ID = index and material ID.
+ * @param materialNames Output material names, index = Triangle::materialId.
+ * @param bodyNames Output sub-body names, index = Triangle::bodyId.
+ * @return false if the file cannot be opened or contains malformed vertices or faces.
+ */
+bool ObjReader::read(const std::string& filename,
+                     std::vector<Vector3>& vertices,
+                     std::vector<Triangle>& triangles,
+                     std::vector<std::string>& materialNames,
+                     std::vector<std::string>& bodyNames) {
+    vertices.clear();
+    triangles.clear();
+    materialNames.assign(1, "");
+    bodyNames.assign(1, "");
+
+    MappedFile file(filename);
+    if (!file.isOpen()) {
+        std::cerr << "❌ Could not open mesh: " << filename << "\n";
+        return false;
+    }
+
+    // --- Chunks an Zeilengrenzen
+    const size_t threads = static_cast<size_t>(std::max(omp_get_max_threads(), 1));
+    const size_t chunkCount = std::clamp<size_t>(file.size() / minChunkBytes, 1, chunksPerThread * threads);
+    std::vector<Chunk> chunks(chunkCount);
+    const char* cursor = file.begin();
+    for (size_t c = 0; c < chunkCount; ++c) {
+        chunks[c].begin = cursor;
+        if (c + 1 == chunkCount) {
+            cursor = file.end();
+        } else {
+            const char* target = std::max(cursor, file.begin() + file.size() * (c + 1) / chunkCount);
+            const void* nl = target < file.end()
+                ? std::memchr(target, '\n', static_cast<size_t>(file.end() - target)) : nullptr;
+            cursor = nl ? static_cast<const char*>(nl) + 1 : file.end();
+        }
+        chunks[c].end = cursor;
+    }
+    const long n = static_cast<long>(chunkCount);
+
+    // --- Durchlauf 1: Anzahl Vertices/Dreiecke und Materialangaben pro Chunk
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (long c = 0; c < n; ++c) {
+        Chunk& ch = chunks[c];
+        forEachLine(ch.begin, ch.end, [&](const char* b, const char* e) {
+            if (keyword(b, e, "v")) {
+                ++ch.vertexCount;
+            } else if (keyword(b, e, "f")) {
+                const size_t corners = countFaceCorners(b, e);
+                if (corners >= 3) ch.triangleCount += corners - 2;
+            } else if (keyword(b, e, "usemtl")) {
+                ch.lastMaterial = std::string(nextToken(b, e));
+                ch.setsMaterial = true;
+            } else if (std::string_view body; bodyStatement(b, e, body)) {
+                ch.lastBody = std::string(body);
+                ch.setsBody = true;
+                if (!body.empty() && std::find(ch.bodies.begin(), ch.bodies.end(), body) == ch.bodies.end())
+                    ch.bodies.emplace_back(body);
+            } else if (keyword(b, e, "mtllib")) {
+                for (auto t = nextToken(b, e); !t.empty(); t = nextToken(b, e))
+                    ch.materialLibraries.emplace_back(t);
+            }
+        });
+    }
+
+    // --- Präfixsummen → Ausgabebereiche; aktives Material an jedem Chunkanfang
+    size_t vertexTotal = 0, triangleTotal = 0;
+    std::vector<std::string> libraries;
+    for (auto& ch : chunks) {
+        ch.vertexOffset = vertexTotal;
+        ch.triangleOffset = triangleTotal;
+        vertexTotal += ch.vertexCount;
+        triangleTotal += ch.triangleCount;
+        libraries.insert(libraries.end(), ch.materialLibraries.begin(), ch.materialLibraries.end());
+    }
+    const MaterialIds materialIds = loadMaterialLibraries(filename, libraries, materialNames);
+    BodyIds bodyIds;
+    for (const auto& ch : chunks) {
+        for (const auto& name : ch.bodies) {
+            if (bodyIds.count(name)) continue;
+            bodyIds.emplace(name, static_cast<int>(bodyNames.size()));
+            bodyNames.push_back(name);
+        }
+    }
+    int material = 0, body = 0;
+    for (auto& ch : chunks) {
+        ch.startMaterial = material;
+        ch.startBody = body;
+        if (ch.setsMaterial) material = lookupId(materialIds, ch.lastMaterial);
+        if (ch.setsBody) body = lookupId(bodyIds, ch.lastBody);
+    }
+
+    vertices.resize(vertexTotal);
+    triangles.resize(triangleTotal);
+
+    // --- Durchlauf 2: direkt in die Zielarrays parsen
+    #pragma omp parallel
+    {
+        #pragma omp for schedule(dynamic, 1)
+        for (long c = 0; c < n; ++c) {
+            Chunk& ch = chunks[c];
+            size_t k = ch.vertexOffset;
+            forEachLine(ch.begin, ch.end, [&](const char* b, const char* e) {
+                if (!keyword(b, e, "v")) return;
+                Vector3& v = vertices[k++];
+                if (!parseDouble(b, e, v.x) || !parseDouble(b, e, v.y) || !parseDouble(b, e, v.z))
+                    ch.failed = true;
+            });
+        }
+
+        // Quads brauchen die Eckpunkte, daher erst nach der impliziten Barriere
+        std::vector<long> corners;
+        #pragma omp for schedule(dynamic, 1)
+        for (long c = 0; c < n; ++c) {
+            Chunk& ch = chunks[c];
+            size_t k = ch.triangleOffset;
+            size_t verticesBefore = ch.vertexOffset;
+            int currentMaterial = ch.startMaterial;
+            int currentBody = ch.startBody;
+
+            auto emit = [&](long a, long b, long c3) {
+                Triangle& t = triangles[k++];
+                t = Triangle(static_cast<int>(a), static_cast<int>(b), static_cast<int>(c3));
+                t.materialId = currentMaterial;
+                t.bodyId = currentBody;
+                if (a == b || b == c3 || a == c3) {
+                    t.v1 = -1;   // degeneriert, wird unten entfernt
+                    ++ch.degenerateCount;
+                }
+            };
+
+            forEachLine(ch.begin, ch.end, [&](const char* b, const char* e) {
+                if (keyword(b, e, "v")) {
+                    ++verticesBefore;
+                } else if (keyword(b, e, "usemtl")) {
+                    currentMaterial = lookupId(materialIds, nextToken(b, e));
+                } else if (std::string_view body; bodyStatement(b, e, body)) {
+                    currentBody = lookupId(bodyIds, body);
+                } else if (keyword(b, e, "f")) {
+                    corners.clear();
+                    for (auto t = nextToken(b, e); !t.empty(); t = nextToken(b, e)) {
+                        const long idx = resolveCorner(t, verticesBefore, vertexTotal);
+                        if (idx < 0) ch.failed = true;
+                        corners.push_back(std::max(idx, 0L));
+                    }
+                    const size_t m = corners.size();
+                    if (m < 3) return;
+                    if (m == 4) {
+                        // Kürzere Diagonale teilt das Viereck
+                        const double d02 = (vertices[corners[2]] - vertices[corners[0]]).squaredNorm();
+                        const double d13 = (vertices[corners[3]] - vertices[corners[1]]).squaredNorm();
+                        if (d02 < d13) {
+                            emit(corners[0], corners[1], corners[2]);
+                            emit(corners[0], corners[2], corners[3]);
+                        } else {
+                            emit(corners[0], corners[1], corners[3]);
+                            emit(corners[1], corners[2], corners[3]);
+                        }
+                    } else {
+                        for (size_t i = 1; i + 1 < m; ++i) emit(corners[0], corners[i], corners[i + 1]);
+                    }
+                }
+            });
+        }
+    }
+
+    size_t degenerate = 0;
+    for (const auto& ch : chunks) {
+        if (ch.failed) {
+            std::cerr << "❌ Malformed vertex or face (missing vertex index) in " << filename << "\n";
+            vertices.clear();
+            triangles.clear();
+            return false;
+        }
+        degenerate += ch.degenerateCount;
+    }
+
+    if (degenerate > 0) {
+        triangles.erase(std::remove_if(triangles.begin(), triangles.end(),
+                                       [](const Triangle& t) { return t.v1 < 0; }),
+                        triangles.end());
+    }
+
+    const long triangleCount = static_cast<long>(triangles.size());
+    #pragma omp parallel for
+    for (long i = 0; i < triangleCount; ++i) triangles[i].panelId = static_cast<int>(i);
+
+    return true;
+}
@@ -0,0 +1,522 @@
+#include "PanelMethodEngine.h"
+#include "IntersectionEngine.h"
+#include "Bvh.h"
+#include "Ray.h"
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+#include <random>
+#include <map>
+#include <cstdint>
+
+/**
+ * @brief Assigns the shared triangle table (outward normals, areas, centroids).
+ *
+ * Triangles are expected with outward winding (as produced by MeshLoader).
+ * All panels start as non-isolated until detectIsolatedPanels() is called.
+ *
+ * @param triangleTable Precomputed triangle attributes of the mesh.
+ */
+void PanelMethodEngine::setMesh(std::shared_ptr<const TriangleTable> triangleTable) {
+    table = std::move(triangleTable);
+
+    // Toleranz relativ zur Meshgröße, damit koplanare Nachbarn nicht als sichtbar gelten
+    planeTolerance = 1e-9 * (table->getBoundsMax() - table->getBoundsMin()).norm();
+
+    isolated.assign(table->size(), 0);
+    viewFactors.assign(table->size(), {});
+    sampledIsolated = 0;
+    detectTwoSidedPanels();
+}
+
+/**
+ * @brief Builds a triangle table from raw mesh data and assigns it.
+ *
+ * @param verts A list of 3D vertex positions.
+ * @param tris A list of triangles, defined by indices into the vertex list.
+ */
+void PanelMethodEngine::setMesh(const std::vector<Vector3>& verts, const std::vector<Triangle>& tris) {
+    setMesh(TriangleTable::build(verts, tris));
+}
+
+/**
+ * @brief Resolves the surface model and the fallback material once.
+ *
+ * Without this call the engine assumes DRIA, i.e. every panel has a closed form.
+ */
+void PanelMethodEngine::setSurfaceModel(const SimulationConfig& cfg) {
+    surfaceModel = parseSurfaceModel(cfg.model);
+    defaultMaterial = SurfaceMaterial::fromConfig(cfg);
+}
+
+const SurfaceMaterial& PanelMethodEngine::materialOf(size_t panel) const {
+    const int materialId = (*table)[panel].materialId;
+    return materials && materials->contains(materialId) ? (*materials)[materialId] : defaultMaterial;
+}
+
+/**
+ * @brief Whether the traced reflection kernel of a panel is fully diffuse.
+ *
+ * DRIA always is; Sentman only without specular share; CLL with complete
+ * normal and tangential accommodation re-emits a Maxwellian at T_w (α = 1).
+ * Classic keeps a fraction of the incident energy per molecule, which the
+ * closed form does not describe.
+ */
+bool PanelMethodEngine::closedForm(size_t panel) const {
+    const SurfaceMaterial& mat = materialOf(panel);
+    switch (surfaceModel) {
+        case SurfaceModelType::DRIA:    return true;
+        case SurfaceModelType::Sentman: return mat.specularFraction <= 0.0;
+        case SurfaceModelType::CLL:     return mat.normalAccommodation >= 1.0 && mat.tangentialAccommodation >= 1.0;
+        case SurfaceModelType::Classic: return false;
+    }
+    return false;
+}
+
+/**
+ * @brief Marks the panels of open or non-manifold components as two-sided.
+ *
+ * Vertices are welded by position; triangles connect across edges shared by
+ * exactly two of them. A component with any other edge is not closed, so the
+ * flow reaches the back faces of its panels as well (the intersection engine
+ * hits both sides).
+ */
+void PanelMethodEngine::detectTwoSidedPanels() {
+    const size_t n = table->size();
+    twoSided.assign(n, 0);
+    if (n == 0) return;
+
+    // Eckpunkte nach Position verschweißen
+    std::vector<std::pair<Vector3, uint32_t>> corners;
+    corners.reserve(3 * n);
+    for (size_t i = 0; i < n; ++i) {
+        const TriangleAttributes& t = (*table)[i];
+        corners.emplace_back(t.p0, static_cast<uint32_t>(3 * i));
+        corners.emplace_back(t.p1, static_cast<uint32_t>(3 * i + 1));
+        corners.emplace_back(t.p2, static_cast<uint32_t>(3 * i + 2));
+    }
+    auto less = [](const Vector3& a, const Vector3& b) {
+        return a.x != b.x ? a.x < b.x : (a.y != b.y ? a.y < b.y : a.z < b.z);
+    };
+    std::sort(corners.begin(), corners.end(),
+              [&](const auto& a, const auto& b) { return less(a.first, b.first); });
+    std::vector<uint32_t> vertexOf(3 * n);
+    uint32_t id = 0;
+    for (size_t k = 0; k < corners.size(); ++k) {
+        if (k > 0 && less(corners[k - 1].first, corners[k].first)) ++id;
+        vertexOf[corners[k].second] = id;
+    }
+
+    // Kanten (kleinerer, größerer Eckpunkt) → Dreiecke
+    std::vector<std::pair<uint64_t, uint32_t>> edges;
+    edges.reserve(3 * n);
+    for (size_t i = 0; i < n; ++i) {
+        for (int e = 0; e < 3; ++e) {
+            const uint64_t a = vertexOf[3 * i + e], b = vertexOf[3 * i + (e + 1) % 3];
+            if (a == b) continue;
+            edges.emplace_back((std::min(a, b) << 32) | std::max(a, b), static_cast<uint32_t>(i));
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+
+    std::vector<uint32_t> parent(n);
+    for (uint32_t i = 0; i < n; ++i) parent[i] = i;
+    auto find = [&](uint32_t i) {
+        while (parent[i] != i) i = parent[i] = parent[parent[i]];
+        return i;
+    };
+    std::vector<char> openPanel(n, 0);
+    for (size_t k = 0; k < edges.size();) {
+        size_t end = k;
+        while (end < edges.size() && edges[end].first == edges[k].first) ++end;
+        if (end - k == 2) {
+            parent[find(edges[k].second)] = find(edges[k + 1].second);
+        } else {
+            for (size_t e = k; e < end; ++e) openPanel[edges[e].second] = 1;
+        }
+        k = end;
+    }
+
+    std::vector<char> openComponent(n, 0);
+    for (uint32_t i = 0; i < n; ++i)
+        if (openPanel[i]) openComponent[find(i)] = 1;
+    for (uint32_t i = 0; i < n; ++i) twoSided[i] = openComponent[find(i)];
+}
+
+/**
+ * @brief Checks whether any vertex of panel `other` lies strictly in front of panel `panel`
+ *        (or behind it, if `panel` is two-sided).
+ */
+bool PanelMethodEngine::sees(size_t panel, size_t other) const {
+    const TriangleAttributes& a = (*table)[panel];
+    const TriangleAttributes& b = (*table)[other];
+    const double tol = planeTolerance;
+    const double d0 = a.normal.dot(b.p0 - a.p0);
+    const double d1 = a.normal.dot(b.p1 - a.p0);
+    const double d2 = a.normal.dot(b.p2 - a.p0);
+
+    if (d0 > tol || d1 > tol || d2 > tol) return true;
+    return twoSided[panel] && (d0 < -tol || d1 < -tol || d2 < -tol);
+}
+
+/**
+ * @brief Marks panels that cannot see any other panel.
+ *
+ * Two panels can only exchange molecules if each has part of the other on a
+ * side it exposes to the gas: the front half-space, or both for two-sided
+ * panels of open components. A panel without any such partner receives the
+ * undisturbed free stream and its re-emitted molecules escape to infinity, so
+ * the closed-form panel force is exact for it. For convex bodies every panel
+ * is isolated. Panels without a closed form (see setSurfaceModel) stay coupled.
+ *
+ * Partners are searched in a box hierarchy over the panels; subtrees that lie
+ * entirely behind the panel's plane are skipped, so convex parts cost about
+ * O(n log n) instead of testing every pair.
+ */
+void PanelMethodEngine::detectIsolatedPanels() {
+    const long n = static_cast<long>(table->size());
+    isolated.assign(table->size(), 0);
+    sampledIsolated = 0;
+
+    std::vector<Aabb> bounds(table->size());
+    for (size_t i = 0; i < table->size(); ++i) {
+        const TriangleAttributes& t = (*table)[i];
+        bounds[i].grow(t.p0);
+        bounds[i].grow(t.p1);
+        bounds[i].grow(t.p2);
+    }
+    Bvh bvh;
+    bvh.build(bounds);
+    const std::vector<uint32_t>& order = bvh.primitiveOrder();
+
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (long i = 0; i < n; ++i) {
+        if (!closedForm(i)) continue;
+        const TriangleAttributes& tri = (*table)[i];
+        const Vector3& nrm = tri.normal;
+        const double offset = nrm.dot(tri.p0);
+        const bool bothSides = twoSided[i];
+
+        // Box reicht in den sichtbaren Halbraum: größter (bzw. kleinster) Abstand einer Ecke zur Ebene
+        auto reaches = [&](const Aabb& box) {
+            const double far = nrm.x * (nrm.x > 0 ? box.hi.x : box.lo.x) + nrm.y * (nrm.y > 0 ? box.hi.y : box.lo.y) +
+                               nrm.z * (nrm.z > 0 ? box.hi.z : box.lo.z) - offset;
+            if (far > planeTolerance) return true;
+            if (!bothSides) return false;
+            const double near = nrm.x * (nrm.x > 0 ? box.lo.x : box.hi.x) + nrm.y * (nrm.y > 0 ? box.lo.y : box.hi.y) +
+                                nrm.z * (nrm.z > 0 ? box.lo.z : box.hi.z) - offset;
+            return near < -planeTolerance;
+        };
+
+        bool seesOther = false;
+        bvh.query(reaches, [&](uint32_t first, uint32_t count) {
+            for (uint32_t k = first; k < first + count && !seesOther; ++k) {
+                const long j = order[k];
+                seesOther = j != i && sees(i, j) && sees(j, i);
+            }
+            return seesOther;
+        });
+        isolated[i] = seesOther ? 0 : 1;
+    }
+
+    if (verbose)
+        std::cout << "✔️  Panel method: " << getIsolatedCount() << " of " << table->size()
+                  << " panels handled analytically.\n";
+}
+
+/**
+ * @brief Refines the panel coupling with a sampled view-factor graph.
+ *
+ * Every panel that failed the half-space test emits cosine-weighted rays from
+ * random points on its surface (both faces for two-sided panels); the fraction
+ * of rays hitting panel j estimates the view factor F_ij.
+ *
+ * Sampling can miss a small view factor, so a panel without hits is not taken
+ * as isolated right away: it draws four times as many rays again, up to
+ * maxSampleGrowth × samplesPerPanel. Only a closed-form panel that then still
+ * neither sees nor is seen by any other panel becomes isolated. Its view
+ * factor is below about 3/N (95 %) for N rays drawn; the number of such
+ * panels is reported and available from getSampledIsolatedCount().
+ *
+ * @param engine Intersection engine holding the same mesh.
+ * @param samplesPerPanel Number of visibility rays per candidate panel in the first round.
+ */
+void PanelMethodEngine::buildVisibilityGraph(const IntersectionEngine& engine, int samplesPerPanel) {
+    constexpr int maxSampleGrowth = 16;
+    const size_t n = table->size();
+    viewFactors.assign(n, {});
+    sampledIsolated = 0;
+    if (samplesPerPanel <= 0) return;
+
+    std::vector<std::map<int, int>> hitCounts(n);
+    std::vector<int> drawn(n, 0);
+
+    // Weitere count Strahlen von Panel i; jede Runde mit eigener Zufallsfolge
+    auto sample = [&](size_t i, int count, unsigned round) {
+        const TriangleAttributes& tri = (*table)[i];
+        const Vector3& ez = tri.normal;
+        Vector3 ex = (std::abs(ez.x) > 0.9 ? Vector3(0, 1, 0) : Vector3(1, 0, 0)).cross(ez).normalize();
+        Vector3 ey = ez.cross(ex);
+
+        std::mt19937 rng(1337u + static_cast<unsigned>(i) + 0x9E3779B9u * round);
+        std::uniform_real_distribution<double> uni01(0.0, 1.0);
+
+        for (int k = 0; k < count; ++k) {
+            // Gleichverteilter Punkt auf dem Dreieck
+            double r1 = std::sqrt(uni01(rng));
+            double r2 = uni01(rng);
+            Vector3 p = tri.p0 * (1.0 - r1) + tri.p1 * (r1 * (1.0 - r2)) + tri.p2 * (r1 * r2);
+
+            // Kosinusgewichtete Richtung → Trefferanteil schätzt den Sichtfaktor
+            double u1 = uni01(rng);
+            double phi = 2.0 * M_PI * uni01(rng);
+            double r = std::sqrt(u1);
+            const double side = (twoSided[i] && (k & 1)) ? -1.0 : 1.0;   // zweiseitig: abwechselnd Rückseite
+            Vector3 dir = (ex * (r * std::cos(phi)) + ey * (r * std::sin(phi)) +
+                           ez * (side * std::sqrt(1.0 - u1))).normalize();
+
+            Ray ray;
+            ray.origin = p;
+            ray.direction = dir;
+            ray.panelId = tri.panelId;
+
+            auto hit = engine.intersect(ray);
+            if (hit && hit->panelId != tri.panelId) ++hitCounts[i][hit->panelId];
+        }
+        drawn[i] += count;
+    };
+
+    // Kopplung ist symmetrisch: sieht i das Panel j, so tauschen beide Moleküle aus
+    std::vector<char> coupled(n, 0);
+    auto updateCoupling = [&]() {
+        for (size_t i = 0; i < n; ++i) {
+            for (const auto& [id, _] : hitCounts[i]) {
+                coupled[i] = 1;
+                int j = indexOf(id);
+                if (j >= 0) coupled[j] = 1;
+            }
+        }
+    };
+
+    std::vector<long> candidates;
+    for (size_t i = 0; i < n; ++i)
+        if (!isolated[i]) candidates.push_back(static_cast<long>(i));   // sonst bereits exakt isoliert
+
+    for (unsigned round = 0; !candidates.empty(); ++round) {
+        const long count = static_cast<long>(candidates.size());
+        #pragma omp parallel for schedule(dynamic, 16)
+        for (long c = 0; c < count; ++c) {
+            const size_t i = candidates[c];
+            sample(i, round == 0 ? samplesPerPanel : 3 * drawn[i], round);
+        }
+        updateCoupling();
+
+        // Nächste Runde nur für Panels, die sonst per Sampling isoliert würden
+        std::vector<long> next;
+        for (long i : candidates)
+            if (!coupled[i] && closedForm(i) && drawn[i] < maxSampleGrowth * samplesPerPanel) next.push_back(i);
+        candidates.swap(next);
+    }
+
+    int fewestRays = 0;
+    for (size_t i = 0; i < n; ++i) {
+        for (const auto& [id, hits] : hitCounts[i])
+            viewFactors[i].emplace_back(id, static_cast<double>(hits) / drawn[i]);
+        if (!isolated[i] && !coupled[i] && closedForm(i)) {
+            isolated[i] = 1;
+            fewestRays = sampledIsolated == 0 ? drawn[i] : std::min(fewestRays, drawn[i]);
+            ++sampledIsolated;
+        }
+    }
+
+    if (verbose) {
+        std::cout << "✔️  View-factor graph: " << (n - getIsolatedCount())
+                  << " coupled panels remain for ray tracing.\n";
+        if (sampledIsolated > 0)
+            std::cerr << "⚠️  " << sampledIsolated << " panel(s) isolated by sampling only (≥ " << fewestRays
+                      << " rays each without a hit, view factor below ~" << 3.0 / fewestRays << ").\n";
+    }
+}
+
+const std::vector<std::pair<int, double>>& PanelMethodEngine::getViewFactors(int panelId) const {
+    static const std::vector<std::pair<int, double>> empty;
+    int idx = indexOf(panelId);
+    return idx >= 0 ? viewFactors[idx] : empty;
+}
+
+std::vector<int> PanelMethodEngine::getCoupledPanels() const {
+    std::vector<int> ids;
+    for (size_t i = 0; i < table->size(); ++i) {
+        if (!isolated[i]) ids.push_back((*table)[i].panelId);
+    }
+    return ids;
+}
+
+bool PanelMethodEngine::isIsolated(int panelId) const {
+    int idx = indexOf(panelId);
+    return idx >= 0 && isolated[idx] != 0;
+}
+
+size_t PanelMethodEngine::getIsolatedCount() const {
+    return static_cast<size_t>(std::count(isolated.begin(), isolated.end(), 1));
+}
+
+bool PanelMethodEngine::hasClosedForm(int panelId) const {
+    int idx = indexOf(panelId);
+    return idx >= 0 && closedForm(idx);
+}
+
+bool PanelMethodEngine::isTwoSided(int panelId) const {
+    int idx = indexOf(panelId);
+    return idx >= 0 && twoSided[idx] != 0;
+}
+
+bool PanelMethodEngine::allIsolated() const {
+    return !table->empty() && getIsolatedCount() == table->size();
+}
+
+/**
+ * @brief Sentman closed-form force on a single flat panel.
+ *
+ * For each species with number density n and mass m the incident Maxwellian
+ * (drift V, temperature T) and the diffuse re-emission with energy accommodation
+ * α at wall temperature T_w give the force per unit area
+ *
+ *   F/A = ½ρ (V c e^{-γ²s²}/√π + V² γ Z) û
+ *       + [¼ρ c² Z + ¼ρ v_re (√π γ V Z + c e^{-γ²s²})] n_in
+ *
+ * with c = √(2kT/m), s = V/c, γ = û·n_in, Z = 1 + erf(γs) and
+ * v_re = √(½[V² + α(4kT_w/m − V²)]). The form stays finite for V → 0.
+ *
+ * α and T_w come from the panel material if a MaterialTable is set (α = 1
+ * for CLL panels, which only have a closed form at full accommodation).
+ * Two-sided panels add the same expression for their back face.
+ *
+ * @param cfg Simulation configuration (flow, species, accommodation, wall temperature).
+ * @param panelId Panel to evaluate.
+ * @return Force acting on the body in [N].
+ */
+Vector3 PanelMethodEngine::computePanelForce(const SimulationConfig& cfg, int panelId) const {
+    int idx = indexOf(panelId);
+    if (idx < 0) return {0, 0, 0};
+
+    const double V = cfg.flowVelocity.norm();
+    const Vector3 u = cfg.flowVelocity.normalize();
+    const TriangleAttributes& tri = (*table)[idx];
+    const int materialId = tri.materialId;
+    const bool hasMaterial = materials && materials->contains(materialId);
+    // CLL mit vollständiger Akkommodation: Maxwell-Verteilung bei T_w, also α = 1
+    const double alpha = surfaceModel == SurfaceModelType::CLL ? 1.0
+                       : hasMaterial ? (*materials)[materialId].energyAccommodation : cfg.energyAccommodation;
+    const double wallTemp = hasMaterial ? (*materials)[materialId].wallTemperature : cfg.WallTemp;
+    const double sqrtPi = std::sqrt(M_PI);
+
+    Vector3 force = {0, 0, 0};
+    for (int side = 0; side < (twoSided[idx] ? 2 : 1); ++side) {
+        const Vector3 nIn = side == 0 ? -tri.normal : tri.normal;
+        const double gamma = u.dot(nIn);
+
+        for (const auto& [_, sp] : cfg.species) {
+            if (sp.mass <= 0.0 || sp.density <= 0.0) continue;
+
+            const double rho = sp.density * sp.mass;
+            const double c = std::sqrt(2.0 * cfg.kB * cfg.temperature / sp.mass);
+            const double s = V / c;
+            const double E = std::exp(-gamma * gamma * s * s);
+            const double Z = 1.0 + std::erf(gamma * s);
+            const double vRe = std::sqrt(std::max(0.0,
+                0.5 * (V * V + alpha * (4.0 * cfg.kB * wallTemp / sp.mass - V * V))));
+
+            double flowTerm = 0.5 * rho * (V * c * E / sqrtPi + V * V * gamma * Z);
+            double normalTerm = 0.25 * rho * c * c * Z
+                              + 0.25 * rho * vRe * (sqrtPi * gamma * V * Z + c * E);
+
+            force += (u * flowTerm + nIn * normalTerm) * tri.area;
+        }
+    }
+    return force;
+}
+
+/**
+ * @brief Closed-form free-molecular heat load on a single flat panel.
+ *
+ * Translational energy flux of the incident drifting Maxwellian minus the
+ * accommodated share of the re-emitted flux (diffuse re-emission at T_w
+ * carries 2kT_w per molecule):
+ *
+ *   q = α ρc³/(4√π) [(s² + 5/2 − 2T_w/T) χ − ½ e^{-γ²s²}],  χ = e^{-γ²s²} + √π γs Z
+ *
+ * with the symbols of computePanelForce. Internal degrees of freedom are
+ * not modelled, matching the ray energies of SurfaceInteractionModel.
+ * Two-sided panels count both faces.
+ *
+ * @param cfg Simulation configuration (flow, species, accommodation, wall temperature).
+ * @param panelId Panel to evaluate.
+ * @return Power transferred to the wall in [W] (negative if the wall is hotter than the flow delivers).
+ */
+double PanelMethodEngine::computePanelHeatLoad(const SimulationConfig& cfg, int panelId) const {
+    int idx = indexOf(panelId);
+    if (idx < 0) return 0.0;
+
+    const double V = cfg.flowVelocity.norm();
+    const Vector3 u = cfg.flowVelocity.normalize();
+    const TriangleAttributes& tri = (*table)[idx];
+    const int materialId = tri.materialId;
+    const bool hasMaterial = materials && materials->contains(materialId);
+    const double alpha = surfaceModel == SurfaceModelType::CLL ? 1.0
+                       : hasMaterial ? (*materials)[materialId].energyAccommodation : cfg.energyAccommodation;
+    const double wallTemp = hasMaterial ? (*materials)[materialId].wallTemperature : cfg.WallTemp;
+    const double sqrtPi = std::sqrt(M_PI);
+
+    double heat = 0.0;
+    for (int side = 0; side < (twoSided[idx] ? 2 : 1); ++side) {
+        const double gamma = side == 0 ? u.dot(-tri.normal) : u.dot(tri.normal);
+
+        for (const auto& [_, sp] : cfg.species) {
+            if (sp.mass <= 0.0 || sp.density <= 0.0) continue;
+
+            const double rho = sp.density * sp.mass;
+            const double c = std::sqrt(2.0 * cfg.kB * cfg.temperature / sp.mass);
+            const double s = V / c;
+            const double E = std::exp(-gamma * gamma * s * s);
+            const double chi = E + sqrtPi * gamma * s * (1.0 + std::erf(gamma * s));
+
+            heat += alpha * rho * c * c * c / (4.0 * sqrtPi)
+                  * ((s * s + 2.5 - 2.0 * wallTemp / cfg.temperature) * chi - 0.5 * E) * tri.area;
+        }
+    }
+    return heat;
+}
+
+Vector3 PanelMethodEngine::getPanelNormal(int panelId) const {
+    int idx = indexOf(panelId);
+    return idx >= 0 ? (*table)[idx].normal : Vector3{0, 0, 0};
+}
+
+Vector3 PanelMethodEngine::getPanelCentroid(int panelId) const {
+    int idx = indexOf(panelId);
+    return idx >= 0 ? (*table)[idx].centroid : Vector3{0, 0, 0};
+}
+
+/**
+ * @brief Sums the closed-form force over all isolated panels.
+ *
+ * @param cfg Simulation configuration.
+ * @param perPanel Optional output, resized to the largest panel ID + 1 and filled
+ *                 with the analytic force per panel (zero for non-isolated panels).
+ * @return Total analytic force acting on the body in [N].
+ */
+Vector3 PanelMethodEngine::computeAnalyticForce(const SimulationConfig& cfg,
+                                                std::vector<Vector3>* perPanel) const {
+    if (perPanel) perPanel->assign(table->panelIdCount(), Vector3{0, 0, 0});
+
+    Vector3 total = {0, 0, 0};
+    for (size_t i = 0; i < table->size(); ++i) {
+        if (!isolated[i]) continue;
+        const int id = (*table)[i].panelId;
+        Vector3 f = computePanelForce(cfg, id);
+        total += f;
+        if (perPanel && id >= 0) (*perPanel)[id] = f;
+    }
+    return total;
+}
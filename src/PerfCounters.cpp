@@ -0,0 +1,90 @@
+#include "PerfCounters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+static int openCounter(uint64_t config, int groupFd) {
+    perf_event_attr attr{};
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.disabled = groupFd < 0 ? 1 : 0;   // nur der Gruppenführer startet deaktiviert
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, 0));
+}
+
+/**
+ * @brief Opens the counter group for the calling thread (pid 0, any CPU).
+ *
+ * All four events must be available; otherwise every descriptor is closed
+ * and the group stays a no-op.
+ */
+PerfCounterGroup::PerfCounterGroup() {
+    const uint64_t events[eventCount] = {
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES
+    };
+
+    for (int i = 0; i < eventCount; ++i) {
+        fds[i] = openCounter(events[i], i == 0 ? -1 : fds[0]);
+        if (fds[i] < 0) {
+            reason = std::string("perf_event_open: ") + std::strerror(errno);
+            for (int k = 0; k < i; ++k) close(fds[k]);
+            for (int& fd : fds) fd = -1;
+            return;
+        }
+    }
+}
+
+PerfCounterGroup::~PerfCounterGroup() {
+    for (int fd : fds)
+        if (fd >= 0) close(fd);
+}
+
+void PerfCounterGroup::start() {
+    if (!available()) return;
+    ioctl(fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+/**
+ * @brief Stops the group and returns the counts since start().
+ *
+ * If the kernel multiplexed the counters, the counts are scaled by
+ * time_enabled / time_running.
+ */
+HardwareCounts PerfCounterGroup::stop() {
+    HardwareCounts c;
+    if (!available()) return c;
+    ioctl(fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+    // Layout bei PERF_FORMAT_GROUP: nr, time_enabled, time_running, values[nr]
+    uint64_t buf[3 + eventCount] = {};
+    if (read(fds[0], buf, sizeof(buf)) < static_cast<ssize_t>(sizeof(buf)) || buf[0] != eventCount)
+        return c;
+
+    const double scale = buf[2] > 0 ? static_cast<double>(buf[1]) / buf[2] : 0.0;
+    auto scaled = [&](int i) { return static_cast<uint64_t>(buf[3 + i] * scale); };
+    c.cycles = scaled(0);
+    c.instructions = scaled(1);
+    c.cacheMisses = scaled(2);
+    c.branchMisses = scaled(3);
+    c.threads = 1;
+    return c;
+}
+
+#else
+
+PerfCounterGroup::PerfCounterGroup() : reason("perf_event_open is only available on Linux") {}
+PerfCounterGroup::~PerfCounterGroup() = default;
+void PerfCounterGroup::start() {}
+HardwareCounts PerfCounterGroup::stop() { return {}; }
+
+#endif
@@ -0,0 +1,285 @@
+#include "RunProfiler.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <sys/resource.h>
+
+/**
+ * @brief Name of a stage as used in the JSON report.
+ */
+const char* stageName(Stage stage) {
+    switch (stage) {
+        case Stage::Config:     return "config";
+        case Stage::MeshLoad:   return "mesh_load";
+        case Stage::AccelBuild: return "accel_build";
+        case Stage::Generation: return "generation";
+        case Stage::Scatter:    return "scatter";
+        case Stage::Intersect:  return "intersect";
+        case Stage::Reflect:    return "reflect";
+        case Stage::Accumulate: return "accumulate";
+        case Stage::Reduce:     return "reduce";
+        case Stage::Export:     return "export";
+        default:                return "unknown";
+    }
+}
+
+/**
+ * @brief Counts one finished ray in the bounce-depth histogram.
+ */
+void ThreadCounters::recordRay(int bounces) {
+    ++rays;
+    ++bounceHistogram[std::clamp(bounces, 0, maxDepth)];
+}
+
+/**
+ * @brief Adds times and counters of another thread (or rank).
+ */
+void ThreadCounters::merge(const ThreadCounters& other) {
+    for (size_t s = 0; s < seconds.size(); ++s) seconds[s] += other.seconds[s];
+    rays += other.rays;
+    intersectCalls += other.intersectCalls;
+    hits += other.hits;
+    hardware.merge(other.hardware);
+    traversal.primitiveTests += other.traversal.primitiveTests;
+    traversal.nodeTests += other.traversal.nodeTests;
+    for (size_t d = 0; d < bounceHistogram.size(); ++d) bounceHistogram[d] += other.bounceHistogram[d];
+}
+
+/**
+ * @brief Writes the summary into packedSize doubles (counters stay exact up to 2^53).
+ */
+void RankSummary::pack(double* out) const {
+    size_t k = 0;
+    for (double s : counters.seconds) out[k++] = s;
+    out[k++] = static_cast<double>(counters.rays);
+    out[k++] = static_cast<double>(counters.intersectCalls);
+    out[k++] = static_cast<double>(counters.hits);
+    out[k++] = static_cast<double>(counters.hardware.cycles);
+    out[k++] = static_cast<double>(counters.hardware.instructions);
+    out[k++] = static_cast<double>(counters.hardware.cacheMisses);
+    out[k++] = static_cast<double>(counters.hardware.branchMisses);
+    out[k++] = static_cast<double>(counters.hardware.threads);
+    out[k++] = static_cast<double>(counters.traversal.primitiveTests);
+    out[k++] = static_cast<double>(counters.traversal.nodeTests);
+    for (uint64_t c : counters.bounceHistogram) out[k++] = static_cast<double>(c);
+    out[k++] = loopSeconds;
+    out[k++] = threadBusyMax;
+    out[k++] = threadBusyMean;
+    out[k++] = maxRssMB;
+    out[k++] = threads;
+}
+
+/**
+ * @brief Inverse of pack().
+ */
+RankSummary RankSummary::unpack(const double* in) {
+    RankSummary r;
+    size_t k = 0;
+    for (double& s : r.counters.seconds) s = in[k++];
+    r.counters.rays = static_cast<uint64_t>(in[k++]);
+    r.counters.intersectCalls = static_cast<uint64_t>(in[k++]);
+    r.counters.hits = static_cast<uint64_t>(in[k++]);
+    r.counters.hardware.cycles = static_cast<uint64_t>(in[k++]);
+    r.counters.hardware.instructions = static_cast<uint64_t>(in[k++]);
+    r.counters.hardware.cacheMisses = static_cast<uint64_t>(in[k++]);
+    r.counters.hardware.branchMisses = static_cast<uint64_t>(in[k++]);
+    r.counters.hardware.threads = static_cast<uint64_t>(in[k++]);
+    r.counters.traversal.primitiveTests = static_cast<uint64_t>(in[k++]);
+    r.counters.traversal.nodeTests = static_cast<uint64_t>(in[k++]);
+    for (uint64_t& c : r.counters.bounceHistogram) c = static_cast<uint64_t>(in[k++]);
+    r.loopSeconds = in[k++];
+    r.threadBusyMax = in[k++];
+    r.threadBusyMean = in[k++];
+    r.maxRssMB = in[k++];
+    r.threads = static_cast<int>(in[k++]);
+    return r;
+}
+
+RunProfiler::RunProfiler(int threads)
+    : threadCounters(std::max(threads, 1)), threadBusy(std::max(threads, 1), 0.0) {}
+
+/**
+ * @brief Merges all thread counters into the rank counters, computes thread
+ *        imbalance and reads the memory high-water mark of the process.
+ */
+RankSummary RunProfiler::summarize() const {
+    RankSummary r;
+    r.counters = rankCounters;
+    for (const auto& t : threadCounters) r.counters.merge(t);
+
+    r.loopSeconds = loopSeconds;
+    r.threads = static_cast<int>(threadBusy.size());
+    r.threadBusyMax = *std::max_element(threadBusy.begin(), threadBusy.end());
+    double sum = 0.0;
+    for (double b : threadBusy) sum += b;
+    r.threadBusyMean = sum / r.threads;
+
+    struct rusage usage {};
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+        r.maxRssMB = usage.ru_maxrss / 1024.0;  // Linux: ru_maxrss in KiB
+    return r;
+}
+
+static std::string jsonString(const std::string& s) {
+    std::ostringstream out;
+    out << '"';
+    for (char c : s) {
+        switch (c) {
+            case '"':  out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\t': out << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                    out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+                else
+                    out << c;
+        }
+    }
+    out << '"';
+    return out.str();
+}
+
+static std::string jsonNumber(double v) {
+    if (!std::isfinite(v)) return "null";
+    std::ostringstream out;
+    out << std::setprecision(10) << v;
+    return out.str();
+}
+
+// Verhältnis max/mittel; 1 = perfekt balanciert
+static double imbalance(double maxValue, double meanValue) {
+    return meanValue > 0.0 ? maxValue / meanValue : 1.0;
+}
+
+void RunReport::set(const std::string& key, const std::string& value) { run[key] = jsonString(value); }
+void RunReport::set(const std::string& key, double value) { run[key] = jsonNumber(value); }
+void RunReport::setResult(const std::string& key, double value) { results[key] = jsonNumber(value); }
+
+/**
+ * @brief Writes the JSON run report.
+ *
+ * Serial stages are reported as the maximum over ranks (critical path); hot-path
+ * stages as summed thread time, since they overlap across threads. Rays per
+ * second use the slowest rank's loop wall time.
+ *
+ * @param filename Output file.
+ * @param ranks One summary per MPI rank (index = rank).
+ * @return true on success.
+ */
+bool RunReport::write(const std::string& filename, const std::vector<RankSummary>& ranks) const {
+    std::ofstream out(filename);
+    if (!out) {
+        std::cerr << "❌ Could not write run report: " << filename << "\n";
+        return false;
+    }
+
+    ThreadCounters total;
+    std::array<double, static_cast<size_t>(Stage::Count)> stageMax{};
+    double loopMax = 0.0, loopSum = 0.0, rssMax = 0.0, rssSum = 0.0;
+    for (const auto& r : ranks) {
+        rssMax = std::max(rssMax, r.maxRssMB);
+        rssSum += r.maxRssMB;
+        total.merge(r.counters);
+        for (size_t s = 0; s < stageMax.size(); ++s) stageMax[s] = std::max(stageMax[s], r.counters.seconds[s]);
+        loopMax = std::max(loopMax, r.loopSeconds);
+        loopSum += r.loopSeconds;
+    }
+    const double rays = static_cast<double>(total.rays);
+    const double calls = static_cast<double>(total.intersectCalls);
+    auto perRay = [&](double v) { return rays > 0.0 ? v / rays : 0.0; };
+
+    auto writeObject = [&](const std::map<std::string, std::string>& m) {
+        out << "{";
+        bool first = true;
+        for (const auto& [k, v] : m) {
+            out << (first ? "" : ", ") << jsonString(k) << ": " << v;
+            first = false;
+        }
+        out << "}";
+    };
+
+    out << "{\n  \"run\": ";
+    writeObject(run);
+
+    out << ",\n  \"stages_s\": {";
+    for (size_t s = 0; s < stageMax.size(); ++s) {
+        Stage st = static_cast<Stage>(s);
+        bool hot = st == Stage::Intersect || st == Stage::Reflect || st == Stage::Accumulate;
+        out << (s ? ", " : "") << jsonString(stageName(st)) << ": "
+            << jsonNumber(hot ? total.seconds[s] : stageMax[s]);
+    }
+    out << "}";
+
+    out << ",\n  \"counters\": {"
+        << "\"rays\": " << total.rays
+        << ", \"rays_per_s\": " << jsonNumber(loopMax > 0.0 ? rays / loopMax : 0.0)
+        << ", \"intersect_calls\": " << total.intersectCalls
+        << ", \"intersect_calls_per_ray\": " << jsonNumber(perRay(calls))
+        << ", \"hits\": " << total.hits
+        << ", \"triangle_tests\": " << total.traversal.primitiveTests
+        << ", \"triangle_tests_per_ray\": " << jsonNumber(perRay(static_cast<double>(total.traversal.primitiveTests)))
+        << ", \"node_tests\": " << total.traversal.nodeTests
+        << ", \"node_tests_per_ray\": " << jsonNumber(perRay(static_cast<double>(total.traversal.nodeTests)))
+        << "}";
+
+    // Hardware-Zähler der Bounce-Schleife; fehlen sie, bleibt der Abschnitt mit available = false
+    const HardwareCounts& hw = total.hardware;
+    const double hitCount = static_cast<double>(total.hits);
+    auto perHit = [&](double v) { return hitCount > 0.0 ? v / hitCount : 0.0; };
+    out << ",\n  \"hardware\": {\"available\": " << (hw.threads > 0 ? "true" : "false")
+        << ", \"threads\": " << hw.threads;
+    if (hw.threads > 0) {
+        const double cyc = static_cast<double>(hw.cycles), ins = static_cast<double>(hw.instructions);
+        const double cm = static_cast<double>(hw.cacheMisses), bm = static_cast<double>(hw.branchMisses);
+        out << ", \"cycles\": " << hw.cycles
+            << ", \"instructions\": " << hw.instructions
+            << ", \"cache_misses\": " << hw.cacheMisses
+            << ", \"branch_misses\": " << hw.branchMisses
+            << ", \"ipc\": " << jsonNumber(cyc > 0.0 ? ins / cyc : 0.0)
+            << ", \"per_ray\": {\"cycles\": " << jsonNumber(perRay(cyc))
+            << ", \"instructions\": " << jsonNumber(perRay(ins))
+            << ", \"cache_misses\": " << jsonNumber(perRay(cm))
+            << ", \"branch_misses\": " << jsonNumber(perRay(bm)) << "}"
+            << ", \"per_hit\": {\"cycles\": " << jsonNumber(perHit(cyc))
+            << ", \"instructions\": " << jsonNumber(perHit(ins))
+            << ", \"cache_misses\": " << jsonNumber(perHit(cm))
+            << ", \"branch_misses\": " << jsonNumber(perHit(bm)) << "}";
+    }
+    out << "}";
+
+    out << ",\n  \"memory\": {\"max_rss_mb_rank_max\": " << jsonNumber(rssMax)
+        << ", \"max_rss_mb_total\": " << jsonNumber(rssSum) << "}";
+
+    out << ",\n  \"bounce_histogram\": [";
+    for (size_t d = 0; d < total.bounceHistogram.size(); ++d)
+        out << (d ? ", " : "") << total.bounceHistogram[d];
+    out << "]";
+
+    const double loopMean = ranks.empty() ? 0.0 : loopSum / ranks.size();
+    out << ",\n  \"imbalance\": {\"rank_max_over_mean\": " << jsonNumber(imbalance(loopMax, loopMean))
+        << ", \"ranks\": [";
+    for (size_t i = 0; i < ranks.size(); ++i) {
+        const auto& r = ranks[i];
+        out << (i ? ", " : "") << "\n    {\"rank\": " << i
+            << ", \"threads\": " << r.threads
+            << ", \"rays\": " << r.counters.rays
+            << ", \"loop_s\": " << jsonNumber(r.loopSeconds)
+            << ", \"thread_busy_max_s\": " << jsonNumber(r.threadBusyMax)
+            << ", \"thread_busy_mean_s\": " << jsonNumber(r.threadBusyMean)
+            << ", \"thread_max_over_mean\": " << jsonNumber(imbalance(r.threadBusyMax, r.threadBusyMean))
+            << ", \"max_rss_mb\": " << jsonNumber(r.maxRssMB)
+            << "}";
+    }
+    out << "]}";
+
+    out << ",\n  \"results\": ";
+    writeObject(results);
+    out << "\n}\n";
+
+    std::cout << "✅ Run report written: " << filename << "\n";
+    return true;
+}
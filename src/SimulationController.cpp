@@ -38,7 +38,7 @@ static Vector3 sampleCosineWeightedDirection(const Vector3& normal) {
     return (ex * x + ey * y + ez * z).normalize();
 }
 
-void SimulationController::setIntersectionEngine(IntersectionEngine* engine) {
+void SimulationController::setIntersectionEngine(const IntersectionEngine* engine) {
     intersectionEngine = engine;
 }
 
@@ -60,19 +60,27 @@ Vector3 SimulationController::getTotalDragForce() const {
 
 /**
  * Generates rays distributed over a bounding box shell aligned with flow direction
+ *
+ * The free stream config.flowVelocity is turned into the body frame with the
+ * attitude set by setAttitude(), so the injection plane and the Maxwellian
+ * follow the attitude while mesh and intersection engine stay untouched.
+ *
  * @param config Configuration parameters
  * @param tris Triangle mesh
  * @param vertices Mesh vertex list
  * @param paddingFraction Padding around bounding box
  * @param rayCount Final number of rays to keep
  * @param totalRayCount Initial number of rays to generate
+ * @param targetPanels Optional panel IDs; if given, the injection window only covers
+ *                     the footprint of these panels (the plane stays upstream of the whole body)
  */
 void SimulationController::generateMixedRays(const SimulationConfig& config,
                                              const std::vector<Triangle>& tris,
                                              const std::vector<Vector3>& vertices,
                                              double paddingFraction,
                                              int rayCount,
-                                             int totalRayCount) {
+                                             int totalRayCount,
+                                             const std::vector<int>* targetPanels) {
     if (!intersectionEngine) {
         std::cerr << "❌ No IntersectionEngine set.\n";
         return;
@@ -85,8 +93,9 @@ void SimulationController::generateMixedRays(const SimulationConfig& config,
         return;
     }
 
-    const Vector3 nFlux = config.flowVelocity.normalize();
-    const double v_mag = config.flowVelocity.norm();
+    const Vector3 flowVelocity = attitude.toBody(config.flowVelocity);
+    const Vector3 nFlux = flowVelocity.normalize();
+    const double v_mag = flowVelocity.norm();
 
     // Construct local coordinate system aligned with flow direction
     Vector3 ex = nFlux;
@@ -115,14 +124,43 @@ void SimulationController::generateMixedRays(const SimulationConfig& config,
     Vector3 bbSize = bbMax - bbMin;
     double diag = bbSize.norm();
 
+    // Optionally restrict the lateral window to the target panels (e.g. coupled panels)
+    Vector3 windowCenter = bbCenter;
+    Vector3 windowSize = bbSize;
+    if (targetPanels && !targetPanels->empty()) {
+        std::vector<char> isTarget;
+        for (int id : *targetPanels) {
+            if (id < 0) continue;
+            if (static_cast<size_t>(id) >= isTarget.size()) isTarget.resize(id + 1, 0);
+            isTarget[id] = 1;
+        }
+
+        Vector3 tMin = bbMax, tMax = bbMin;
+        for (const auto& tri : tris) {
+            if (tri.panelId < 0 || static_cast<size_t>(tri.panelId) >= isTarget.size() ||
+                !isTarget[tri.panelId]) continue;
+            for (int vi : {tri.v1, tri.v2, tri.v3}) {
+                tMin = Vector3::min(tMin, vertices[vi]);
+                tMax = Vector3::max(tMax, vertices[vi]);
+            }
+        }
+        windowCenter = (tMin + tMax) * 0.5;
+        windowSize = tMax - tMin;
+    }
+
     // Compute dimensions for shell injection surface
     double flowPadding = 1 * diag;
     double sidePadding = 0.05 * diag;
 
-    double halfU = 0.5 * std::abs(bbSize.dot(ey)) + sidePadding;
-    double halfV = 0.5 * std::abs(bbSize.dot(ez)) + sidePadding;
+    // Projizierte Ausdehnung der Box (Summe der Achsenanteile, nicht nur die Diagonale)
+    auto extent = [&](const Vector3& axis) {
+        return std::abs(windowSize.x * axis.x) + std::abs(windowSize.y * axis.y) + std::abs(windowSize.z * axis.z);
+    };
+    double halfU = 0.5 * extent(ey) + sidePadding;
+    double halfV = 0.5 * extent(ez) + sidePadding;
 
-    Vector3 centerFlux = bbCenter - ex * flowPadding;
+    Vector3 lateralShift = ey * (windowCenter - bbCenter).dot(ey) + ez * (windowCenter - bbCenter).dot(ez);
+    Vector3 centerFlux = bbCenter + lateralShift - ex * flowPadding;
     double A_flux = 4.0 * halfU * halfV;
 
     this->setRaySourceArea(A_flux);
@@ -138,14 +176,17 @@ void SimulationController::generateMixedRays(const SimulationConfig& config,
     std::uniform_real_distribution<double> uni01(0.0, 1.0);
 
     // Ray generation per species
+    int speciesId = -1;
     for (auto& [name, sp] : config.species) {
+        ++speciesId;
         if (sp.mass <= 0.0 || sp.density <= 0.0) continue;
 
         int Nsp = std::round(totalRayCount * (sp.density / sumDensity));
         if (Nsp <= 0) continue;
-        std::cout << "Nsp of " << name << ": " << Nsp << "\n";
+        if (verbose) std::cout << "Nsp of " << name << ": " << Nsp << "\n";
 
-        MaxwellSampler sampler(config.temperature, sp.mass, config.flowVelocity);
+        MaxwellSampler sampler(config.temperature, sp.mass, flowVelocity,
+                               config.seed >= 0 ? config.seed + speciesId : -1);
 
         for (int i = 0; i < Nsp; ++i) {
             double u = (uni01(rng) * 2.0 - 1.0) * halfU;
@@ -168,7 +209,7 @@ void SimulationController::generateMixedRays(const SimulationConfig& config,
             ray.momentum = v_sample * sp.mass;
             ray.speciesMass = sp.mass;
             ray.speciesDensity = sp.density;
-            ray.speciesName = name;
+            ray.speciesId = speciesId;
             ray.weight = weight;
             ray.panelId = -1;
 
@@ -177,15 +218,17 @@ void SimulationController::generateMixedRays(const SimulationConfig& config,
     }
 
     // Normalize to requested ray count
+    if (tmpRays.empty()) return;
     if (tmpRays.size() > static_cast<size_t>(rayCount))
         tmpRays.resize(rayCount);
     while (tmpRays.size() < static_cast<size_t>(rayCount))
         tmpRays.push_back(tmpRays[tmpRays.size() % tmpRays.size()]);
 
     rays = std::move(tmpRays);
-    exportRayFieldVTK("ray_debug.vtk", tris, vertices);
-
-    std::cout << "✅ Rays generated: " << rays.size() << "\n";
+    if (verbose) {
+        exportRayFieldVTK("ray_debug.vtk", tris, vertices);
+        std::cout << "✅ Rays generated: " << rays.size() << "\n";
+    }
 }
 
 // === Additional utility functions ===
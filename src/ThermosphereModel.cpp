@@ -0,0 +1,192 @@
+#include "ThermosphereModel.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr double earthRadius = 6356.766;    // [km], Bezugsradius der geopotentiellen Höhe (US76)
+    constexpr double g0 = 9.80665;              // [m/s²]
+    constexpr double kB = 1.380649e-23;
+    constexpr double amu = 1.66053906660e-27;   // [kg]
+    constexpr double deg = M_PI / 180.0;
+
+    // Untere Randbedingung (US76, 120 km)
+    constexpr double zLower = 120.0;            // [km]
+    constexpr double tLower = 360.0;            // [K]
+    constexpr double gradLower = 12.0;          // dT/dz [K/km]
+    constexpr double zHydrogen = 500.0;         // [km], Bezugshöhe des Wasserstoffs (Jacchia)
+
+    // Diffusiv verteilte Spezies in der Reihenfolge von AtmosphereTable::speciesNames (N2, O2, O, HE, H, AR)
+    constexpr int modelSpecies = 6;
+    constexpr double speciesMass[AtmosphereTable::speciesCount] = {   // [u]
+        28.0134, 31.9988, 15.9994, 4.0026, 1.00797, 39.948, 14.0067, 15.9994, 30.0061};
+    constexpr double lowerDensity[modelSpecies] = {3.726e17, 4.297e16, 9.275e16, 3.4e13, 0.0, 1.13e15};   // [1/m³]
+    // ln n(120 km); Wasserstoff wird ab 500 km gerechnet
+    const double lnLowerDensity[modelSpecies] = {std::log(lowerDensity[0]), std::log(lowerDensity[1]),
+                                                 std::log(lowerDensity[2]), std::log(lowerDensity[3]), 0.0,
+                                                 std::log(lowerDensity[5])};
+    const double lnTLower = std::log(tLower);
+    const double gLower = g0 * (earthRadius / (earthRadius + zLower)) * (earthRadius / (earthRadius + zLower));
+    constexpr double thermalDiffusion[modelSpecies] = {0.0, 0.0, 0.0, -0.40, -0.25, 0.0};
+    constexpr int hydrogen = 4;
+
+    // Geopotentielle Höhe über der unteren Grenze [km]
+    inline double geopotential(double z) { return (z - zLower) * (earthRadius + zLower) / (earthRadius + z); }
+
+    /**
+     * Temperature and number densities at one point: Bates profile from
+     * 120 km to T∞, diffusive equilibrium n ∝ (T_ref/T)^(1+α+γ) e^(−sγ(ζ−ζ_ref))
+     * with γ = m g(120 km) / (s k T∞), all times the semiannual factor
+     * (given as its logarithm).
+     */
+    inline void profile(double z, double tInf, double lnFactor, double& temperature,
+                        double n[AtmosphereTable::speciesCount]) {
+        z = std::max(z, zLower);
+        const double s = gradLower / (tInf - tLower);                                   // [1/km]
+        const double zeta = geopotential(z);
+        const double t = tInf - (tInf - tLower) * std::exp(-s * zeta);
+        temperature = t;
+
+        // Wasserstoff: Dichte bei 500 km nach Jacchia (1971), log10 n [cm⁻³] = 73.13 − 39.4 L + 5.5 L²
+        const double L = std::log10(tInf);
+        const double zetaH = geopotential(zHydrogen);
+        const double tH = tInf - (tInf - tLower) * std::exp(-s * zetaH);
+        const double lnH = M_LN10 * (73.13 - 39.4 * L + 5.5 * L * L + 6.0);
+
+        const double lnT = std::log(t), lnTH = std::log(tH);
+        const double gammaPerMass = amu * gLower * 1e3 / (s * kB * tInf);   // γ je u
+        for (int k = 0; k < modelSpecies; ++k) {
+            const double gamma = speciesMass[k] * gammaPerMass;
+            const bool isH = (k == hydrogen);
+            const double lnRef = isH ? lnH : lnLowerDensity[k];
+            const double lnTRef = isH ? lnTH : lnTLower;
+            const double zetaRef = isH ? zetaH : 0.0;
+            n[k] = std::exp(lnFactor + lnRef - (1.0 + thermalDiffusion[k] + gamma) * (lnT - lnTRef) -
+                            s * gamma * (zeta - zetaRef));
+        }
+        for (int k = modelSpecies; k < AtmosphereTable::speciesCount; ++k) n[k] = 0.0;
+    }
+
+    inline double exosphericTemperatureAt(double lat, double lon, double doy, double ut, double f107,
+                                          double f107a, double ap) {
+        // Nachttemperatur am Äquator (Jacchia 1970)
+        const double tc = 379.0 + 3.24 * f107a + 1.3 * (f107 - f107a);
+
+        // Tagesgang: Deklination, Stundenwinkel der Sonne, Phasenverschiebung des Maximums (~14 h Ortszeit)
+        const double day = doy + ut / 86400.0;
+        const double declination = std::asin(std::sin(23.44 * deg) * std::sin(2.0 * M_PI * (day - 80.0) / 365.25));
+        const double hourAngle = (ut / 3600.0 + lon / 15.0 - 12.0) * M_PI / 12.0;
+        const double tau = std::remainder(hourAngle - 37.0 * deg + 6.0 * deg * std::sin(hourAngle + 43.0 * deg),
+                                          2.0 * M_PI);
+        const double phi = lat * deg;
+        const double theta = 0.5 * std::abs(phi + declination);
+        const double eta = 0.5 * std::abs(phi - declination);
+        constexpr double R = 0.3, m = 2.2;
+        const double sinTheta = std::pow(std::sin(theta), m);
+        const double cosTau = std::cos(0.5 * tau);
+        const double tl = tc * (1.0 + R * sinTheta + R * (std::pow(std::cos(eta), m) - sinTheta) * cosTau * cosTau * cosTau);
+
+        // Geomagnetische Aufheizung aus Ap
+        return tl + ap + 100.0 * (1.0 - std::exp(-0.08 * ap));
+    }
+
+    // Jacchia (1971): Δlog10 ρ = f(z) g(t), hier als natürlicher Logarithmus des Faktors
+    inline double semiannualLnFactor(double z, double doy, double ut) {
+        z = std::max(z, zLower);
+        const double phase = (doy - 1.0 + ut / 86400.0) / 365.2422;
+        const double tau = phase + 0.09544 * (std::pow(0.5 + 0.5 * std::sin(2.0 * M_PI * phase + 6.035), 1.65) - 0.5);
+        const double g = 0.02835 + (0.3817 + 0.17829 * std::sin(2.0 * M_PI * tau + 4.137)) *
+                                       std::sin(4.0 * M_PI * tau + 4.259);
+        const double f = (5.876e-7 * std::pow(z, 2.331) + 0.06328) * std::exp(-0.002868 * z);
+        return M_LN10 * f * g;
+    }
+
+    inline double massDensityOf(const double n[AtmosphereTable::speciesCount]) {
+        double rho = 0.0;
+        for (int k = 0; k < AtmosphereTable::speciesCount; ++k) rho += n[k] * speciesMass[k] * amu;
+        return rho;
+    }
+}
+
+void ThermosphereBatch::push_back(const ThermosphereInput& point) {
+    altitude.push_back(point.altitude);
+    latitude.push_back(point.latitude);
+    longitude.push_back(point.longitude);
+    dayOfYear.push_back(point.dayOfYear);
+    utSeconds.push_back(point.utSeconds);
+    f107.push_back(point.f107);
+    f107a.push_back(point.f107a);
+    ap.push_back(point.ap);
+}
+
+AtmosphereState ThermosphereBatch::state(size_t i) const {
+    AtmosphereState s;
+    s.temperature = temperature[i];
+    s.massDensity = massDensity[i];
+    for (int k = 0; k < AtmosphereTable::speciesCount; ++k) s.densities[k] = densities[k][i];
+    return s;
+}
+
+double ThermosphereModel::exosphericTemperature(const ThermosphereInput& p) {
+    return exosphericTemperatureAt(p.latitude, p.longitude, p.dayOfYear, p.utSeconds, p.f107, p.f107a, p.ap);
+}
+
+double ThermosphereModel::semiannualFactor(double altitude, double dayOfYear, double utSeconds) {
+    return std::exp(semiannualLnFactor(altitude, dayOfYear, utSeconds));
+}
+
+AtmosphereState ThermosphereModel::diffusiveProfile(double altitude, double exosphericTemperature) {
+    AtmosphereState s;
+    profile(altitude, exosphericTemperature, 0.0, s.temperature, s.densities.data());
+    s.massDensity = massDensityOf(s.densities.data());
+    return s;
+}
+
+/**
+ * @brief Temperature, species number densities and mass density at one point.
+ *
+ * Altitudes below 120 km return the values of the lower boundary. The
+ * dynamic pressure stays zero; it depends on the vehicle speed.
+ */
+AtmosphereState ThermosphereModel::evaluate(const ThermosphereInput& p) const {
+    AtmosphereState s;
+    const double tInf = exosphericTemperature(p);
+    profile(p.altitude, tInf, semiannualLnFactor(p.altitude, p.dayOfYear, p.utSeconds), s.temperature,
+            s.densities.data());
+    s.massDensity = massDensityOf(s.densities.data());
+    return s;
+}
+
+/**
+ * @brief Evaluates every point of the batch (e.g. the points of an orbit).
+ *
+ * Inputs and outputs are separate columns. Each point is independent and
+ * branch-free; the loop is split across the OpenMP threads and marked simd,
+ * which vectorizes where the math library has vector exp/log/pow.
+ *
+ * @param batch Input columns of equal length; the result columns are resized.
+ */
+void ThermosphereModel::evaluate(ThermosphereBatch& batch) const {
+    const long n = static_cast<long>(batch.size());
+    batch.temperature.resize(n);
+    batch.exosphericTemperature.resize(n);
+    batch.massDensity.resize(n);
+    for (auto& column : batch.densities) column.resize(n);
+
+    const double *alt = batch.altitude.data(), *lat = batch.latitude.data(), *lon = batch.longitude.data(),
+                 *doy = batch.dayOfYear.data(), *ut = batch.utSeconds.data(), *f107 = batch.f107.data(),
+                 *f107a = batch.f107a.data(), *ap = batch.ap.data();
+    double *temperature = batch.temperature.data(), *tInf = batch.exosphericTemperature.data(),
+           *rho = batch.massDensity.data();
+    std::array<double*, AtmosphereTable::speciesCount> density;
+    for (int k = 0; k < AtmosphereTable::speciesCount; ++k) density[k] = batch.densities[k].data();
+
+    #pragma omp parallel for simd schedule(static)
+    for (long i = 0; i < n; ++i) {
+        const double t = exosphericTemperatureAt(lat[i], lon[i], doy[i], ut[i], f107[i], f107a[i], ap[i]);
+        double nd[AtmosphereTable::speciesCount];
+        profile(alt[i], t, semiannualLnFactor(alt[i], doy[i], ut[i]), temperature[i], nd);
+        tInf[i] = t;
+        rho[i] = massDensityOf(nd);
+        for (int k = 0; k < AtmosphereTable::speciesCount; ++k) density[k][i] = nd[k];
+    }
+}
@@ -0,0 +1,114 @@
+#include "TraceRecorder.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+/**
+ * @brief Allocates one ring buffer per thread and starts recording.
+ *
+ * @param threads Number of threads that will record (thread IDs 0 … threads−1).
+ * @param eventsPerThread Ring buffer capacity per thread.
+ */
+void TraceRecorder::enable(int threads, size_t eventsPerThread) {
+    buffers.assign(std::max(threads, 1), ThreadBuffer{});
+    for (auto& b : buffers) b.events.resize(std::max<size_t>(eventsPerThread, 1));
+    enabled = true;
+}
+
+/**
+ * @brief Stores one event in the ring buffer of thread tid (owning thread only).
+ */
+void TraceRecorder::record(int tid, const char* name, const char* category,
+                           StageClock::time_point begin, StageClock::time_point end, int64_t arg) {
+    if (!enabled || tid < 0 || static_cast<size_t>(tid) >= buffers.size()) return;
+
+    ThreadBuffer& b = buffers[tid];
+    TraceEvent& e = b.events[b.written % b.events.size()];
+    e.name = name;
+    e.category = category;
+    e.beginNs = std::chrono::duration_cast<std::chrono::nanoseconds>(begin - epoch).count();
+    e.endNs = std::chrono::duration_cast<std::chrono::nanoseconds>(end - epoch).count();
+    e.arg = arg;
+    ++b.written;
+}
+
+/**
+ * @brief Number of events lost because a ring buffer wrapped around.
+ */
+uint64_t TraceRecorder::droppedEvents() const {
+    uint64_t dropped = 0;
+    for (const auto& b : buffers)
+        if (b.written > b.events.size()) dropped += b.written - b.events.size();
+    return dropped;
+}
+
+/**
+ * @brief Serialises the events of this rank as Chrome trace "complete" events.
+ *
+ * pid is the MPI rank and tid the OpenMP thread; metadata events name both
+ * tracks. Timestamps are in microseconds since the common epoch.
+ *
+ * @param rank MPI rank of this process.
+ * @return Comma-separated JSON objects (empty if tracing is disabled).
+ */
+std::string TraceRecorder::serialize(int rank) const {
+    if (!enabled) return "";
+
+    std::ostringstream out;
+    out.precision(3);
+    out << std::fixed;
+
+    out << "{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":" << rank
+        << ",\"args\":{\"name\":\"rank " << rank << "\"}}";
+    out << ",\n{\"ph\":\"M\",\"name\":\"process_sort_index\",\"pid\":" << rank
+        << ",\"args\":{\"sort_index\":" << rank << "}}";
+
+    for (size_t tid = 0; tid < buffers.size(); ++tid) {
+        const ThreadBuffer& b = buffers[tid];
+        out << ",\n{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":" << rank << ",\"tid\":" << tid
+            << ",\"args\":{\"name\":\"thread " << tid << "\"}}";
+
+        // Älteste noch vorhandene Ereignisse zuerst
+        const size_t cap = b.events.size();
+        const uint64_t first = b.written > cap ? b.written - cap : 0;
+        for (uint64_t k = first; k < b.written; ++k) {
+            const TraceEvent& e = b.events[k % cap];
+            out << ",\n{\"ph\":\"X\",\"name\":\"" << e.name << "\",\"cat\":\"" << e.category
+                << "\",\"pid\":" << rank << ",\"tid\":" << tid
+                << ",\"ts\":" << e.beginNs * 1e-3
+                << ",\"dur\":" << std::max<int64_t>(e.endNs - e.beginNs, 0) * 1e-3;
+            if (e.arg >= 0) out << ",\"args\":{\"first\":" << e.arg << "}";
+            out << "}";
+        }
+    }
+    return out.str();
+}
+
+/**
+ * @brief Writes the merged trace of all ranks (open in chrome://tracing or ui.perfetto.dev).
+ *
+ * @param filename Output JSON file.
+ * @param rankEvents Output of serialize() for every rank.
+ * @return true on success.
+ */
+bool TraceRecorder::writeChromeTrace(const std::string& filename, const std::vector<std::string>& rankEvents) {
+    std::ofstream out(filename);
+    if (!out) {
+        std::cerr << "❌ Could not write trace file: " << filename << "\n";
+        return false;
+    }
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    for (const auto& events : rankEvents) {
+        if (events.empty()) continue;
+        if (!first) out << ",\n";
+        out << events;
+        first = false;
+    }
+    out << "\n]}\n";
+
+    std::cout << "✅ Chrome trace written: " << filename << "\n";
+    return true;
+}
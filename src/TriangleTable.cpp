@@ -0,0 +1,104 @@
+#include "TriangleTable.h"
+#include <algorithm>
+
+/**
+ * @brief Precomputes corners, edges, unit normal, area and centroid of every triangle.
+ *
+ * The normal follows the stored winding (outward after MeshLoader's correction).
+ *
+ * @param vertices Vertex coordinates.
+ * @param triangles Triangles with panel and material IDs.
+ */
+TriangleTable::TriangleTable(const std::vector<Vector3>& vertices, const std::vector<Triangle>& triangles) {
+    rows.resize(triangles.size());
+    const long n = static_cast<long>(triangles.size());
+
+    #pragma omp parallel for schedule(static)
+    for (long i = 0; i < n; ++i) {
+        const Triangle& t = triangles[i];
+        TriangleAttributes& r = rows[i];
+        r.p0 = vertices[t.v1];
+        r.p1 = vertices[t.v2];
+        r.p2 = vertices[t.v3];
+        r.edge1 = r.p1 - r.p0;
+        r.edge2 = r.p2 - r.p0;
+        const Vector3 c = r.edge1.cross(r.edge2);
+        r.normal = c.normalize();
+        r.area = 0.5 * c.norm();
+        r.centroid = (r.p0 + r.p1 + r.p2) * (1.0 / 3.0);
+        r.panelId = t.panelId;
+        r.materialId = t.materialId;
+        r.bodyId = t.bodyId;
+    }
+    computeSummary();
+}
+
+void TriangleTable::computeSummary() {
+    int maxId = -1;
+    totalArea = 0.0;
+    if (!rows.empty()) boundsMin = boundsMax = rows[0].p0;
+    for (const auto& r : rows) {
+        totalArea += r.area;
+        maxId = std::max(maxId, r.panelId);
+        for (const Vector3* p : {&r.p0, &r.p1, &r.p2}) {
+            boundsMin = Vector3::min(boundsMin, *p);
+            boundsMax = Vector3::max(boundsMax, *p);
+        }
+    }
+
+    panelIndex.assign(static_cast<size_t>(maxId + 1), -1);
+    for (size_t i = 0; i < rows.size(); ++i) {
+        if (rows[i].panelId >= 0) panelIndex[rows[i].panelId] = static_cast<int>(i);
+    }
+}
+
+std::shared_ptr<const TriangleTable> TriangleTable::build(const std::vector<Vector3>& vertices,
+                                                          const std::vector<Triangle>& triangles) {
+    return std::make_shared<const TriangleTable>(vertices, triangles);
+}
+
+/**
+ * @brief Copy of the table with rigid sub-bodies moved.
+ *
+ * Rows of bodies without a transform (or with the identity) are copied as
+ * they are; the others get their corners and centroid moved and edges and
+ * normal rotated. Areas and panel IDs do not change.
+ *
+ * @param source Table in the loaded position.
+ * @param bodyTransforms Transform per body ID, relative to the rows of source.
+ * @return New immutable table, or source itself if every transform is the identity.
+ */
+std::shared_ptr<const TriangleTable> TriangleTable::posed(std::shared_ptr<const TriangleTable> source,
+                                                          const std::vector<RigidTransform>& bodyTransforms) {
+    if (std::all_of(bodyTransforms.begin(), bodyTransforms.end(),
+                    [](const RigidTransform& T) { return T.isIdentity(); }))
+        return source;
+
+    auto table = std::make_shared<TriangleTable>(*source);
+    const long n = static_cast<long>(table->rows.size());
+
+    #pragma omp parallel for schedule(static)
+    for (long i = 0; i < n; ++i) {
+        TriangleAttributes& r = table->rows[i];
+        if (r.bodyId < 0 || static_cast<size_t>(r.bodyId) >= bodyTransforms.size()) continue;
+        const RigidTransform& T = bodyTransforms[r.bodyId];
+        if (T.isIdentity()) continue;
+        r.p0 = T.apply(r.p0);
+        r.p1 = T.apply(r.p1);
+        r.p2 = T.apply(r.p2);
+        r.edge1 = T.rotate(r.edge1);
+        r.edge2 = T.rotate(r.edge2);
+        r.normal = T.rotate(r.normal);
+        r.centroid = T.apply(r.centroid);
+    }
+    table->computeSummary();
+    return table;
+}
+
+std::vector<double> TriangleTable::areasByPanel() const {
+    std::vector<double> areas(panelIndex.size(), 0.0);
+    for (const auto& r : rows) {
+        if (r.panelId >= 0) areas[r.panelId] = r.area;
+    }
+    return areas;
+}
@@ -0,0 +1,40 @@
+#include <iostream>
+#include <string>
+
+#include "AeroDatabase.h"
+#include "ConfigLoader.h"
+#include "DragSolver.h"
+#include "RunProfiler.h"
+
+/**
+ * Offline generator for the aerodynamic coefficient table.
+ *
+ * Usage: AeroDatabaseGenerator [config.ini] [output.adb]
+ *
+ * Geometry, surface model, solver, ray count and species mix come from the
+ * configuration; the grid from databaseAoA, databaseSideslip,
+ * databaseSpeedRatio and databaseTemperatureRatio.
+ */
+int main(int argc, char** argv) {
+    const std::string configPath = argc > 1 ? argv[1] : "config.ini";
+
+    ConfigLoader loader;
+    if (!loader.loadFromFile(configPath)) return 1;
+    const SimulationConfig& cfg = loader.getConfig();
+    const std::string output = argc > 2 ? argv[2] : cfg.databaseFile;
+
+    DragSolver solver(cfg);
+    if (!solver.loadMesh(cfg.geometryFile)) return 1;
+
+    const auto start = StageClock::now();
+    AeroDatabase db;
+    if (!db.generate(solver, cfg)) {
+        std::cerr << "❌ Aero database generation failed\n";
+        return 1;
+    }
+    const double seconds = secondsSince(start);
+    std::cout << "✔️  " << db.getNodeCount() << " nodes in " << seconds << " s ("
+              << (solver.getCoupledPanelCount() > 0 ? cfg.rayCount : 0) << " rays per node)\n";
+
+    return db.save(output) ? 0 : 1;
+}
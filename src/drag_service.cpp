@@ -0,0 +1,193 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <csignal>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "ConfigLoader.h"
+#include "DragService.h"
+
+static volatile std::sig_atomic_t stopRequested = 0;
+
+static void onSignal(int) { stopRequested = 1; }
+
+/// Ab dieser Menge unversendeter Antworten liest der Dienst von diesem Client nichts mehr
+static constexpr size_t maxPendingOutput = 1 << 20;
+
+/// Längste zulässige Anfragezeile; längere Zeilen beenden die Verbindung mit einer Fehlermeldung
+static constexpr size_t maxLineLength = 1 << 16;
+
+/// Client connection with its partially received line and its unsent replies
+struct Client {
+    int fd;
+    std::string inbox;
+    std::string outbox;
+    bool eof = false;        // Client hat fertig gesendet; schließen, sobald outbox leer ist
+    bool discard = false;    // nach zu langer Zeile: Eingang verwerfen, nach dem Senden Schreibseite schließen
+    bool writeShut = false;
+};
+
+/// Send as much of the outbox as the socket takes without blocking
+static bool flushOutbox(Client& c) {
+    while (!c.outbox.empty()) {
+        ssize_t n = send(c.fd, c.outbox.data(), c.outbox.size(), MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return true;   // Rest in der nächsten Runde
+        if (n <= 0) return false;
+        c.outbox.erase(0, static_cast<size_t>(n));
+    }
+    return true;
+}
+
+/**
+ * Drag daemon: keeps geometries resident and answers line requests on a Unix socket.
+ *
+ * Usage: DragService <socket> [config.ini] [id=path.obj ...]
+ *
+ * All complete lines that arrive from all clients in one poll round are
+ * answered as one batch, so concurrent clients share the OpenMP threads.
+ * Client sockets are non-blocking: replies wait in a per-client outbox until
+ * the socket accepts them, so a slow reader never stalls the others.
+ * A request line longer than maxLineLength is answered with an ERR line; the
+ * service then discards the client's input, shuts down its write side and
+ * closes the connection at the client's EOF, so no inbox grows unbounded and
+ * the error is not lost to a connection reset.
+ */
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: DragService <socket> [config.ini] [id=path.obj ...]\n";
+        return 1;
+    }
+    const std::string socketPath = argv[1];
+    const std::string configPath = argc > 2 ? argv[2] : "config.ini";
+
+    ConfigLoader loader;
+    if (!loader.loadFromFile(configPath)) return 1;   // lehnt u. a. serviceQuantization <= 0 ab
+    DragService service(loader.getConfig());
+
+    for (int i = 3; i < argc; ++i) {
+        std::string arg = argv[i];
+        size_t eq = arg.find('=');
+        std::string id = eq == std::string::npos ? arg : arg.substr(0, eq);
+        std::string path = eq == std::string::npos ? arg : arg.substr(eq + 1);
+        if (!service.addGeometry(id, path)) return 1;
+    }
+
+    int server = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (server < 0 || socketPath.size() >= sizeof(addr.sun_path)) {
+        std::cerr << "❌ Invalid socket path: " << socketPath << "\n";
+        return 1;
+    }
+    std::strncpy(addr.sun_path, socketPath.c_str(), sizeof(addr.sun_path) - 1);
+    unlink(socketPath.c_str());
+    if (bind(server, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 || listen(server, 64) < 0) {
+        std::cerr << "❌ Could not listen on " << socketPath << ": " << std::strerror(errno) << "\n";
+        return 1;
+    }
+
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+    std::cout << "✅ DragService listening on " << socketPath << "\n";
+
+    std::vector<Client> clients;
+    while (!stopRequested) {
+        std::vector<pollfd> fds;
+        fds.push_back({server, POLLIN, 0});
+        for (const auto& c : clients) {
+            short events = !c.eof && c.outbox.size() < maxPendingOutput ? POLLIN : 0;   // Gegendruck bei vollem Ausgang
+            if (!c.outbox.empty()) events |= POLLOUT;
+            fds.push_back({c.fd, events, 0});
+        }
+
+        if (poll(fds.data(), fds.size(), 500) < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "❌ poll: " << std::strerror(errno) << "\n";
+            break;
+        }
+
+        if (fds[0].revents & POLLIN) {
+            int fd = accept(server, nullptr, nullptr);
+            if (fd >= 0 && fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK) == 0) clients.push_back({fd, "", "", false});
+            else if (fd >= 0) close(fd);
+        }
+
+        // Vollständige Zeilen aller Clients dieser Runde sammeln
+        std::vector<std::string> lines;
+        std::vector<size_t> owner;
+        std::vector<char> closed(clients.size(), 0);
+        std::vector<char> overlong(clients.size(), 0);
+        for (size_t k = 0; k < clients.size() && k + 1 < fds.size(); ++k) {
+            if (!(fds[k + 1].events & POLLIN) || !(fds[k + 1].revents & (POLLIN | POLLHUP | POLLERR))) continue;
+
+            char buf[65536];
+            ssize_t n = recv(clients[k].fd, buf, sizeof(buf), 0);
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) continue;
+            if (n == 0) clients[k].eof = true;
+            if (n <= 0) {
+                closed[k] = n < 0;
+                continue;
+            }
+            if (clients[k].discard) continue;
+            clients[k].inbox.append(buf, static_cast<size_t>(n));
+
+            size_t pos;
+            while ((pos = clients[k].inbox.find('\n')) != std::string::npos && pos <= maxLineLength) {
+                lines.push_back(clients[k].inbox.substr(0, pos));
+                owner.push_back(k);
+                clients[k].inbox.erase(0, pos + 1);
+            }
+
+            // Zu lange Zeile (vollständig oder noch offen): keine weiteren Anfragen dieses Clients
+            if (clients[k].inbox.size() > maxLineLength) {
+                overlong[k] = 1;
+                clients[k].inbox.clear();
+                clients[k].discard = true;
+            }
+        }
+
+        // Alle Zeilen als ein Batch; leere Antworten (Kommentare, Leerzeilen) entfallen
+        if (!lines.empty()) {
+            std::vector<std::string> replies = service.handleLines(lines);
+            for (size_t i = 0; i < lines.size(); ++i)
+                if (!replies[i].empty()) clients[owner[i]].outbox += replies[i] + "\n";
+        }
+        for (size_t k = 0; k < clients.size(); ++k)
+            if (overlong[k])
+                clients[k].outbox += "ERR request line too long (max " + std::to_string(maxLineLength) + " bytes)\n";
+
+        // Ausstehende Antworten ohne Blockieren senden (auch ohne neue Zeilen, sobald POLLOUT meldet)
+        for (size_t k = 0; k < clients.size(); ++k) {
+            Client& c = clients[k];
+            if (closed[k]) continue;
+            if (!flushOutbox(c) || (c.eof && c.outbox.empty())) {
+                closed[k] = 1;
+            } else if (c.discard && c.outbox.empty() && !c.writeShut) {
+                shutdown(c.fd, SHUT_WR);   // Fehlermeldung ist raus; Client sieht EOF und schließt
+                c.writeShut = true;
+            }
+        }
+
+        for (size_t k = clients.size(); k-- > 0;) {
+            if (!closed[k]) continue;
+            close(clients[k].fd);
+            clients.erase(clients.begin() + k);
+        }
+    }
+
+    for (const auto& c : clients) close(c.fd);
+    close(server);
+    unlink(socketPath.c_str());
+
+    const DragServiceStats& s = service.getStats();
+    std::cout << "✅ DragService stopped: " << s.requests << " requests, " << s.cacheHits
+              << " cache hits, " << s.computed << " computed in " << s.batches << " batches\n";
+    return 0;
+}
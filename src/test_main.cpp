@@ -9,14 +9,24 @@
 #include <omp.h>
 #include <algorithm>
 #include <atomic>
+#include <optional>
+#include <array>
 
 #include "MeshLoader.h"
 #include "SimulationController.h"
 #include "IntersectionEngine.h"
 #include "SurfaceInteractionModel.h"
+#include "BounceKernel.h"
 #include "ConfigLoader.h"
 #include "HeatmapExporter.h"
 #include "DragForceCalculator.h"
+#include "PanelMethodEngine.h"
+#include "RunProfiler.h"
+#include "TraceRecorder.h"
+#include "PerfCounters.h"
+#include "Attitude.h"
+#include "AtmosphereTable.h"
+#include "ThermosphereModel.h"
 #include "Vector3.h"
 #include "Ray.h"
 #include "Triangle.h"
@@ -31,22 +41,17 @@ struct MPI_RayData {
     int panelId;
 };
 
-/// Compute the area of a triangle given its vertices
-inline double computeTriangleArea(const Vector3& a, const Vector3& b, const Vector3& c) {
-    return 0.5 * (b - a).cross(c - a).norm();
-}
-
 int main(int argc, char** argv) {
     MPI_Init(&argc, &argv);
 
     // --- MPI Struct for RayMPI
     MPI_Datatype MPI_RayMPI_Type;
-    int blockLengths[] = { 3, 3, 3, 3, 1, 1, 1, 32, 1, 1, 1 };
+    int blockLengths[] = { 3, 3, 3, 3, 1, 1, 1, 1, 1, 1, 1 };
     MPI_Aint displacements[12];
     MPI_Datatype types[] = {
         MPI_DOUBLE, MPI_DOUBLE, MPI_DOUBLE, MPI_DOUBLE,
         MPI_DOUBLE, MPI_DOUBLE, MPI_DOUBLE,
-        MPI_CHAR,
+        MPI_INT,
         MPI_C_BOOL,
         MPI_DOUBLE,
         MPI_INT
@@ -58,7 +63,7 @@ int main(int argc, char** argv) {
     displacements[4] = offsetof(RayMPI, energy);
     displacements[5] = offsetof(RayMPI, speciesMass);
     displacements[6] = offsetof(RayMPI, speciesDensity);
-    displacements[7] = offsetof(RayMPI, speciesName);
+    displacements[7] = offsetof(RayMPI, speciesId);
     displacements[8] = offsetof(RayMPI, active);
     displacements[9] = offsetof(RayMPI, weight);
     displacements[10] = offsetof(RayMPI, panelId);
@@ -73,102 +78,93 @@ int main(int argc, char** argv) {
     // --- Parse command line
     if (argc != 4) {
         if (rank == 0)
-            std::cerr << "Usage: ./simulation <altitude> <angle_deg> <index>\n";
+            std::cerr << "Usage: ./simulation <altitude> <angle_deg | start,end,count> <index>\n";
         MPI_Finalize();
         return 1;
     }
 
+    RunProfiler profiler(omp_get_max_threads());
+    ThreadCounters& rankTimes = profiler.rank();
+    RunReport report;
+    TraceRecorder trace;
+
+    // Gemeinsamer Zeitnullpunkt für die Timeline aller Ränge
+    MPI_Barrier(MPI_COMM_WORLD);
+    auto stageStart = StageClock::now();
+    trace.setEpoch(stageStart);
+
+    // Stufe abschließen: Zeit im Profiler, Abschnitt in der Timeline (Thread 0 des Rangs)
+    auto endStage = [&](Stage stage) {
+        auto now = StageClock::now();
+        rankTimes.add(stage, std::chrono::duration<double>(now - stageStart).count());
+        trace.record(0, stageName(stage), "stage", stageStart, now);
+    };
+
     std::string alt = argv[1];
-    double AoA_deg = std::stod(argv[2]);
+    const GridRange aoaRange = parseGridRange(argv[2]);   // Anstellwinkel [deg], einzeln oder als Gitter
     int index = std::stoi(argv[3]);
-    std::vector<std::string> values;
     double paddingFraction = 0.1;
 
-    // --- Master rank loads atmospheric data and generates config
-    if (rank == 0) {
-        std::ifstream file("../assets/atmos_data/database_" + alt + "km.csv");
-        if (!file) {
-            std::cerr << "Failed to open atmospheric CSV.\n";
-            MPI_Abort(MPI_COMM_WORLD, 1);
-        }
+    // --- Load configuration (wird nicht mehr umgeschrieben)
+    ConfigLoader loader;
+    loader.loadFromFile("config.ini");
+    auto cfg = loader.getConfig();
 
-        std::string line;
-        std::getline(file, line); // skip header
-        for (int i = 0; i <= index; ++i) {
-            if (!std::getline(file, line)) {
-                std::cerr << "Failed to read line " << index << "\n";
-                MPI_Abort(MPI_COMM_WORLD, 1);
-            }
+    // --- Atmosphäre: Rang 0 liest die Tabellen (über den Binärcache) oder rechnet das empirische Modell,
+    // alle Ränge übernehmen den Zustand
+    AtmosphereState atmosphere;
+    std::array<double, 3 + AtmosphereTable::speciesCount> packedState{};
+    if (rank == 0 && cfg.atmosphereModel == "empirical") {
+        ThermosphereInput point;
+        point.altitude = std::stod(alt);
+        point.latitude = cfg.latitude;
+        point.longitude = cfg.longitude;
+        point.dayOfYear = cfg.dayOfYear;
+        point.utSeconds = cfg.utSeconds;
+        point.f107 = cfg.f107;
+        point.f107a = cfg.f107a;
+        point.ap = cfg.ap;
+        atmosphere = ThermosphereModel().evaluate(point);
+        const double v = cfg.flowVelocity.norm();
+        atmosphere.dynamicPressure = 0.5 * atmosphere.massDensity * v * v;
+        std::cout << "✔️  Empirical atmosphere at " << alt << " km: T = " << atmosphere.temperature
+                  << " K, rho = " << atmosphere.massDensity << " kg/m^3\n";
+    } else if (rank == 0) {
+        AtmosphereTable table;
+        if (!table.load(cfg.atmosphereDirectory, cfg.atmosphereCache) || !table.hasAltitude(alt)) {
+            std::cerr << "Failed to load atmosphere table for " << alt << " km from " << cfg.atmosphereDirectory << "\n";
+            MPI_Abort(MPI_COMM_WORLD, 1);
         }
-
-        std::stringstream ss(line);
-        std::string cell;
-        while (std::getline(ss, cell, ',')) values.push_back(cell);
-
-        // Calculate direction vector from AoA
-        double rad = AoA_deg * M_PI / 180.0;
-        double dirX = sin(rad);
-        double dirY = cos(rad);
-        double dirZ = 0.0;
-
-        // Update config.ini dynamically
-        std::vector<std::string> species = {"N2", "O2", "O", "HE", "H", "AR", "N", "AO", "NO"};
-        std::ifstream in("config.ini");
-        std::ostringstream out;
-        std::string cl, currentSpecies;
-        bool inSpeciesBlock = false;
-
-        while (std::getline(in, cl)) {
-            bool replaced = false;
-
-            if (cl.rfind("direction", 0) == 0)
-                out << "direction = " << dirX << "," << dirY << "," << dirZ << "\n", replaced = true;
-            else if (cl.rfind("temperature", 0) == 0)
-                out << "temperature = " << values[10] << "\n", replaced = true;
-            else if (cl.rfind("mass_density",0) == 0)
-                out << "mass_density = " << values[0] << "\n", replaced = true;
-
-            for (auto& sp : species) {
-                if (cl == "[species:" + sp + "]") {
-                    currentSpecies = sp;
-                    inSpeciesBlock = true;
-                    out << cl << "\n", replaced = true;
-                    break;
-                }
-            }
-
-            if (inSpeciesBlock && cl.rfind("density", 0) == 0) {
-                auto it = std::find(species.begin(), species.end(), currentSpecies);
-                if (it != species.end()) {
-                    size_t idx = std::distance(species.begin(), it);
-                    out << "density = " << values[idx + 1] << "\n", replaced = true;
-                }
-            } else if (inSpeciesBlock && cl.rfind("mass", 0) == 0) {
-                out << cl << "\n", inSpeciesBlock = false, replaced = true;
-            }
-
-            if (!replaced) out << cl << "\n";
+        if (!table.getState(alt, index, atmosphere)) {
+            std::cerr << "Failed to read line " << index << " (" << table.getRowCount(alt) << " rows)\n";
+            MPI_Abort(MPI_COMM_WORLD, 1);
         }
-
-        std::ofstream configOut("config.ini");
-        configOut << out.str();
     }
+    if (rank == 0) {
+        packedState[0] = atmosphere.massDensity;
+        packedState[1] = atmosphere.temperature;
+        packedState[2] = atmosphere.dynamicPressure;
+        std::copy(atmosphere.densities.begin(), atmosphere.densities.end(), packedState.begin() + 3);
+    }
+    MPI_Bcast(packedState.data(), static_cast<int>(packedState.size()), MPI_DOUBLE, 0, MPI_COMM_WORLD);
+    atmosphere.massDensity = packedState[0];
+    atmosphere.temperature = packedState[1];
+    atmosphere.dynamicPressure = packedState[2];
+    std::copy(packedState.begin() + 3, packedState.end(), atmosphere.densities.begin());
+    atmosphere.applyTo(cfg);
 
-    // --- All ranks wait for config.ini
-    MPI_Barrier(MPI_COMM_WORLD);
-
-    // --- Load configuration
-    ConfigLoader loader;
-    loader.loadFromFile("config.ini");
-    auto cfg = loader.getConfig();
+    if (!cfg.traceFile.empty()) trace.enable(omp_get_max_threads(), cfg.traceBufferEvents);
+    endStage(Stage::Config);
 
     // --- Load geometry
+    stageStart = StageClock::now();
     MeshLoader mesh;
     mesh.load(cfg.geometryFile);
-    const auto& vertices = mesh.getVertices();
-    auto tris = mesh.getTriangles();
-    for (size_t i = 0; i < tris.size(); ++i)
-        tris[i].panelId = static_cast<int>(i);
+    const auto& tris = mesh.getTriangles();   // Panel-IDs 0..n−1 in Dreiecksreihenfolge
+    // Teilkörper in der Lage aus den [body:<name>]-Abschnitten
+    const auto bodyTransforms = resolveBodyTransforms(cfg.bodies, mesh.getBodyNames());
+    const auto vertices = mesh.getPosedVertices(bodyTransforms);
+    const auto triangleTable = TriangleTable::posed(mesh.getTriangleTable(), bodyTransforms);
 
     // --- Initialize simulation components
     SimulationController sim;
@@ -176,139 +172,417 @@ int main(int argc, char** argv) {
     SurfaceInteractionModel model(cfg.reflectionRatio, cfg.absorptionRatio);
     sim.setIntersectionEngine(&engine);
     sim.setSurfaceModel(&model);
+    model.prepare(cfg, mesh.getMaterialNames());
     sim.loadMesh(cfg.geometryFile);
-    engine.setMesh(vertices, tris);
+    endStage(Stage::MeshLoad);
+
+    // Beschleunigungsstruktur und Sichtbarkeitsgraph zählen als Aufbau
+    stageStart = StageClock::now();
+    engine.setPrecision(parseTracePrecision(cfg.tracePrecision));
+    engine.setMesh(mesh.getInstancedMesh());
+    engine.setBodyTransforms(bodyTransforms);
+
+    // --- Analytic panel method: panels that see no other panel need no rays
+    const bool hybrid = (cfg.solver == "hybrid");
+    PanelMethodEngine panelMethod;
+    panelMethod.setMesh(triangleTable);
+    panelMethod.setMaterials(model.getMaterials());
+    panelMethod.setSurfaceModel(cfg);
+    panelMethod.setVerbose(rank == 0);
+    std::vector<int> coupledPanels;
+    if (hybrid) {
+        panelMethod.detectIsolatedPanels();
+        panelMethod.buildVisibilityGraph(engine, cfg.visibilitySamples);
+        coupledPanels = panelMethod.getCoupledPanels();
+    }
+    endStage(Stage::AccelBuild);
 
-    // --- Distribute ray workload
-    int totalRays = cfg.rayCount;
+    // --- Distribute ray workload (gleich für alle Lagen)
+    int totalRays = (hybrid && panelMethod.allIsolated()) ? 0 : cfg.rayCount;
     int raysPerProc = totalRays / size;
     int remainder = totalRays % size;
     int myCount = raysPerProc + (rank < remainder ? 1 : 0);
 
-    std::vector<RayMPI> flatRays;
-    if (rank == 0) {
-        sim.generateMixedRays(cfg, tris, vertices, paddingFraction, totalRays, totalRays);
-        auto allRays = sim.getRays();
-        flatRays.resize(totalRays);
-        for (int i = 0; i < totalRays; ++i)
-            flatRays[i] = toRayMPI(allRays[i]);
-    }
-
-    // --- Scatter rays across MPI ranks
-    std::vector<int> sendCounts(size), displs(size);
-    if (rank == 0) {
-        int offset = 0;
-        for (int i = 0; i < size; ++i) {
-            sendCounts[i] = raysPerProc + (i < remainder ? 1 : 0);
-            displs[i] = offset;
-            offset += sendCounts[i];
-        }
-    }
-
-    std::vector<RayMPI> myRayData(myCount);
-    MPI_Scatterv(flatRays.data(), sendCounts.data(), displs.data(), MPI_RayMPI_Type,
-                 myRayData.data(), myCount, MPI_RayMPI_Type, 0, MPI_COMM_WORLD);
-
-    std::vector<Ray> myRays(myCount);
-    for (int i = 0; i < myCount; ++i)
-        myRays[i] = fromRayMPI(myRayData[i]);
+    // Momente um den Schwerpunkt (Standard: Mitte der Bounding Box)
+    auto [bbMin, bbMax] = mesh.getBoundingBox();
+    const Vector3 centerOfMass = cfg.centerOfMass.value_or((bbMin + bbMax) * 0.5);
 
-    // --- Local simulation loop
-    std::vector<DragForceCalculator> dragCalcs(omp_get_max_threads());
-    std::vector<double> panelAreas(tris.size());
-    for (size_t i = 0; i < tris.size(); ++i)
-        panelAreas[i] = computeTriangleArea(vertices[tris[i].v1], vertices[tris[i].v2], vertices[tris[i].v3]);
+    // Oberflächenmodell einmal auflösen; die ganze Schleife wird pro Modell instanziiert
+    const SurfaceModelType modelType = parseSurfaceModel(cfg.model);
+    constexpr int rayBatch = 256;  // Strahlen pro Timeline-Abschnitt
+    const int batchCount = (myCount + rayBatch - 1) / rayBatch;
 
-    std::vector<int> rayHitCounts(myCount, 0);
-    std::atomic<int> totalHits = 0, raysWithHits = 0, maxBounces = 0;
-
-    #pragma omp parallel
-    {
-        std::vector<std::pair<Vector3, Vector3>> localSegments;
-
-        #pragma omp for
-        for (int i = 0; i < myCount; ++i) {
-            int tid = omp_get_thread_num();
-            Ray r = myRays[i];
-            double remaining = r.energy;
-            double minE = 0.1 * r.energy;
-            int bounces = 0, hits = 0;
-
-            Vector3 lastOrigin = r.origin;
+    // --- Lagen: Anstellwinkel × Schiebewinkel × Rollwinkel oder eine Quaternion.
+    // Gedreht wird nur die Anströmung; Mesh, BVH und Sichtbarkeitsgraph bleiben für alle Lagen gleich.
+    struct AttitudeCase {
+        double aoa, sideslip, roll;   // [deg]
+        Attitude attitude;
+    };
+    std::vector<AttitudeCase> cases;
+    if (cfg.attitudeQuaternion) {
+        const auto& q = *cfg.attitudeQuaternion;
+        const Attitude attitude = Attitude::fromQuaternion(q[0], q[1], q[2], q[3]);
+        // Winkel, die dieselbe Drehung ergeben (einschließlich Rollwinkel)
+        AttitudeCase c{0.0, 0.0, 0.0, attitude};
+        attitude.toAngles(c.aoa, c.sideslip, c.roll);
+        cases.push_back(c);
+
+        // Die Quaternion ersetzt alle Winkel; ein Gitter von der Kommandozeile oder aus config.ini fiele still weg
+        const bool anglesGiven = aoaRange.count > 1 || aoaRange.start != 0.0 || cfg.attitudeSideslip.count > 1 ||
+                                 cfg.attitudeSideslip.start != 0.0 || cfg.attitudeRoll.count > 1 ||
+                                 cfg.attitudeRoll.start != 0.0;
+        if (rank == 0 && anglesGiven)
+            std::cerr << "⚠️  attitudeQuaternion is set: ignoring AoA '" << argv[2]
+                      << "' and attitudeSideslip/attitudeRoll; running the single attitude AoA " << c.aoa
+                      << "°, sideslip " << c.sideslip << "°, roll " << c.roll << "°\n";
+    } else {
+        for (int a = 0; a < aoaRange.count; ++a)
+            for (int b = 0; b < cfg.attitudeSideslip.count; ++b)
+                for (int r = 0; r < cfg.attitudeRoll.count; ++r) {
+                    const double aoa = aoaRange.value(a), beta = cfg.attitudeSideslip.value(b),
+                                 roll = cfg.attitudeRoll.value(r);
+                    cases.push_back({aoa, beta, roll, Attitude::fromAngles(aoa, beta, roll)});
+                }
+    }
+    const bool sweep = cases.size() > 1;
+    if (rank == 0 && sweep)
+        std::cout << "🔁 Attitude sweep: " << cases.size() << " attitudes on one mesh setup\n";
+    sim.setVerbose(!sweep);   // Strahlfeld-VTK nur für eine einzelne Lage
+
+    // Anströmung im Referenzsystem entlang +y; der Betrag kommt aus direction
+    cfg.flowVelocity = Vector3{0.0, cfg.flowVelocity.norm(), 0.0};
+
+    // Bei mehreren Lagen tragen alle Ausgabedateien die Nummer der Lage
+    auto withSuffix = [](const std::string& file, const std::string& suffix) {
+        const size_t dot = file.find_last_of('.');
+        return dot == std::string::npos ? file + suffix : file.substr(0, dot) + suffix + file.substr(dot);
+    };
+    std::ofstream sweepFile;
+    if (rank == 0 && sweep) {
+        std::ostringstream sweepName;
+        sweepName << "attitudeSweep_" << alt << "km_idx" << index << ".txt";
+        sweepFile.open(sweepName.str());
+        sweepFile << "# case aoa sideslip roll cd cl cs cfx cfy cfz cmx cmy cmz heat_W\n";
+    }
 
-            while (bounces < 10 && remaining > minE) {
-                auto hit = engine.intersect(r);
-                if (!hit) break;
+    std::vector<double> threadBusy(omp_get_max_threads(), 0.0);
+    double loopSeconds = 0.0;
+
+    for (size_t k = 0; k < cases.size(); ++k) {
+        const AttitudeCase& att = cases[k];
+        const std::string suffix = sweep ? "_att" + std::to_string(k) : "";
+        const std::string resultPrefix = sweep ? "att" + std::to_string(k) + "_" : "";
+        // Strahlquelle dreht über die Lage; Panelmethode und Auswertung sehen die Anströmung im Körpersystem
+        sim.setAttitude(att.attitude);
+        SimulationConfig caseCfg = cfg;
+        caseCfg.flowVelocity = att.attitude.toBody(cfg.flowVelocity);
+        raySegmentsDebug.clear();
+
+        stageStart = StageClock::now();
+        std::vector<RayMPI> flatRays;
+        if (rank == 0 && totalRays > 0) {
+            sim.generateMixedRays(cfg, tris, vertices, paddingFraction, totalRays, totalRays,
+                                  hybrid ? &coupledPanels : nullptr);
+            auto allRays = sim.getRays();
+            flatRays.resize(totalRays);
+            for (int i = 0; i < totalRays; ++i)
+                flatRays[i] = toRayMPI(allRays[i]);
+        }
+        endStage(Stage::Generation);
+
+        // --- Scatter rays across MPI ranks
+        stageStart = StageClock::now();
+        std::vector<int> sendCounts(size), displs(size);
+        if (rank == 0) {
+            int offset = 0;
+            for (int i = 0; i < size; ++i) {
+                sendCounts[i] = raysPerProc + (i < remainder ? 1 : 0);
+                displs[i] = offset;
+                offset += sendCounts[i];
+            }
+        }
 
-                ++hits;
-                Ray refl = model.generateReflection(cfg, r, *hit);
-                double area = panelAreas[hit->panelId];
-                dragCalcs[tid].accumulateForce(r, refl, area);
+        std::vector<RayMPI> myRayData(myCount);
+        MPI_Scatterv(flatRays.data(), sendCounts.data(), displs.data(), MPI_RayMPI_Type,
+                     myRayData.data(), myCount, MPI_RayMPI_Type, 0, MPI_COMM_WORLD);
+
+        std::vector<Ray> myRays(myCount);
+        for (int i = 0; i < myCount; ++i)
+            myRays[i] = fromRayMPI(myRayData[i]);
+        endStage(Stage::Scatter);
+
+        // --- Local simulation loop
+        std::vector<DragForceCalculator> dragCalcs(omp_get_max_threads());
+        for (auto& dc : dragCalcs) dc.setReferencePoint(centerOfMass);
+
+        std::vector<int> rayHitCounts(myCount, 0);
+        std::atomic<int> totalHits = 0, raysWithHits = 0, maxBounces = 0;
+
+        const auto loopStart = StageClock::now();
+
+        dispatchSurfaceModel(modelType, [&](auto modelTag) {
+            constexpr SurfaceModelType Model = decltype(modelTag)::value;
+
+            #pragma omp parallel
+            {
+                std::vector<std::pair<Vector3, Vector3>> localSegments;
+                const int tid = omp_get_thread_num();
+                ThreadCounters& counters = profiler.thread(tid);
+                if (cfg.seed >= 0)
+                    seedSurfaceRandom(static_cast<unsigned>(cfg.seed) + 7919u * (rank * omp_get_num_threads() + tid + 1));
+                // Hardware-Zähler nur um die Bounce-Schleife dieses Threads
+                std::optional<PerfCounterGroup> perf;
+                if (cfg.perfCounters) {
+                    perf.emplace();
+                    if (!perf->available() && rank == 0 && tid == 0)
+                        std::cerr << "⚠️  Hardware counters unavailable (" << perf->error() << "), continuing without.\n";
+                    perf->start();
+                }
+                const auto busyStart = StageClock::now();
+
+                #pragma omp for nowait
+                for (int b = 0; b < batchCount; ++b) {
+                    TraceScope batchScope(trace, tid, "ray_batch", "trace", static_cast<int64_t>(b) * rayBatch);
+                    const int batchEnd = std::min(myCount, (b + 1) * rayBatch);
+                    for (int i = b * rayBatch; i < batchEnd; ++i) {
+                        int hits = 0;
+                        double timeScale = (i % RunProfiler::timingStride == 0) ? RunProfiler::timingStride : 0.0;
+                        Vector3 lastOrigin = myRays[i].origin;
+
+                        traceBounces<Model>(engine, model, caseCfg, myRays[i], 10,
+                            [&](const Ray& in, const Ray& refl, const HitInfo& hit, int bounce) {
+                                // Erster Treffer auf analytischem Panel: Beitrag steckt bereits in der Panelmethode
+                                if (hybrid && bounce == 0 && panelMethod.isIsolated(hit.panelId)) return false;
+
+                                ++hits;
+                                dragCalcs[tid].accumulateForce(in, refl, (*triangleTable)[hit.panelId].area, hit);
+
+                                if (!sweep) localSegments.emplace_back(lastOrigin, hit.point);
+                                lastOrigin = refl.origin;
+                                return true;
+                            }, &counters, timeScale);
+
+                        rayHitCounts[i] = hits;
+                        if (hits > 0) ++raysWithHits;
+                        totalHits += hits;
+                        maxBounces = std::max(maxBounces.load(), hits);
+                    }
+                }
+                threadBusy[tid] += secondsSince(busyStart);
+                if (perf) counters.hardware.merge(perf->stop());
+
+                const auto waitStart = StageClock::now();
+                #pragma omp critical
+                {
+                    const auto entered = StageClock::now();
+                    trace.record(tid, "critical_wait", "sync", waitStart, entered);
+                    raySegmentsDebug.insert(raySegmentsDebug.end(), localSegments.begin(), localSegments.end());
+                    trace.record(tid, "segment_merge", "sync", entered, StageClock::now());
+                }
+            }
+        });
+        loopSeconds += secondsSince(loopStart);
+        trace.record(0, "ray_loop", "stage", loopStart, StageClock::now());
+
+        // --- Reduce results across ranks
+        stageStart = StageClock::now();
+        DragForceCalculator local;
+        local.setReferencePoint(centerOfMass);
+        for (auto& dc : dragCalcs) local.merge(dc);
+
+        // Analytischer Anteil (Kraft auf den Körper) als Impulsänderung der Moleküle einbuchen
+        if (rank == 0 && hybrid) {
+            std::vector<Vector3> analyticPanels;
+            panelMethod.computeAnalyticForce(caseCfg, &analyticPanels);
+            for (size_t id = 0; id < analyticPanels.size(); ++id) {
+                const int panel = static_cast<int>(id);
+                if (!panelMethod.isIsolated(panel)) continue;
+                local.addPanelLoad(panel, -analyticPanels[id], panelMethod.getPanelCentroid(panel),
+                                   panelMethod.getPanelNormal(panel), panelMethod.computePanelHeatLoad(caseCfg, panel));
+            }
+        }
 
-                localSegments.emplace_back(lastOrigin, hit->point);
-                lastOrigin = refl.origin;
+        // Kraft und Moment in einem Reduce
+        Vector3 localFM[2] = {local.getTotalDragForce(), local.getTotalMoment()}, totalFM[2];
+        const auto mpiStart = StageClock::now();
+        MPI_Reduce(localFM, totalFM, 6, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+        const Vector3& totalF = totalFM[0];
+        const Vector3& totalM = totalFM[1];
+
+        // Panellasten (Kraft, Moment, Wärme, Druck, Schub) für die Oberflächenausgabe
+        std::vector<double> localLoads = local.packPanelLoads(tris.size());
+        std::vector<double> totalLoads(rank == 0 ? localLoads.size() : 0);
+        MPI_Reduce(localLoads.data(), totalLoads.data(), static_cast<int>(localLoads.size()), MPI_DOUBLE,
+                   MPI_SUM, 0, MPI_COMM_WORLD);
+
+        int localHitSum = std::accumulate(rayHitCounts.begin(), rayHitCounts.end(), 0);
+        int globalHitSum = 0, globalHitRays = raysWithHits, globalMax = maxBounces;
+        MPI_Reduce(&localHitSum, &globalHitSum, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+        MPI_Reduce(&raysWithHits, &globalHitRays, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+        MPI_Reduce(&maxBounces, &globalMax, 1, MPI_INT, MPI_MAX, 0, MPI_COMM_WORLD);
+
+        double localRayMass = std::accumulate(myRays.begin(), myRays.end(), 0.0,
+                                              [](double sum, const Ray& r) { return sum + r.weight; });
+        double totalRayMass = 0.0;
+        MPI_Reduce(&localRayMass, &totalRayMass, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+        trace.record(0, "MPI_Reduce", "mpi", mpiStart, StageClock::now());
+        endStage(Stage::Reduce);
+
+        stageStart = StageClock::now();
+        if (rank == 0) {
+            Vector3 flowDir = caseCfg.flowVelocity.normalize();
+            double dynP = atmosphere.dynamicPressure;
+            double A_ref = triangleTable->getTotalArea() / 2.0;
+
+            double dragParallel = totalF.dot(flowDir);
+            double cd_total = -dragParallel / (A_ref * dynP);
+
+            if (sweep)
+                std::cout << "\n[ATTITUDE " << k << "] AoA " << att.aoa << "°, sideslip " << att.sideslip
+                          << "°, roll " << att.roll << "°, flow (body) " << flowDir << "\n";
+            std::cout << "\n[RESULT] Drag force: " << dragParallel << " N\n";
+            std::cout << "[RESULT] Total C_d: " << cd_total << "\n";
+
+            std::ostringstream fname;
+            fname << "totalDragCoefficient_" << alt << "km_idx" << index << suffix << ".txt";
+            std::ofstream outFile(fname.str());
+            if (outFile) {
+                outFile << cd_total << "\n";
+                std::cout << "Saved to " << fname.str() << "\n";
+            }
 
-                r = refl;
-                remaining = refl.energy * (1.0 - cfg.energyLoss);
-                ++bounces;
+            // 6-DOF: Kraft und Moment auf den Körper (Gegenwert der Impulsänderung des Gases)
+            const Vector3 bodyF = -totalF, bodyM = -totalM;
+            const WindAxes wind = WindAxes::fromFlow(flowDir);
+            const double lift = bodyF.dot(wind.lift), side = bodyF.dot(wind.side);
+            const double qA = A_ref * dynP, qAL = qA * cfg.referenceLength;
+            const Vector3 cF = bodyF / qA, cM = bodyM / qAL;
+
+            std::cout << "[RESULT] Lift: " << lift << " N (C_L " << lift / qA << "), side force: "
+                      << side << " N (C_S " << side / qA << ")\n";
+            std::cout << "[RESULT] Moment about " << centerOfMass << ": " << bodyM << " N·m\n";
+            std::cout << "[RESULT] C_F (body): " << cF << "  C_M (body): " << cM << "\n";
+
+            std::ostringstream coeffName;
+            coeffName << "aeroCoefficients_" << alt << "km_idx" << index << suffix << ".txt";
+            std::ofstream coeffFile(coeffName.str());
+            if (coeffFile) {
+                coeffFile << "# A_ref " << A_ref << " m^2, L_ref " << cfg.referenceLength
+                          << " m, center of mass " << centerOfMass.x << " " << centerOfMass.y << " "
+                          << centerOfMass.z << "\n";
+                coeffFile << "# cd cl cs cfx cfy cfz cmx cmy cmz\n";
+                coeffFile << cd_total << " " << lift / qA << " " << side / qA << " "
+                          << cF.x << " " << cF.y << " " << cF.z << " " << cM.x << " " << cM.y << " " << cM.z << "\n";
+                std::cout << "Saved to " << coeffName.str() << "\n";
             }
 
-            rayHitCounts[i] = hits;
-            if (hits > 0) ++raysWithHits;
-            totalHits += hits;
-            maxBounces = std::max(maxBounces.load(), hits);
+            std::cout << "\n[STATS] Total rays: " << totalRays
+                      << "\nRays with hits: " << globalHitRays
+                      << "\nTotal hits: " << globalHitSum
+                      << "\nAvg. hits per ray: " << static_cast<double>(globalHitSum) / std::max(totalRays, 1)
+                      << "\nMax bounces: " << globalMax
+                      << "\nAnalytic panels: " << (hybrid ? panelMethod.getIsolatedCount() : 0)
+                      << " of " << tris.size() << "\n";
+
+            HeatmapExporter heat;
+            if (!sweep) heat.exportRaysAsVTK("ray_trace.vtk", raySegmentsDebug, vertices, tris, 1.0);
+
+            local.unpackPanelLoads(totalLoads);
+            double heatLoad = 0.0;
+            for (const auto& [_, pf] : local.getPanelForces()) heatLoad += pf.heat;
+            std::cout << "[RESULT] Heat load: " << heatLoad << " W\n";
+            heat.exportPanelLoadsAsVTK(withSuffix(cfg.heatmapOutputFile, suffix), local.getPanelForces(), tris, vertices);
+
+            if (sweepFile.is_open())
+                sweepFile << k << " " << att.aoa << " " << att.sideslip << " " << att.roll << " " << cd_total << " "
+                          << lift / qA << " " << side / qA << " " << cF.x << " " << cF.y << " " << cF.z << " "
+                          << cM.x << " " << cM.y << " " << cM.z << " " << heatLoad << "\n";
+
+            report.setResult(resultPrefix + "drag_N", dragParallel);
+            report.setResult(resultPrefix + "cd", cd_total);
+            report.setResult(resultPrefix + "heat_W", heatLoad);
+            report.setResult(resultPrefix + "lift_N", lift);
+            report.setResult(resultPrefix + "side_N", side);
+            report.setResult(resultPrefix + "cl", lift / qA);
+            report.setResult(resultPrefix + "cs", side / qA);
+            const char* axis[3] = {"x", "y", "z"};
+            for (int c = 0; c < 3; ++c) {
+                report.setResult(resultPrefix + "cf" + axis[c], cF[c]);
+                report.setResult(resultPrefix + "cm" + axis[c], cM[c]);
+            }
         }
-
-        #pragma omp critical
-        raySegmentsDebug.insert(raySegmentsDebug.end(), localSegments.begin(), localSegments.end());
+        endStage(Stage::Export);
     }
+    if (sweepFile.is_open()) std::cout << "Saved attitude sweep to attitudeSweep_" << alt << "km_idx" << index << ".txt\n";
+    profiler.setLoopSeconds(loopSeconds);
+    for (size_t tid = 0; tid < threadBusy.size(); ++tid) profiler.setThreadBusy(static_cast<int>(tid), threadBusy[tid]);
 
-    // --- Reduce results across ranks
-    DragForceCalculator local;
-    for (auto& dc : dragCalcs) local.merge(dc);
-
-    Vector3 localF = local.getTotalDragForce(), totalF;
-    MPI_Reduce(&localF, &totalF, 3, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
-
-    int localHitSum = std::accumulate(rayHitCounts.begin(), rayHitCounts.end(), 0);
-    int globalHitSum = 0, globalHitRays = raysWithHits, globalMax = maxBounces;
-    MPI_Reduce(&localHitSum, &globalHitSum, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
-    MPI_Reduce(&raysWithHits, &globalHitRays, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
-    MPI_Reduce(&maxBounces, &globalMax, 1, MPI_INT, MPI_MAX, 0, MPI_COMM_WORLD);
-
-    double localRayMass = std::accumulate(myRays.begin(), myRays.end(), 0.0,
-                                          [](double sum, const Ray& r) { return sum + r.weight; });
-    double totalRayMass = 0.0;
-    MPI_Reduce(&localRayMass, &totalRayMass, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+    // --- Run report: Zusammenfassungen aller Ränge auf Rang 0 sammeln
+    std::vector<double> packed(RankSummary::packedSize);
+    profiler.summarize().pack(packed.data());
+    std::vector<double> allPacked(rank == 0 ? RankSummary::packedSize * size : 0);
+    MPI_Gather(packed.data(), static_cast<int>(RankSummary::packedSize), MPI_DOUBLE,
+               allPacked.data(), static_cast<int>(RankSummary::packedSize), MPI_DOUBLE, 0, MPI_COMM_WORLD);
 
     if (rank == 0) {
-        Vector3 flowDir = cfg.flowVelocity.normalize();
-        double v = cfg.flowVelocity.norm();
-        double dynP = std::stod(values.back());
-        double A_ref = std::accumulate(panelAreas.begin(), panelAreas.end(), 0.0) / 2.0;
-
-        double dragParallel = totalF.dot(flowDir);
-        double cd_total = -dragParallel / (A_ref * dynP);
-
-        std::cout << "\n[RESULT] Drag force: " << dragParallel << " N\n";
-        std::cout << "[RESULT] Total C_d: " << cd_total << "\n";
+        std::vector<RankSummary> ranks;
+        for (int r = 0; r < size; ++r)
+            ranks.push_back(RankSummary::unpack(&allPacked[r * RankSummary::packedSize]));
+
+        report.set("altitude_km", alt);
+        if (cases.size() == 1) {
+            report.set("aoa_deg", cases[0].aoa);
+            report.set("sideslip_deg", cases[0].sideslip);
+            report.set("roll_deg", cases[0].roll);
+        } else {
+            report.set("attitudes", static_cast<double>(cases.size()));
+        }
+        report.set("index", index);
+        report.set("model", cfg.model);
+        report.set("solver", cfg.solver);
+        report.set("trace_precision", cfg.tracePrecision);
+        report.set("geometry", cfg.geometryFile);
+        report.set("triangles", static_cast<double>(tris.size()));
+        report.set("analytic_panels", static_cast<double>(hybrid ? panelMethod.getIsolatedCount() : 0));
+        report.set("rays", totalRays);
+        report.set("ranks", size);
+        report.set("threads_per_rank", omp_get_max_threads());
+        report.set("timing_stride", RunProfiler::timingStride);
+        report.set("seed", cfg.seed);
+        report.set("perf_counters", cfg.perfCounters ? "requested" : "off");
+#ifdef VLEO_VERSION
+        report.set("version", VLEO_VERSION);
+#endif
 
         std::ostringstream fname;
-        fname << "totalDragCoefficient_" << alt << "km_idx" << index << ".txt";
-        std::ofstream outFile(fname.str());
-        if (outFile) {
-            outFile << cd_total << "\n";
-            std::cout << "Saved to " << fname.str() << "\n";
+        fname << "runReport_" << alt << "km_idx" << index << ".json";
+        report.write(fname.str(), ranks);
+    }
+
+    // --- Chrome trace: Ereignisse aller Ränge auf Rang 0 zusammenführen
+    if (!cfg.traceFile.empty()) {
+        std::string events = trace.serialize(rank);
+        int length = static_cast<int>(events.size());
+        std::vector<int> lengths(size), offsets(size, 0);
+        MPI_Gather(&length, 1, MPI_INT, lengths.data(), 1, MPI_INT, 0, MPI_COMM_WORLD);
+
+        std::string all;
+        if (rank == 0) {
+            for (int r = 1; r < size; ++r) offsets[r] = offsets[r - 1] + lengths[r - 1];
+            all.resize(offsets[size - 1] + lengths[size - 1]);
         }
+        MPI_Gatherv(events.data(), length, MPI_CHAR, all.data(), lengths.data(), offsets.data(),
+                    MPI_CHAR, 0, MPI_COMM_WORLD);
 
-        std::cout << "\n[STATS] Total rays: " << totalRays
-                  << "\nRays with hits: " << globalHitRays
-                  << "\nTotal hits: " << globalHitSum
-                  << "\nAvg. hits per ray: " << static_cast<double>(globalHitSum) / totalRays
-                  << "\nMax bounces: " << globalMax << "\n";
+        if (trace.droppedEvents() > 0)
+            std::cerr << "⚠️  Rank " << rank << ": " << trace.droppedEvents()
+                      << " trace events overwritten (increase traceBufferEvents)\n";
 
-        HeatmapExporter heat;
-        heat.exportRaysAsVTK("ray_trace.vtk", raySegmentsDebug, vertices, tris, 1.0);
+        if (rank == 0) {
+            std::vector<std::string> rankEvents;
+            for (int r = 0; r < size; ++r) rankEvents.push_back(all.substr(offsets[r], lengths[r]));
+            TraceRecorder::writeChromeTrace(cfg.traceFile, rankEvents);
+        }
     }
 
     MPI_Type_free(&MPI_RayMPI_Type);
@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include "AeroDatabase.h"
+#include "DragSolver.h"
+#include "ConfigLoader.h"
+#include "Vector3.h"
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+// Lineare Testfunktion: wird von multilinearer Interpolation exakt wiedergegeben
+static float linearField(int k, double a, double b, double s, double r) {
+    return static_cast<float>(0.01 * a - 0.02 * b + 0.3 * s + 2.0 * r + k);
+}
+
+static AeroDatabase makeLinearTable() {
+    std::array<AeroAxis, AeroDatabase::axisCount> axes = {
+        AeroAxis::fromRange({-10.0, 10.0, 5}), AeroAxis::fromRange({-5.0, 5.0, 3}),
+        AeroAxis::fromRange({5.0, 10.0, 6}), AeroAxis::fromRange({0.2, 0.6, 3})
+    };
+    std::vector<float> values;
+    for (int i0 = 0; i0 < axes[0].count; ++i0)
+        for (int i1 = 0; i1 < axes[1].count; ++i1)
+            for (int i2 = 0; i2 < axes[2].count; ++i2)
+                for (int i3 = 0; i3 < axes[3].count; ++i3)
+                    for (int k = 0; k < AeroDatabase::valuesPerNode; ++k)
+                        values.push_back(linearField(k, axes[0].value(i0), axes[1].value(i1),
+                                                     axes[2].value(i2), axes[3].value(i3)));
+    AeroDatabase db;
+    db.setTable(axes, values);
+    return db;
+}
+
+TEST(AeroDatabaseTest, InterpolatesLinearFieldExactly) {
+    AeroDatabase db = makeLinearTable();
+    EXPECT_EQ(db.getNodeCount(), 5u * 3u * 6u * 3u);
+
+    AeroCoefficients c = db.lookup(3.7, -1.2, 7.3, 0.45);
+    EXPECT_NEAR(c.force.x, linearField(0, 3.7, -1.2, 7.3, 0.45), 1e-4);
+    EXPECT_NEAR(c.moment.z, linearField(5, 3.7, -1.2, 7.3, 0.45), 1e-4);
+    EXPECT_NEAR(c.momentError.z, linearField(11, 3.7, -1.2, 7.3, 0.45), 1e-4);
+
+    // Knoten und Tabellenrand
+    c = db.lookup(10.0, 5.0, 10.0, 0.6);
+    EXPECT_NEAR(c.force.y, linearField(1, 10.0, 5.0, 10.0, 0.6), 1e-4);
+}
+
+TEST(AeroDatabaseTest, ClampsOutsideGrid) {
+    AeroDatabase db = makeLinearTable();
+    AeroCoefficients inside = db.lookup(10.0, -5.0, 5.0, 0.2);
+    AeroCoefficients outside = db.lookup(40.0, -9.0, 1.0, 0.0);
+    EXPECT_FLOAT_EQ(inside.force.x, outside.force.x);
+    EXPECT_FLOAT_EQ(inside.moment.y, outside.moment.y);
+}
+
+TEST(AeroDatabaseTest, SaveLoadRoundTrip) {
+    AeroDatabase db = makeLinearTable();
+    const std::string file = "test_aero_database.adb";
+    ASSERT_TRUE(db.save(file));
+
+    AeroDatabase loaded;
+    ASSERT_TRUE(loaded.load(file));
+    std::remove(file.c_str());
+
+    EXPECT_EQ(loaded.getNodeCount(), db.getNodeCount());
+    EXPECT_DOUBLE_EQ(loaded.getAxis(2).step, db.getAxis(2).step);
+    AeroCoefficients a = db.lookup(1.0, 2.0, 6.5, 0.33);
+    AeroCoefficients b = loaded.lookup(1.0, 2.0, 6.5, 0.33);
+    EXPECT_FLOAT_EQ(a.force.z, b.force.z);
+    EXPECT_FLOAT_EQ(a.moment.x, b.moment.x);
+
+    EXPECT_FALSE(loaded.load("models/Cube.obj"));
+}
+
+TEST(AeroDatabaseTest, WritesLittleEndian) {
+    AeroDatabase db = makeLinearTable();
+    const std::string file = "test_aero_endian.adb";
+    ASSERT_TRUE(db.save(file));
+
+    // Achsenzahl direkt nach der Kennung, niedrigstes Byte zuerst
+    std::ifstream in(file, std::ios::binary);
+    unsigned char header[12];
+    ASSERT_TRUE(in.read(reinterpret_cast<char*>(header), sizeof(header)));
+    in.close();
+    std::remove(file.c_str());
+    EXPECT_EQ(header[8], AeroDatabase::axisCount);
+    EXPECT_EQ(header[9], 0);
+    EXPECT_EQ(header[10], 0);
+    EXPECT_EQ(header[11], 0);
+}
+
+TEST(AeroDatabaseTest, RejectsAxesWithoutStep) {
+    // Mehrere Punkte bei start == end: Schrittweite 0
+    EXPECT_FALSE(AeroAxis::fromRange({5.0, 5.0, 3}).valid());
+    EXPECT_TRUE(AeroAxis::fromRange({5.0, 5.0, 1}).valid());
+    EXPECT_FALSE(AeroAxis::fromRange({0.0, std::nan(""), 3}).valid());
+
+    AeroDatabase db;
+    std::array<AeroAxis, AeroDatabase::axisCount> axes = {
+        AeroAxis::fromRange({0.0, 10.0, 3}), AeroAxis::fromRange({2.0, 2.0, 2}),
+        AeroAxis::fromRange({5.0, 10.0, 2}), AeroAxis::fromRange({0.2, 0.6, 2})
+    };
+    EXPECT_FALSE(db.setTable(axes, {}));
+
+    SimulationConfig cfg;
+    cfg.databaseSpeedRatio = {8.0, 8.0, 4};
+    EXPECT_FALSE(db.generate(DragSolver(cfg), cfg));
+
+    // Gespeicherte Datei mit Schrittweite 0 auf der ersten Achse
+    const std::string file = "test_aero_zero_step.adb";
+    ASSERT_TRUE(makeLinearTable().save(file));
+    {
+        std::fstream patch(file, std::ios::binary | std::ios::in | std::ios::out);
+        const double zero = 0.0;
+        patch.seekp(8 + 4 + 8);   // Kennung, Achsenzahl, start der ersten Achse
+        patch.write(reinterpret_cast<const char*>(&zero), sizeof(zero));
+    }
+    AeroDatabase loaded;
+    EXPECT_FALSE(loaded.load(file));
+    std::remove(file.c_str());
+
+    // NaN-Abfrage landet auf dem ersten Knoten statt im undefinierten int-Cast
+    AeroDatabase table = makeLinearTable();
+    AeroCoefficients c = table.lookup(std::nan(""), -5.0, 5.0, 0.2);
+    EXPECT_FLOAT_EQ(c.force.x, table.lookup(-10.0, -5.0, 5.0, 0.2).force.x);
+}
+
+TEST(AeroDatabaseTest, GeneratedNodesMatchSolver) {
+    SimulationConfig cfg;
+    cfg.model = "DRIA";
+    cfg.solver = "hybrid";
+    cfg.WallTemp = 300.0;
+    cfg.species["N2"] = SpeciesInfo{3.4e15, 4.65e-26};
+    cfg.species["O"] = SpeciesInfo{1.7e15, 2.66e-26};
+    cfg.databaseAoA = {0.0, 30.0, 4};
+    cfg.databaseSideslip = {0.0, 0.0, 1};
+    cfg.databaseSpeedRatio = {6.0, 9.0, 2};
+    cfg.databaseTemperatureRatio = {0.3, 0.3, 1};
+    cfg.referenceLength = 2.0;
+
+    DragSolver solver(cfg);
+    ASSERT_TRUE(solver.loadMesh("models/Cube.obj"));
+    AeroDatabase db;
+    ASSERT_TRUE(db.generate(solver, cfg));
+    EXPECT_EQ(db.getNodeCount(), 8u);
+
+    // Knoten AoA = 20°, s = 9 direkt mit dem Solver nachrechnen
+    const double meanMass = (3.4e15 * 4.65e-26 + 1.7e15 * 2.66e-26) / 5.1e15;
+    FlowState state;
+    state.direction = AeroDatabase::flowDirection(20.0, 0.0);
+    state.temperature = 300.0 / 0.3;
+    state.velocity = 9.0 * std::sqrt(2.0 * cfg.kB * state.temperature / meanMass);
+    state.densities = {{"N2", 3.4e15}, {"O", 1.7e15}};
+    DragResult r = solver.compute(state);
+    const double qA = r.dynamicPressure * solver.getReferenceArea();
+
+    AeroCoefficients c = db.lookup(20.0, 0.0, 9.0, 0.3);
+    EXPECT_NEAR(c.force.x, r.force.x / qA, 1e-5);
+    EXPECT_NEAR(c.force.y, r.force.y / qA, 1e-5);
+    EXPECT_NEAR(c.moment.z, r.torque.z / (qA * 2.0), 1e-5);
+    EXPECT_NEAR(c.force.dot(state.direction), r.cd, 1e-5);
+}
@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+#include "AtmosphereTable.h"
+#include "ConfigLoader.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+// Zwei Höhen im Format von assets/atmos_data; Spalte "date" zwischen T und q wird nicht gelesen
+class AtmosphereTableTest : public ::testing::Test {
+protected:
+    const std::string dir = "test_atmos_data";
+    const std::string cache = "test_atmos_data.cache";
+
+    void SetUp() override {
+        fs::remove_all(dir);
+        fs::create_directory(dir);
+        std::ofstream a(dir + "/database_300km.csv");
+        a << "rho,N2,O2,O,HE,H,AR,N,AO,NO,T,date,q\n"
+          << "2.17e-10,3.4e15,2.45e14,1.69e15,1.2e12,1.6e11,5.6e12,1.8e13,0,0,884.7,2024-01-01,6.5e-3\n"
+          << "1.9e-10,3.1e15,2.2e14,1.6e15,1.1e12,1.5e11,5.1e12,1.7e13,0,0,870.0,2024-01-02,5.8e-3\r\n"
+          << "\n";
+        std::ofstream b(dir + "/database_400km.csv");
+        b << "rho,N2,O2,O,HE,H,AR,N,AO,NO,T,date,q\n"
+          << "2.8e-12,1.1e13,4.0e11,3.5e14,2.0e12,2.0e11,1.0e9,6.0e12,0,0,950.0,2024-01-01,8.4e-5\n";
+        std::ofstream other(dir + "/notes.csv");
+        other << "ignored\n";
+    }
+
+    void TearDown() override {
+        fs::remove_all(dir);
+        fs::remove(cache);
+    }
+};
+
+TEST_F(AtmosphereTableTest, ReadsAllAltitudesByColumn) {
+    AtmosphereTable table;
+    ASSERT_TRUE(table.loadCsvDirectory(dir));
+    EXPECT_EQ(table.getAltitudes(), (std::vector<std::string>{"300", "400"}));
+    EXPECT_EQ(table.getRowCount("300"), 2u);
+    EXPECT_EQ(table.getRowCount("400"), 1u);
+
+    AtmosphereState s;
+    ASSERT_TRUE(table.getState("300", 1, s));
+    EXPECT_DOUBLE_EQ(s.massDensity, 1.9e-10);
+    EXPECT_DOUBLE_EQ(s.densities[0], 3.1e15);   // N2
+    EXPECT_DOUBLE_EQ(s.densities[2], 1.6e15);   // O
+    EXPECT_DOUBLE_EQ(s.temperature, 870.0);
+    EXPECT_DOUBLE_EQ(s.dynamicPressure, 5.8e-3);
+
+    ASSERT_TRUE(table.getState("400", 0, s));
+    EXPECT_DOUBLE_EQ(s.temperature, 950.0);
+    EXPECT_FALSE(table.getState("400", 1, s));
+    EXPECT_FALSE(table.getState("500", 0, s));
+}
+
+TEST_F(AtmosphereTableTest, CacheRoundTripAndInvalidation) {
+    AtmosphereTable first;
+    ASSERT_TRUE(first.load(dir, cache));
+    ASSERT_TRUE(fs::exists(cache));
+
+    // Gleiche Werte aus dem Cache, auch wenn die CSVs fehlen
+    fs::remove_all(dir);
+    AtmosphereTable cached;
+    ASSERT_TRUE(cached.load(dir, cache));
+    AtmosphereState a, b;
+    ASSERT_TRUE(first.getState("300", 0, a));
+    ASSERT_TRUE(cached.getState("300", 0, b));
+    EXPECT_EQ(a.densities, b.densities);
+    EXPECT_DOUBLE_EQ(a.dynamicPressure, b.dynamicPressure);
+
+    // Neue Höhe im Verzeichnis: Cache wird neu geschrieben
+    SetUp();
+    {
+        std::ofstream c(dir + "/database_500km.csv");
+        c << "rho,N2,O2,O,HE,H,AR,N,AO,NO,T,date,q\n"
+          << "5.0e-13,1.0e12,2.0e10,6.0e13,1.5e12,2.0e11,1.0e8,1.0e12,0,0,980.0,2024-01-01,1.5e-5\n";
+    }
+    AtmosphereTable refreshed;
+    ASSERT_TRUE(refreshed.load(dir, cache));
+    EXPECT_TRUE(refreshed.hasAltitude("500"));
+    AtmosphereTable again;
+    ASSERT_TRUE(again.loadCache(cache));
+    EXPECT_TRUE(again.hasAltitude("500"));
+}
+
+TEST_F(AtmosphereTableTest, CacheFollowsSourceDirectoryAndFiles) {
+    AtmosphereTable first;
+    ASSERT_TRUE(first.load(dir, cache));
+    EXPECT_EQ(first.getSourceDirectory(), fs::weakly_canonical(fs::absolute(dir)).string());
+
+    // Anderer Datensatz mit denselben Höhen: nicht aus dem Cache des ersten Verzeichnisses
+    const std::string otherDir = "test_atmos_data_other";
+    fs::remove_all(otherDir);
+    fs::create_directory(otherDir);
+    for (const char* alt : {"300", "400"})
+        std::ofstream(otherDir + "/database_" + alt + "km.csv")
+            << "rho,N2,O2,O,HE,H,AR,N,AO,NO,T,date,q\n"
+            << "1.0e-11,1.0e14,1.0e13,1.0e15,1.0e12,1.0e11,1.0e10,1.0e13,0,0,700.0,2024-01-01,1.0e-3\n";
+    AtmosphereTable other;
+    ASSERT_TRUE(other.load(otherDir, cache));
+    AtmosphereState s;
+    ASSERT_TRUE(other.getState("300", 0, s));
+    EXPECT_DOUBLE_EQ(s.temperature, 700.0);
+    fs::remove_all(otherDir);
+
+    // Gleich große CSV mit älterem Zeitstempel als der Cache: trotzdem neu gelesen
+    ASSERT_TRUE(first.load(dir, cache));
+    const fs::path csv = dir + "/database_400km.csv";
+    const auto stamp = fs::last_write_time(csv);
+    {
+        std::ofstream b(csv);
+        b << "rho,N2,O2,O,HE,H,AR,N,AO,NO,T,date,q\n"
+          << "2.8e-12,1.1e13,4.0e11,3.5e14,2.0e12,2.0e11,1.0e9,6.0e12,0,0,951.0,2024-01-01,8.4e-5\n";
+    }
+    fs::last_write_time(csv, stamp - std::chrono::hours(1));
+    AtmosphereTable edited;
+    ASSERT_TRUE(edited.load(dir, cache));
+    ASSERT_TRUE(edited.getState("400", 0, s));
+    EXPECT_DOUBLE_EQ(s.temperature, 951.0);
+
+    // Kein Rest einer temporären Datei neben dem Cache
+    for (const auto& entry : fs::directory_iterator("."))
+        EXPECT_EQ(entry.path().filename().string().rfind(cache + ".tmp", 0), std::string::npos);
+}
+
+TEST_F(AtmosphereTableTest, AppliesStateToConfiguredSpecies) {
+    AtmosphereTable table;
+    ASSERT_TRUE(table.loadCsvDirectory(dir));
+    AtmosphereState s;
+    ASSERT_TRUE(table.getState("300", 0, s));
+
+    SimulationConfig cfg;
+    cfg.species["N2"] = SpeciesInfo{0.0, 4.65e-26};
+    cfg.species["O"] = SpeciesInfo{0.0, 2.66e-26};
+    s.applyTo(cfg);
+    EXPECT_DOUBLE_EQ(cfg.temperature, 884.7);
+    EXPECT_DOUBLE_EQ(cfg.mass_density, 2.17e-10);
+    EXPECT_DOUBLE_EQ(cfg.species["N2"].density, 3.4e15);
+    EXPECT_DOUBLE_EQ(cfg.species["O"].density, 1.69e15);
+    EXPECT_DOUBLE_EQ(cfg.species["O"].mass, 2.66e-26);
+    EXPECT_EQ(cfg.species.count("HE"), 0u);   // ohne Masse nicht übernommen
+}
+
+TEST_F(AtmosphereTableTest, RejectsMalformedRows) {
+    std::ofstream(dir + "/database_600km.csv") << "rho,N2\n1e-13,abc\n";
+    AtmosphereTable table;
+    EXPECT_FALSE(table.loadCsvDirectory(dir));
+}
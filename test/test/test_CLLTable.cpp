@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include "CLLTable.h"
+#include "SurfaceInteractionModel.h"
+#include "ConfigLoader.h"
+#include <cmath>
+
+// Mittelwert über äquidistante Quantile ≈ Erwartungswert der Verteilung
+static double meanNormalSpeed(const CLLTable& table, double uIn) {
+    const int n = 20000;
+    double sum = 0.0;
+    for (int i = 0; i < n; ++i) sum += table.sampleNormalSpeed(uIn, (i + 0.5) / n);
+    return sum / n;
+}
+
+TEST(CLLTableTest, FullAccommodationIsIndependentOfIncidentSpeed) {
+    CLLTable table(1.0, 1.0, 300.0);
+
+    // α_n = 1: P(u) = 2u·exp(−u²) mit Mittelwert √π/2
+    EXPECT_NEAR(meanNormalSpeed(table, 0.5), std::sqrt(M_PI) / 2.0, 2e-3);
+    EXPECT_NEAR(meanNormalSpeed(table, 15.0), std::sqrt(M_PI) / 2.0, 2e-3);
+}
+
+TEST(CLLTableTest, LowAccommodationIsNearlySpecular) {
+    CLLTable table(0.01, 0.0, 300.0);
+    double uIn = 10.0;
+    EXPECT_NEAR(meanNormalSpeed(table, uIn), std::sqrt(0.99) * uIn, 1e-2);
+}
+
+TEST(CLLTableTest, BeyondTableRangeShiftsLastRow) {
+    CLLTable table(0.5, 0.5, 300.0);
+    double inside = meanNormalSpeed(table, 40.0);
+    double outside = meanNormalSpeed(table, 50.0);
+    EXPECT_NEAR(outside - inside, std::sqrt(0.5) * 10.0, 1e-9);
+}
+
+TEST(CLLTableTest, CachedTablesAreSharedPerParameterSet) {
+    const CLLTable& a = CLLTable::cached(0.8, 0.6, 300.0);
+    const CLLTable& b = CLLTable::cached(0.8, 0.6, 300.0);
+    const CLLTable& c = CLLTable::cached(0.8, 0.6, 400.0);
+    EXPECT_EQ(&a, &b);
+    EXPECT_NE(&a, &c);
+}
+
+TEST(CLLTableTest, FullyAccommodatedKernelReemitsAtWallTemperature) {
+    SimulationConfig cfg;
+    cfg.model = "CLL";
+    cfg.normalAccommodation = 1.0;
+    cfg.tangentialAccommodation = 1.0;
+    cfg.WallTemp = 300.0;
+
+    SurfaceInteractionModel model;
+    model.prepare(cfg);
+
+    Ray in;
+    in.speciesMass = 4.65e-26;
+    in.velocity = {0, -7500.0, 0};
+    in.direction = {0, -1, 0};
+
+    HitInfo hit;
+    hit.point = {0, 0, 0};
+    hit.normal = {0, 1, 0};
+    hit.panelId = 0;
+
+    // Flussgewichtete Maxwell-Verteilung: mittlere Energie 2kT_w
+    const int n = 200000;
+    double energy = 0.0;
+    for (int i = 0; i < n; ++i) {
+        Ray out = model.reflect<SurfaceModelType::CLL>(cfg, in, hit);
+        ASSERT_GE(out.direction.dot(hit.normal), 0.0);
+        energy += out.energy;
+    }
+    EXPECT_NEAR(energy / n / (2.0 * cfg.kB * cfg.WallTemp), 1.0, 1e-2);
+}
+
+TEST(CLLTableTest, TangentialSpeedFollowsEnergyAccommodation) {
+    SimulationConfig cfg;
+    cfg.model = "CLL";
+    cfg.normalAccommodation = 1.0;
+    cfg.tangentialAccommodation = 0.5;
+    cfg.WallTemp = 300.0;
+
+    SurfaceInteractionModel model;
+    model.prepare(cfg);
+    seedSurfaceRandom(29);
+
+    Ray in;
+    in.speciesMass = 4.65e-26;
+    in.velocity = {7500.0, -2000.0, 0};
+    in.direction = in.velocity.normalize();
+
+    HitInfo hit;
+    hit.point = {0, 0, 0};
+    hit.normal = {0, 1, 0};
+    hit.panelId = 0;
+
+    // In Einheiten von c_w: u_t1 ~ N(√(1−α_t)·u_t, α_t/2), u_t2 ~ N(0, α_t/2)
+    const double c_w = std::sqrt(2.0 * cfg.kB * cfg.WallTemp / in.speciesMass);
+    const double uT = 7500.0 / c_w;
+    const int n = 200000;
+    double sum1 = 0.0, sq1 = 0.0, sum2 = 0.0, sq2 = 0.0;
+    for (int i = 0; i < n; ++i) {
+        Ray out = model.reflect<SurfaceModelType::CLL>(cfg, in, hit);
+        double u1 = out.velocity.x / c_w;
+        double u2 = out.velocity.z / c_w;
+        sum1 += u1; sq1 += u1 * u1;
+        sum2 += u2; sq2 += u2 * u2;
+    }
+    double mean1 = sum1 / n, mean2 = sum2 / n;
+    EXPECT_NEAR(mean1, std::sqrt(0.5) * uT, 1e-2);
+    EXPECT_NEAR(sq1 / n - mean1 * mean1, 0.25, 1e-2);
+    EXPECT_NEAR(mean2, 0.0, 1e-2);
+    EXPECT_NEAR(sq2 / n - mean2 * mean2, 0.25, 1e-2);
+}
+
+TEST(CLLTableTest, MaterialsResolveTheirTableAtSetup) {
+    SimulationConfig cfg;
+    cfg.model = "CLL";
+    cfg.normalAccommodation = 0.7;
+    cfg.tangentialAccommodation = 0.9;
+    cfg.WallTemp = 300.0;
+    cfg.materials["hot"].wallTemperature = 600.0;
+
+    SurfaceInteractionModel model;
+    model.prepare(cfg, {"", "hot"});
+    const MaterialTable& materials = model.getMaterials();
+
+    EXPECT_EQ(SurfaceMaterial::fromConfig(cfg).cllTable, &CLLTable::cached(0.7, 0.9, 300.0));
+    EXPECT_EQ(materials[0].cllTable, &CLLTable::cached(0.7, 0.9, 300.0));
+    EXPECT_EQ(materials[1].cllTable, &CLLTable::cached(0.7, 0.9, 600.0));
+
+    cfg.model = "DRIA";
+    EXPECT_EQ(SurfaceMaterial::fromConfig(cfg).cllTable, nullptr);
+}
@@ -57,3 +57,125 @@ TEST(DragForceCalculatorTest, MergeCombinesForces) {
     // Die Fläche bleibt 0, da keine setMesh()-Initialisierung stattfand
 }
 
+
+TEST(DragForceCalculatorTest, AccumulatesMomentAboutReferencePoint) {
+    DragForceCalculator calc;
+    calc.setReferencePoint({1.0, 0.0, 0.0});
+
+    Ray in, out;
+    in.momentum = {0.0, -1.0, 0.0};
+    out.momentum = {0.0, 0.0, 0.0};
+    in.weight = 2.0;
+    in.panelId = 0;   // wird bei Übergabe von HitInfo ignoriert
+
+    HitInfo hit{};
+    hit.point = {1.0, 0.0, 3.0};
+    hit.panelId = 5;
+    calc.accumulateForce(in, out, 0.5, hit);
+
+    // Δp = (0, 2, 0) an r = (0, 0, 3): r × Δp = (−6, 0, 0)
+    auto m = calc.getTotalMoment();
+    EXPECT_DOUBLE_EQ(m.x, -6.0);
+    EXPECT_DOUBLE_EQ(m.y, 0.0);
+    EXPECT_DOUBLE_EQ(m.z, 0.0);
+
+    auto perPanel = calc.getPanelForces();
+    ASSERT_TRUE(perPanel.contains(5));
+    EXPECT_FALSE(perPanel.contains(0));
+    EXPECT_DOUBLE_EQ(perPanel[5].moment.x, -6.0);
+    EXPECT_DOUBLE_EQ(perPanel[5].area, 0.5);
+}
+
+TEST(DragForceCalculatorTest, MergeCombinesMomentsAndPanelContributions) {
+    DragForceCalculator a, b;
+    a.setReferencePoint({0.0, 0.0, 0.0});
+    b.setReferencePoint({0.0, 0.0, 0.0});
+
+    a.addPanelForce(1, {0.0, 0.0, 1.0}, {1.0, 0.0, 0.0});   // Moment (0, −1, 0)
+    b.addPanelForce(1, {0.0, 0.0, 1.0}, {0.0, 1.0, 0.0});   // Moment (1, 0, 0)
+    a.merge(b);
+
+    auto m = a.getTotalMoment();
+    EXPECT_DOUBLE_EQ(m.x, 1.0);
+    EXPECT_DOUBLE_EQ(m.y, -1.0);
+    EXPECT_DOUBLE_EQ(a.getTotalDragForce().z, 2.0);
+    EXPECT_DOUBLE_EQ(a.getPanelForces().at(1).moment.x, 1.0);
+}
+
+TEST(DragForceCalculatorTest, WindAxesAreOrthonormal) {
+    // TestMain-Konvention: Anströmung bei 10° Anstellwinkel in der x-y-Ebene
+    const double a = 10.0 * M_PI / 180.0;
+    WindAxes w = WindAxes::fromFlow({std::sin(a), std::cos(a), 0.0});
+    EXPECT_NEAR(w.drag.dot(w.lift), 0.0, 1e-12);
+    EXPECT_NEAR(w.drag.dot(w.side), 0.0, 1e-12);
+    EXPECT_NEAR(w.lift.dot(w.side), 0.0, 1e-12);
+    EXPECT_NEAR(w.lift.norm(), 1.0, 1e-12);
+    EXPECT_NEAR(w.side.norm(), 1.0, 1e-12);
+    EXPECT_NEAR(w.lift.z, 0.0, 1e-12);   // Auftrieb in der Anstellwinkelebene
+
+    // Schiebewinkel ändert die Auftriebsrichtung nicht, solange er nicht ±90° erreicht
+    const double b = 20.0 * M_PI / 180.0;
+    WindAxes slip = WindAxes::fromFlow({std::sin(a) * std::cos(b), std::cos(a) * std::cos(b), std::sin(b)});
+    EXPECT_NEAR(slip.lift.dot(w.lift), 1.0, 1e-12);
+    EXPECT_NEAR(slip.side.dot(slip.drag), 0.0, 1e-12);
+}
+
+TEST(DragForceCalculatorTest, WindAxesAreContinuousThroughBodyX) {
+    // Anströmung über Körper-x hinweg (Anstellwinkel 90°): keine Sprünge in Auftrieb und Seite
+    WindAxes prev = WindAxes::fromFlow({std::sin(80.0 * M_PI / 180.0), std::cos(80.0 * M_PI / 180.0), 0.0});
+    for (double deg = 80.1; deg <= 100.0; deg += 0.1) {
+        const double a = deg * M_PI / 180.0;
+        WindAxes w = WindAxes::fromFlow({std::sin(a), std::cos(a), 0.0});
+        EXPECT_GT(w.lift.dot(prev.lift), 0.999) << deg;
+        EXPECT_GT(w.side.dot(prev.side), 0.999) << deg;
+        prev = w;
+    }
+    WindAxes axial = WindAxes::fromFlow({1.0, 0.0, 0.0});
+    EXPECT_NEAR(axial.lift.y, -1.0, 1e-12);
+
+    // Einzige Singularität: Anströmung entlang der Schiebeachse z, dort Auftrieb = Körper-x
+    WindAxes lateral = WindAxes::fromFlow({0.0, 0.0, 1.0});
+    EXPECT_NEAR(lateral.lift.x, 1.0, 1e-12);
+    EXPECT_NEAR(lateral.side.norm(), 1.0, 1e-12);
+    EXPECT_NEAR(lateral.side.dot(lateral.drag), 0.0, 1e-12);
+}
+
+TEST(DragForceCalculatorTest, SplitsHitIntoPressureShearAndHeat) {
+    DragForceCalculator calc;
+
+    // Schräger Einfall auf eine Wand mit Normale +z, diffuse Re-Emission entlang +z
+    Ray in, out;
+    in.momentum = {1.0, 0.0, -2.0};
+    out.momentum = {0.0, 0.0, 0.5};
+    in.energy = 10.0;
+    out.energy = 4.0;
+    in.weight = 2.0;
+
+    HitInfo hit{};
+    hit.normal = {0.0, 0.0, 1.0};
+    hit.panelId = 1;
+    calc.accumulateForce(in, out, 1.0, hit);
+
+    const PanelForce& pf = calc.getPanelForces().at(1);
+    EXPECT_DOUBLE_EQ(pf.heat, 12.0);          // (10 − 4) · 2
+    EXPECT_DOUBLE_EQ(pf.normalForce, 5.0);    // Δp·n = 2.5 · 2, drückt in die Wand
+    EXPECT_DOUBLE_EQ(pf.shear.x, 2.0);        // Körper wird in Strömungsrichtung mitgenommen
+    EXPECT_DOUBLE_EQ(pf.shear.z, 0.0);
+}
+
+TEST(DragForceCalculatorTest, PackedPanelLoadsRoundTrip) {
+    DragForceCalculator a;
+    a.addPanelLoad(2, {0.0, 0.0, 3.0}, {1.0, 0.0, 0.0}, {0.0, 0.0, 1.0}, 7.0);
+
+    std::vector<double> packed = a.packPanelLoads(4);
+    ASSERT_EQ(packed.size(), 4 * DragForceCalculator::panelLoadStride);
+
+    DragForceCalculator b;
+    b.unpackPanelLoads(packed);
+    const PanelForce& pf = b.getPanelForces().at(2);
+    EXPECT_DOUBLE_EQ(pf.force.z, 3.0);
+    EXPECT_DOUBLE_EQ(pf.moment.y, -3.0);
+    EXPECT_DOUBLE_EQ(pf.heat, 7.0);
+    EXPECT_DOUBLE_EQ(pf.normalForce, 3.0);
+    EXPECT_DOUBLE_EQ(b.getPanelForces().at(0).heat, 0.0);
+}
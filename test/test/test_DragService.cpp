@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include "DragService.h"
+#include "ConfigLoader.h"
+#include "Vector3.h"
+#include <cmath>
+
+static SimulationConfig makeConfig() {
+    SimulationConfig cfg;
+    cfg.model = "DRIA";
+    cfg.solver = "hybrid";
+    cfg.species["N2"] = SpeciesInfo{0.0, 4.65e-26};
+    cfg.species["O"] = SpeciesInfo{0.0, 2.66e-26};
+    cfg.serviceQuantization = 1e-3;
+    return cfg;
+}
+
+static const char* frontalRequest = "cube 1 0 0 0 0 0 -7800 900 N2=3.4e15 O=1.7e15";
+
+TEST(DragServiceTest, ParsesRequestLine) {
+    DragRequest r;
+    std::string error;
+    ASSERT_TRUE(DragService::parseRequest(frontalRequest, r, error)) << error;
+    EXPECT_EQ(r.geometry, "cube");
+    EXPECT_DOUBLE_EQ(r.attitude[0], 1.0);
+    EXPECT_DOUBLE_EQ(r.velocity.z, -7800.0);
+    EXPECT_DOUBLE_EQ(r.temperature, 900.0);
+    EXPECT_DOUBLE_EQ(r.densities.at("O"), 1.7e15);
+
+    EXPECT_FALSE(DragService::parseRequest("cube 1 0 0", r, error));
+    EXPECT_FALSE(DragService::parseRequest("cube 1 0 0 0 0 0 -7800 900", r, error));   // keine Spezies
+    EXPECT_FALSE(DragService::parseRequest("cube 1 0 0 0 0 0 -7800 900 N2", r, error));
+}
+
+TEST(DragServiceTest, RotatesFlowIntoBodyFrame) {
+    // Körper um 90° um z gedreht: inertiales +x entspricht körperfestem −y
+    const double h = std::sqrt(0.5);
+    double q[4] = {h, 0.0, 0.0, h};
+    Vector3 b = DragService::toBodyFrame(q, Vector3{1.0, 0.0, 0.0});
+    EXPECT_NEAR(b.x, 0.0, 1e-12);
+    EXPECT_NEAR(b.y, -1.0, 1e-12);
+    EXPECT_NEAR(b.z, 0.0, 1e-12);
+
+    double identity[4] = {1.0, 0.0, 0.0, 0.0};
+    Vector3 same = DragService::toBodyFrame(identity, Vector3{0.3, -0.2, 5.0});
+    EXPECT_NEAR(same.z, 5.0, 1e-12);
+}
+
+TEST(DragServiceTest, CachesQuantizedInputs) {
+    DragService service(makeConfig());
+    ASSERT_TRUE(service.addGeometry("cube", "models/Cube.obj"));
+
+    std::vector<std::string> replies = service.handleLines({frontalRequest});
+    ASSERT_EQ(replies.size(), 1u);
+    EXPECT_EQ(replies[0].rfind("OK ", 0), 0u) << replies[0];
+    EXPECT_EQ(service.getCacheSize(), 1u);
+
+    // Abweichung unterhalb der Rasterweite → Cache-Treffer mit identischer Antwort
+    replies = service.handleLines({"cube 1 0 0 0 0 0 -7800.5 900.1 N2=3.4e15 O=1.7e15"});
+    EXPECT_EQ(service.getStats().cacheHits, 1u);
+    EXPECT_EQ(replies[0].back(), '1');
+
+    // Deutlich andere Geschwindigkeit → neu gerechnet
+    service.handleLines({"cube 1 0 0 0 0 0 -7000 900 N2=3.4e15 O=1.7e15"});
+    EXPECT_EQ(service.getStats().computed, 2u);
+    EXPECT_EQ(service.getCacheSize(), 2u);
+}
+
+TEST(DragServiceTest, RollAboutFlowAxisSharesCacheEntry) {
+    DragService service(makeConfig());
+    ASSERT_TRUE(service.addGeometry("cube", "models/Cube.obj"));
+
+    // Drehung um die Anströmachse (z): Anströmung im Körpersystem unverändert
+    DragRequest a, b;
+    std::string error;
+    ASSERT_TRUE(DragService::parseRequest(frontalRequest, a, error));
+    const double h = std::sqrt(0.5);
+    ASSERT_TRUE(DragService::parseRequest("cube " + std::to_string(h) + " 0 0 " + std::to_string(h) +
+                                          " 0 0 -7800 900 N2=3.4e15 O=1.7e15", b, error));
+
+    std::vector<char> cached;
+    auto results = service.handleBatch({a, b}, &cached);
+    ASSERT_TRUE(results[0].valid);
+    ASSERT_TRUE(results[1].valid);
+    EXPECT_EQ(cached[0], 0);
+    EXPECT_EQ(cached[1], 1);
+    EXPECT_DOUBLE_EQ(results[0].cd, results[1].cd);
+    EXPECT_EQ(service.getStats().computed, 1u);
+}
+
+TEST(DragServiceTest, ReportsErrorsPerLine) {
+    DragService service(makeConfig());
+    ASSERT_TRUE(service.addGeometry("cube", "models/Cube.obj"));
+
+    auto replies = service.handleLines({
+        "# Kommentar",
+        frontalRequest,
+        "nosuchgeometry 1 0 0 0 0 0 -7800 900 N2=3.4e15",
+        "cube 1 0 0 0 0 0 -7800 900 XE=1e12",
+        "garbage",
+        "STATS"
+    });
+    ASSERT_EQ(replies.size(), 6u);
+    EXPECT_TRUE(replies[0].empty());
+    EXPECT_EQ(replies[1].rfind("OK ", 0), 0u);
+    EXPECT_EQ(replies[2].rfind("ERR", 0), 0u);
+    EXPECT_EQ(replies[3].rfind("ERR", 0), 0u);
+    EXPECT_EQ(replies[4].rfind("ERR", 0), 0u);
+    EXPECT_EQ(replies[5].rfind("STATS requests=3", 0), 0u) << replies[5];
+}
+
+TEST(DragServiceTest, ServesOnlyRegisteredGeometries) {
+    DragService service(makeConfig());
+    ASSERT_TRUE(service.addGeometry("cube", "models/Cube.obj"));
+
+    // Ein existierender OBJ-Pfad als ID wird nicht geladen, auch nicht beim zweiten Versuch
+    for (int round = 0; round < 2; ++round) {
+        auto replies = service.handleLines({"models/Cube.obj 1 0 0 0 0 0 -7800 900 N2=3.4e15"});
+        EXPECT_EQ(replies[0].rfind("ERR", 0), 0u) << replies[0];
+    }
+    EXPECT_EQ(service.getGeometryCount(), 1u);
+    EXPECT_EQ(service.getStats().errors, 2u);
+}
+
+TEST(DragServiceTest, RejectsNonPositiveQuantization) {
+    EXPECT_TRUE(DragService::quantizationValid(1e-3));
+    EXPECT_FALSE(DragService::quantizationValid(0.0));
+    EXPECT_FALSE(DragService::quantizationValid(-1e-3));
+    EXPECT_FALSE(DragService::quantizationValid(std::nan("")));
+
+    SimulationConfig cfg = makeConfig();
+    cfg.serviceQuantization = 0.0;
+    DragService service(cfg);
+    ASSERT_TRUE(service.addGeometry("cube", "models/Cube.obj"));
+    auto replies = service.handleLines({frontalRequest});
+    EXPECT_EQ(replies[0].rfind("ERR", 0), 0u) << replies[0];
+    EXPECT_EQ(service.getStats().computed, 0u);
+}
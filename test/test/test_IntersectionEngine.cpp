@@ -4,6 +4,12 @@
 #include "Ray.h"
 #include "Vector3.h"
 #include "Triangle.h"
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <set>
 
 class IntersectionEngineTest : public ::testing::Test {
 protected:
@@ -59,3 +65,325 @@ TEST_F(IntersectionEngineTest, RayHitsCorner) {
     EXPECT_NEAR(hit->point.z, 1.0, 1e-4);
 }
 
+TEST(IntersectionEngineTableTest, SharesTableWithPanelMethodNormals) {
+    MeshLoader loader;
+    ASSERT_TRUE(loader.load("models/Cube.obj"));
+    const auto table = loader.getTriangleTable();
+
+    IntersectionEngine engine;
+    engine.setMesh(table);
+    EXPECT_EQ(&engine.getTriangleTable(), table.get());   // keine Kopie
+
+    // Trefferdaten kommen unverändert aus der Tabelle (Normale zur Einfallsseite)
+    Ray ray;
+    ray.origin = Vector3(0.3, 0.7, 2.0);
+    ray.direction = Vector3(0.1, -0.2, -1.0).normalize();
+    auto hit = engine.intersect(ray);
+    ASSERT_TRUE(hit.has_value());
+    const TriangleAttributes& tri = (*table)[table->indexOf(hit->panelId)];
+    EXPECT_EQ(hit->normal.x, tri.normal.x);
+    EXPECT_EQ(hit->normal.y, tri.normal.y);
+    EXPECT_EQ(hit->normal.z, tri.normal.z);
+    EXPECT_EQ(hit->materialId, tri.materialId);
+}
+
+TEST(IntersectionEngineFloatTest, MatchesDoublePrecisionHits) {
+    MeshLoader loader;
+    ASSERT_TRUE(loader.load("models/Cube.obj"));
+
+    IntersectionEngine single, reference;
+    single.setPrecision(TracePrecision::Float);
+    single.setMesh(loader.getVertices(), loader.getTriangles());
+    reference.setMesh(loader.getVertices(), loader.getTriangles());
+
+    Ray ray;
+    ray.origin = Vector3(0.3, 0.7, 2.0);
+    ray.direction = Vector3(0.1, -0.2, -1.0).normalize();
+    auto a = single.intersect(ray);
+    auto b = reference.intersect(ray);
+    ASSERT_TRUE(a.has_value());
+    ASSERT_TRUE(b.has_value());
+    EXPECT_EQ(a->panelId, b->panelId);
+    EXPECT_NEAR(a->point.x, b->point.x, 1e-6);
+    EXPECT_NEAR(a->point.y, b->point.y, 1e-6);
+    EXPECT_NEAR(a->point.z, b->point.z, 1e-6);
+    EXPECT_NEAR(a->normal.z, 1.0, 1e-6);   // zur Einfallsseite gedreht
+}
+
+class IntersectionEnginePrecisionTest : public ::testing::TestWithParam<TracePrecision> {
+protected:
+    IntersectionEngine engine;
+
+    void load(double scale = 1.0) {
+        MeshLoader loader;
+        ASSERT_TRUE(loader.load("models/Cube.obj"));
+        std::vector<Vector3> vertices = loader.getVertices();
+        for (auto& v : vertices) v = v * scale;
+        engine.setPrecision(GetParam());
+        engine.setMesh(vertices, loader.getTriangles());
+    }
+};
+
+TEST_P(IntersectionEnginePrecisionTest, NoLeaksThroughSharedEdge) {
+    load();
+
+    // Oberseite: zwei Dreiecke mit gemeinsamer Diagonale x = y; schräge Strahlen genau darauf und knapp daneben
+    int misses = 0;
+    for (int i = 1; i < 1000; ++i) {
+        const double s = i / 1000.0;
+        for (double off : {-1e-7, 0.0, 1e-7}) {
+            Vector3 target(s + off, s, 1.0);
+            Ray ray;
+            ray.direction = Vector3(0.31, -0.17, -1.0).normalize();
+            ray.origin = target - ray.direction * 3.0;
+            if (!engine.intersect(ray)) ++misses;
+        }
+    }
+    EXPECT_EQ(misses, 0);
+}
+
+TEST_P(IntersectionEnginePrecisionTest, HitsTinyTriangles) {
+    // Kantenlänge 10 µm: |e1 × e2| = 1e-10, früher unter der Parallelitätsschwelle
+    load(1e-5);
+    Ray ray;
+    ray.origin = Vector3(0.3e-5, 0.6e-5, 3e-5);
+    ray.direction = Vector3(0, 0, -1);
+    auto hit = engine.intersect(ray);
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_NEAR(hit->point.z, 1e-5, 1e-9);
+}
+
+TEST_P(IntersectionEnginePrecisionTest, ExcludesStartPanel) {
+    load();
+
+    // Strahl startet exakt auf der Oberseite und läuft ins Innere: Startpanel übersprungen, Boden getroffen
+    Ray probe;
+    probe.origin = Vector3(0.7, 0.3, 2.0);
+    probe.direction = Vector3(0, 0, -1);
+    auto top = engine.intersect(probe);
+    ASSERT_TRUE(top.has_value());
+
+    Ray ray;
+    ray.origin = top->point;
+    ray.direction = Vector3(0, 0, -1);
+    ray.panelId = top->panelId;
+    auto hit = engine.intersect(ray);
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_NE(hit->panelId, top->panelId);
+    EXPECT_NEAR(hit->point.z, 0.0, 1e-6);
+}
+
+INSTANTIATE_TEST_SUITE_P(BothPrecisions, IntersectionEnginePrecisionTest,
+                         ::testing::Values(TracePrecision::Double, TracePrecision::Float));
+
+// Quader 2 × 1 × 1 (einmalig) und sechs gleiche Würfel der Kantenlänge 0.2: vier verschoben, zwei gedreht
+class IntersectionEngineInstancingTest : public ::testing::Test {
+protected:
+    MeshLoader loader;
+
+    void SetUp() override {
+        const int faces[12][3] = {{0, 2, 3}, {0, 3, 1}, {4, 5, 7}, {4, 7, 6}, {0, 1, 5}, {0, 5, 4},
+                                  {2, 6, 7}, {2, 7, 3}, {0, 4, 6}, {0, 6, 2}, {1, 3, 7}, {1, 7, 5}};
+        std::ofstream obj("test_instancing.obj");
+        obj.precision(17);
+        int base = 1;
+        auto box = [&](const Vector3& size, double angle, const Vector3& offset) {
+            for (int i = 0; i < 8; ++i) {
+                const Vector3 p((i & 1) * size.x, ((i >> 1) & 1) * size.y, ((i >> 2) & 1) * size.z);
+                const Vector3 q(std::cos(angle) * p.x - std::sin(angle) * p.y,
+                                std::sin(angle) * p.x + std::cos(angle) * p.y, p.z);
+                obj << "v " << q.x + offset.x << " " << q.y + offset.y << " " << q.z + offset.z << "\n";
+            }
+            for (const auto& f : faces) obj << "f " << base + f[0] << " " << base + f[1] << " " << base + f[2] << "\n";
+            base += 8;
+        };
+        box({2.0, 1.0, 1.0}, 0.0, {0.0, 0.0, 0.0});
+        for (int k = 0; k < 4; ++k) box({0.2, 0.2, 0.2}, 0.0, {0.5 * k, 2.0, 0.3});
+        box({0.2, 0.2, 0.2}, M_PI / 2, {0.5, -1.0, 0.3});
+        box({0.2, 0.2, 0.2}, 0.3, {1.5, -1.0, 0.1});
+        obj.close();
+        ASSERT_TRUE(loader.load("test_instancing.obj"));
+        std::remove("test_instancing.obj");
+    }
+};
+
+TEST_F(IntersectionEngineInstancingTest, DetectsRepeatedParts) {
+    const auto instanced = loader.getInstancedMesh();
+    ASSERT_EQ(instanced->getPrototypes().size(), 2u);   // Rest (Quader) + Würfel
+    EXPECT_EQ(instanced->getInstances().size(), 7u);
+    EXPECT_EQ(instanced->uniqueTriangleCount(), 24u);
+
+    // Panel-IDs der Instanzen = Panel-IDs der flachen Tabelle
+    std::vector<int> offsets;
+    for (const MeshInstance& inst : instanced->getInstances())
+        if (inst.prototype == 1) offsets.push_back(inst.panelOffset);
+    EXPECT_EQ(offsets, (std::vector<int>{0, 12, 24, 36, 48, 60}));
+}
+
+TEST_F(IntersectionEngineInstancingTest, MatchesFlatTrace) {
+    IntersectionEngine instanced, flat;
+    instanced.setMesh(loader.getInstancedMesh());
+    flat.setMesh(loader.getTriangleTable());
+    const TriangleTable& table = *loader.getTriangleTable();
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> uni(-1.0, 1.0);
+    int hits = 0;
+    for (int i = 0; i < 4000; ++i) {
+        Ray ray;
+        ray.origin = Vector3(1.0, 0.5, 0.5) + Vector3(uni(rng), uni(rng), uni(rng)).normalize() * 5.0;
+        ray.direction = (Vector3(1.0 + 1.2 * uni(rng), 0.5 + 2.0 * uni(rng), 0.5 + 0.5 * uni(rng)) - ray.origin).normalize();
+
+        // Primärstrahl, dann ein Folgestrahl vom Trefferpunkt (Startpanel ausgeschlossen)
+        for (int bounce = 0; bounce < 2; ++bounce) {
+            auto a = instanced.intersect(ray);
+            auto b = flat.intersect(ray);
+            ASSERT_EQ(a.has_value(), b.has_value());
+            if (!a) break;
+            ++hits;
+            EXPECT_EQ(a->panelId, b->panelId);
+            EXPECT_NEAR(a->t, b->t, 1e-9);
+            EXPECT_NEAR(a->normal.dot(b->normal), 1.0, 1e-9);
+            EXPECT_EQ(a->materialId, table[table.indexOf(b->panelId)].materialId);
+
+            ray.origin = b->point;
+            ray.direction = (b->normal + Vector3(uni(rng), uni(rng), uni(rng)) * 0.9).normalize();
+            ray.panelId = b->panelId;
+        }
+    }
+    EXPECT_GT(hits, 1000);
+}
+
+TEST_F(IntersectionEngineInstancingTest, BvhMatchesLinearScan) {
+    IntersectionEngine engine, linear;
+    TraversalStats stats;
+    engine.setMesh(loader.getTriangleTable());
+    linear.setLinearScan(true);
+    linear.setMesh(loader.getTriangleTable());
+    const TriangleTable& table = *loader.getTriangleTable();
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> uni(-1.0, 1.0);
+    for (int i = 0; i < 2000; ++i) {
+        Ray ray;
+        ray.origin = Vector3(uni(rng), uni(rng), uni(rng)) * 4.0;
+        ray.direction = Vector3(uni(rng), uni(rng), uni(rng)).normalize();
+
+        // Möller–Trumbore über alle Zeilen als Referenz
+        double nearest = std::numeric_limits<double>::infinity();
+        for (const TriangleAttributes& tri : table) {
+            const Vector3 p = ray.direction.cross(tri.edge2);
+            const double det = tri.edge1.dot(p);
+            if (std::abs(det) < 1e-14) continue;
+            const Vector3 s = ray.origin - tri.p0;
+            const double u = s.dot(p) / det;
+            const Vector3 q = s.cross(tri.edge1);
+            const double v = ray.direction.dot(q) / det;
+            const double t = tri.edge2.dot(q) / det;
+            if (u >= 0 && v >= 0 && u + v <= 1 && t > 0 && t < nearest) nearest = t;
+        }
+
+        auto hit = engine.intersect(ray, &stats);
+        auto scan = linear.intersect(ray);
+        ASSERT_EQ(hit.has_value(), std::isfinite(nearest));
+        ASSERT_EQ(scan.has_value(), hit.has_value());
+        if (hit) {
+            EXPECT_NEAR(hit->t, nearest, 1e-9);
+            EXPECT_EQ(scan->panelId, hit->panelId);
+            EXPECT_EQ(scan->t, hit->t);
+        }
+    }
+    // Die Hierarchie testet nur einen Bruchteil der 84 Dreiecke je Strahl
+    EXPECT_GT(stats.nodeTests, 0u);
+    EXPECT_LT(stats.primitiveTests, 2000u * table.size() / 2);
+}
+
+// Rumpf 2 × 1 × 1, Klappe "flap" am Scharnier x = 2 und drei gleiche Würfel im Körper "array"
+class IntersectionEngineArticulationTest : public ::testing::Test {
+protected:
+    MeshLoader loader;
+
+    void SetUp() override {
+        const int faces[12][3] = {{0, 2, 3}, {0, 3, 1}, {4, 5, 7}, {4, 7, 6}, {0, 1, 5}, {0, 5, 4},
+                                  {2, 6, 7}, {2, 7, 3}, {0, 4, 6}, {0, 6, 2}, {1, 3, 7}, {1, 7, 5}};
+        std::ofstream obj("test_articulation.obj");
+        obj.precision(17);
+        int base = 1;
+        auto box = [&](const Vector3& size, const Vector3& offset) {
+            for (int i = 0; i < 8; ++i) {
+                obj << "v " << (i & 1) * size.x + offset.x << " " << ((i >> 1) & 1) * size.y + offset.y << " "
+                    << ((i >> 2) & 1) * size.z + offset.z << "\n";
+            }
+            for (const auto& f : faces) obj << "f " << base + f[0] << " " << base + f[1] << " " << base + f[2] << "\n";
+            base += 8;
+        };
+        box({2.0, 1.0, 1.0}, {0.0, 0.0, 0.0});
+        obj << "o flap\n";
+        box({1.0, 1.0, 0.05}, {2.0, 0.0, 0.45});
+        obj << "g array\n";
+        for (int k = 0; k < 3; ++k) box({0.2, 0.2, 0.2}, {0.5 * k, 2.0, 0.3});
+        obj.close();
+        ASSERT_TRUE(loader.load("test_articulation.obj"));
+        std::remove("test_articulation.obj");
+    }
+
+    // Zufallsstrahlen auf die Szene mit je einem Folgestrahl; Engine mit Körpertransformationen gegen flache Tabelle
+    void expectSameHits(const IntersectionEngine& moved, const IntersectionEngine& flat) {
+        std::mt19937 rng(5);
+        std::uniform_real_distribution<double> uni(-1.0, 1.0);
+        int hits = 0;
+        for (int i = 0; i < 3000; ++i) {
+            Ray ray;
+            ray.origin = Vector3(1.5, 1.0, 0.5) + Vector3(uni(rng), uni(rng), uni(rng)).normalize() * 6.0;
+            ray.direction = (Vector3(1.5 + 1.5 * uni(rng), 1.0 + 1.5 * uni(rng), 0.5 + uni(rng)) - ray.origin).normalize();
+            for (int bounce = 0; bounce < 2; ++bounce) {
+                auto a = moved.intersect(ray);
+                auto b = flat.intersect(ray);
+                ASSERT_EQ(a.has_value(), b.has_value());
+                if (!a) break;
+                ++hits;
+                EXPECT_EQ(a->panelId, b->panelId);
+                EXPECT_NEAR(a->t, b->t, 1e-9);
+                EXPECT_NEAR(a->normal.dot(b->normal), 1.0, 1e-9);
+
+                ray.origin = b->point;
+                ray.direction = (b->normal + Vector3(uni(rng), uni(rng), uni(rng)) * 0.9).normalize();
+                ray.panelId = b->panelId;
+            }
+        }
+        EXPECT_GT(hits, 1000);
+    }
+};
+
+TEST_F(IntersectionEngineArticulationTest, ReadsBodiesAsInstances) {
+    EXPECT_EQ(loader.getBodyNames(), (std::vector<std::string>{"", "flap", "array"}));
+
+    // Kein Prototyp gehört zu zwei Körpern; die Würfel bleiben geteilt
+    const auto instanced = loader.getInstancedMesh();
+    std::vector<std::set<int>> bodiesOf(instanced->getPrototypes().size());
+    for (const MeshInstance& inst : instanced->getInstances()) bodiesOf[inst.prototype].insert(inst.body);
+    for (const auto& bodies : bodiesOf) EXPECT_EQ(bodies.size(), 1u);
+    EXPECT_EQ(instanced->uniqueTriangleCount(), 36u);
+}
+
+TEST_F(IntersectionEngineArticulationTest, MovedBodiesMatchPosedTable) {
+    IntersectionEngine engine;
+    engine.setMesh(loader.getInstancedMesh());
+
+    // Klappe 35° um das Scharnier, Würfelgruppe gedreht und verschoben
+    std::vector<RigidTransform> pose(3);
+    pose[1] = RigidTransform::rotation({0, 1, 0}, 35.0 * M_PI / 180.0, {2.0, 0.0, 0.5});
+    pose[2] = RigidTransform::rotation({1, 1, 0}, 0.4, {0.5, 2.1, 0.4});
+    pose[2].translation = pose[2].translation + Vector3(0.0, 0.3, 0.2);
+    engine.setBodyTransforms(pose);
+
+    IntersectionEngine flat;
+    flat.setMesh(TriangleTable::posed(loader.getTriangleTable(), pose));
+    expectSameHits(engine, flat);
+
+    // Zurück in die geladene Lage: Transformationen sind nicht kumulativ
+    engine.setBodyTransforms({});
+    IntersectionEngine loaded;
+    loaded.setMesh(loader.getTriangleTable());
+    expectSameHits(engine, loaded);
+}
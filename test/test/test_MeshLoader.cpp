@@ -1,7 +1,10 @@
 #include "MeshLoader.h"
+#include "MeshOrientation.h"
 #include <cassert>
 #include <iostream>
 #include <cmath>
+#include <cstdio>
+#include <fstream>
 
 void test_meshloader_asymmetric_bounding_box() {
     const std::string filename = "models/Cube.obj";
@@ -37,8 +40,201 @@ void test_meshloader_asymmetric_bounding_box() {
     std::cout << "[OK] Asymmetrische Bounding Box korrekt erweitert ✅\n";
 }
 
+void test_meshloader_triangle_table() {
+    MeshLoader loader;
+    bool loaded = loader.load("models/Cube.obj");
+    assert(loaded && "❌ Mesh konnte nicht geladen werden");
+
+    const auto table = loader.getTriangleTable();
+    const auto& tris = loader.getTriangles();
+    assert(table && table->size() == tris.size());
+
+    // Einheitsnormalen nach außen, Flächen wie Triangle::area, Zeile = Panel-ID
+    const Vector3 center = loader.getCenter(0.0);
+    double areaSum = 0.0;
+    for (size_t i = 0; i < table->size(); ++i) {
+        const TriangleAttributes& t = (*table)[i];
+        assert(std::abs(t.normal.norm() - 1.0) < 1e-12);
+        assert(t.normal.dot(t.centroid - center) > 0.0);
+        assert(std::abs(t.area - tris[i].area(loader.getVertices())) < 1e-12);
+        assert(t.panelId == tris[i].panelId && table->indexOf(t.panelId) == static_cast<int>(i));
+        assert((t.edge1 - (t.p1 - t.p0)).norm() == 0.0);
+        areaSum += t.area;
+    }
+    assert(std::abs(table->getTotalArea() - areaSum) < 1e-12);
+    assert(table->indexOf(-1) == -1 && table->indexOf(static_cast<int>(tris.size())) == -1);
+
+    std::cout << "[OK] Dreieckstabelle konsistent (" << table->size() << " Dreiecke) ✅\n";
+}
+
+void test_meshloader_obj_statements() {
+    // Quad, Fünfeck, relative Indizes, v/vt/vn-Formen, Materialien, CRLF und ein entartetes Dreieck
+    {
+        std::ofstream mtl("test_meshloader.mtl");
+        mtl << "newmtl gold\nKd 1 1 0\nnewmtl solar\n";
+        std::ofstream obj("test_meshloader.obj");
+        obj << "# Test\nmtllib test_meshloader.mtl\n"
+            << "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\r\n"
+            << "v 0 0 1\nv 1 0 1\nv 1 1 1\nv 0 1 1\nv 0.5 1.5 1\n"
+            << "vn 0 0 1\nvt 0 0\n"
+            << "f 1 2 3 4\n"                       // 2 Dreiecke, Standardmaterial
+            << "usemtl gold\n"
+            << "f 5/1 6/1 7/1 9/1 8/1\r\n"         // Fünfeck als Fächer: 3 Dreiecke
+            << "usemtl solar\n"
+            << "f -9//1 -8//1 -4//1\n"             // 1 2 5 relativ
+            << "f 1 1 2\n"                          // entartet, wird verworfen
+            << "usemtl unknown\n"
+            << "f 2/1/1 3/1/1 6/1/1\n";
+    }
+
+    MeshLoader loader;
+    bool loaded = loader.load("test_meshloader.obj");
+    assert(loaded);
+    const auto& verts = loader.getVertices();
+    const auto& tris = loader.getTriangles();
+    const auto& names = loader.getMaterialNames();
+    assert(verts.size() == 9);
+    assert(std::abs(verts[8].x - 0.5) < 1e-15 && std::abs(verts[8].y - 1.5) < 1e-15);
+    assert(tris.size() == 7);
+    assert(names.size() == 3 && names[1] == "gold" && names[2] == "solar");
+
+    const int expectedMaterial[7] = {0, 0, 1, 1, 1, 2, 0};
+    for (size_t i = 0; i < tris.size(); ++i) {
+        assert(tris[i].panelId == static_cast<int>(i));
+        assert(tris[i].materialId == expectedMaterial[i]);
+    }
+    // Relativer Verweis −9 −8 −4 bei 9 Vertices → 0 1 5 (Windung ggf. gedreht)
+    const int a = tris[5].v1, b = tris[5].v2, c = tris[5].v3;
+    assert(a + b + c == 0 + 1 + 5 && (a == 0 || b == 0 || c == 0) && (a == 5 || b == 5 || c == 5));
+
+    // Fehlender Vertex → Fehler statt stiller Lücke
+    {
+        std::ofstream obj("test_meshloader_bad.obj");
+        obj << "v 0 0 0\nv 1 0 0\nf 1 2 3\n";
+    }
+    MeshLoader bad;
+    bool badLoaded = bad.load("test_meshloader_bad.obj");
+    assert(!badLoaded);
+    assert(bad.getTriangles().empty());
+
+    std::remove("test_meshloader.obj");
+    std::remove("test_meshloader.mtl");
+    std::remove("test_meshloader_bad.obj");
+
+    std::cout << "[OK] OBJ-Anweisungen korrekt gelesen ✅\n";
+}
+
+void test_meshloader_bodies() {
+    // Rumpf (ohne o/g) und Flügel "wing", die sich die Scharnierkante 2–3 teilen; "g" ohne Namen → Rumpf
+    {
+        std::ofstream obj("test_meshloader_bodies.obj");
+        obj << "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\nv 2 0 0\nv 2 1 0\n"
+            << "f 1 2 3\n"
+            << "o wing\nf 2 5 6\nf 2 6 3\n"
+            << "g\nf 1 3 4\n"
+            << "g wing\n";
+    }
+
+    MeshLoader loader;
+    bool loaded = loader.load("test_meshloader_bodies.obj");
+    assert(loaded);
+    const auto& names = loader.getBodyNames();
+    const auto& tris = loader.getTriangles();
+    assert(names.size() == 2 && names[0].empty() && names[1] == "wing");
+    assert(tris.size() == 4);
+    const int expectedBody[4] = {0, 1, 1, 0};
+    for (size_t i = 0; i < tris.size(); ++i) {
+        assert(tris[i].bodyId == expectedBody[i]);
+        assert((*loader.getTriangleTable())[i].bodyId == expectedBody[i]);
+    }
+
+    // Der Flügel bekommt eigene Kopien der Scharniervertices 1 und 2
+    assert(loader.getVertices().size() == 8);
+    for (int i : {1, 2}) {
+        for (int v : {tris[i].v1, tris[i].v2, tris[i].v3}) assert(v != 1 && v != 2);
+    }
+
+    RigidTransform lift;
+    lift.translation = Vector3(0, 0, 1);
+    const auto posed = loader.getPosedVertices({RigidTransform{}, lift});
+    for (size_t v = 0; v < posed.size(); ++v) {
+        const bool wingOnly = v >= 4;   // 4, 5 und die Kopien 6, 7
+        assert(posed[v].z == (wingOnly ? 1.0 : 0.0));
+    }
+
+    std::remove("test_meshloader_bodies.obj");
+    std::cout << "[OK] Teilkörper aus o/g gelesen ✅\n";
+}
+
+void test_meshloader_orientation() {
+    // Zwei getrennte Würfel mit teils verdrehten Flächen; der Bounding-Box-Mittelpunkt liegt zwischen
+    // ihnen, eine Orientierung relativ zu diesem würde die Innenseiten nach außen drehen.
+    // Würfel B hat eigene Vertices je Fläche (muss für die Nachbarschaft verschweißt werden).
+    const int faces[6][4] = {{0, 2, 3, 1}, {4, 5, 7, 6}, {0, 1, 5, 4}, {2, 6, 7, 3}, {0, 4, 6, 2}, {1, 3, 7, 5}};
+    auto corner = [](int i, double x0) { return Vector3(x0 + (i & 1), (i >> 1) & 1, (i >> 2) & 1); };
+    {
+        std::ofstream obj("test_orientation.obj");
+        for (int i = 0; i < 8; ++i) {
+            const Vector3 p = corner(i, 0.0);
+            obj << "v " << p.x << " " << p.y << " " << p.z << "\n";
+        }
+        for (int f = 0; f < 6; ++f) {
+            if (f % 2 == 1) obj << "f " << faces[f][3] + 1 << " " << faces[f][2] + 1 << " " << faces[f][1] + 1 << " " << faces[f][0] + 1 << "\n";
+            else obj << "f " << faces[f][0] + 1 << " " << faces[f][1] + 1 << " " << faces[f][2] + 1 << " " << faces[f][3] + 1 << "\n";
+        }
+        for (int f = 0; f < 6; ++f) {
+            for (int k = 0; k < 4; ++k) {
+                const Vector3 p = corner(faces[f][f % 3 == 0 ? 3 - k : k], 3.0);
+                obj << "v " << p.x << " " << p.y << " " << p.z << "\n";
+            }
+            const int base = 8 + 4 * f;
+            obj << "f " << base + 1 << " " << base + 2 << " " << base + 3 << " " << base + 4 << "\n";
+        }
+    }
+
+    MeshLoader loader;
+    bool loaded = loader.load("test_orientation.obj");
+    assert(loaded);
+    std::remove("test_orientation.obj");
+    const auto table = loader.getTriangleTable();
+    assert(table->size() == 24);
+    for (size_t i = 0; i < table->size(); ++i) {
+        const TriangleAttributes& t = (*table)[i];
+        const Vector3 center(t.centroid.x < 2.0 ? 0.5 : 3.5, 0.5, 0.5);
+        assert(t.normal.dot(t.centroid - center) > 0.0);
+    }
+    const MeshTopologyReport& report = loader.getTopologyReport();
+    assert(report.components == 2 && report.isClosedManifold());
+
+    // Schachtel mit halbem Deckel, alle Flächen nach innen: offen → Paritätsstrahlen statt Volumen
+    std::vector<Vector3> verts;
+    for (int i = 0; i < 8; ++i) verts.push_back(corner(i, 0.0));
+    std::vector<Triangle> box;
+    for (int f = 0; f < 6; ++f) {
+        box.push_back({faces[f][0], faces[f][2], faces[f][1], static_cast<int>(box.size())});
+        if (f != 1) box.push_back({faces[f][0], faces[f][3], faces[f][2], static_cast<int>(box.size())});
+    }
+    const MeshTopologyReport open = MeshOrientation::orientOutward(verts, box);
+    assert(open.components == 1 && open.openEdges == 3 && open.nonManifoldEdges == 0 && !open.isClosedManifold());
+    assert(open.flippedFaces == box.size());
+    for (const Triangle& tri : box) {
+        const Vector3 normal = (verts[tri.v2] - verts[tri.v1]).cross(verts[tri.v3] - verts[tri.v1]);
+        assert(normal.dot((verts[tri.v1] + verts[tri.v2] + verts[tri.v3]) / 3.0 - Vector3(0.5, 0.5, 0.5)) > 0.0);
+    }
+
+    std::vector<Triangle> fin = {{0, 1, 2, 0}, {0, 1, 4, 1}, {1, 0, 6, 2}};
+    const MeshTopologyReport fan = MeshOrientation::orientOutward(verts, fin);
+    assert(fan.nonManifoldEdges == 1 && fan.openEdges == 6 && fan.components == 3);
+
+    std::cout << "[OK] Orientierung über Kantennachbarschaft und Paritätsstrahlen ✅\n";
+}
+
 int main() {
     test_meshloader_asymmetric_bounding_box();
+    test_meshloader_triangle_table();
+    test_meshloader_obj_statements();
+    test_meshloader_bodies();
+    test_meshloader_orientation();
     return 0;
 }
 
@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+#include "RunProfiler.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+TEST(RunProfilerTest, BounceHistogramClampsDeepRays) {
+    ThreadCounters c;
+    c.recordRay(0);
+    c.recordRay(2);
+    c.recordRay(2);
+    c.recordRay(ThreadCounters::maxDepth + 5);
+
+    EXPECT_EQ(c.rays, 4u);
+    EXPECT_EQ(c.bounceHistogram[0], 1u);
+    EXPECT_EQ(c.bounceHistogram[2], 2u);
+    EXPECT_EQ(c.bounceHistogram[ThreadCounters::maxDepth], 1u);
+}
+
+TEST(RunProfilerTest, SummaryMergesThreadsAndMeasuresImbalance) {
+    RunProfiler profiler(2);
+    profiler.rank().add(Stage::Config, 0.5);
+    profiler.thread(0).add(Stage::Intersect, 1.0);
+    profiler.thread(1).add(Stage::Intersect, 3.0);
+    profiler.thread(0).intersectCalls = 10;
+    profiler.thread(1).intersectCalls = 30;
+    profiler.setThreadBusy(0, 1.0);
+    profiler.setThreadBusy(1, 3.0);
+    profiler.setLoopSeconds(3.2);
+
+    RankSummary r = profiler.summarize();
+    EXPECT_DOUBLE_EQ(r.counters.get(Stage::Config), 0.5);
+    EXPECT_DOUBLE_EQ(r.counters.get(Stage::Intersect), 4.0);
+    EXPECT_EQ(r.counters.intersectCalls, 40u);
+    EXPECT_EQ(r.threads, 2);
+    EXPECT_DOUBLE_EQ(r.threadBusyMax, 3.0);
+    EXPECT_DOUBLE_EQ(r.threadBusyMean, 2.0);
+    EXPECT_DOUBLE_EQ(r.loopSeconds, 3.2);
+}
+
+TEST(RunProfilerTest, PackRoundTrip) {
+    RankSummary r;
+    r.counters.add(Stage::Reflect, 1.25);
+    r.counters.recordRay(3);
+    r.counters.intersectCalls = 4;
+    r.counters.traversal.primitiveTests = 48;
+    r.counters.traversal.nodeTests = 7;
+    r.counters.hits = 3;
+    r.counters.hardware.cycles = 1000;
+    r.counters.hardware.branchMisses = 9;
+    r.counters.hardware.threads = 1;
+    r.loopSeconds = 2.0;
+    r.threadBusyMax = 1.5;
+    r.threadBusyMean = 1.0;
+    r.maxRssMB = 123.5;
+    r.threads = 8;
+
+    std::vector<double> buf(RankSummary::packedSize);
+    r.pack(buf.data());
+    RankSummary back = RankSummary::unpack(buf.data());
+
+    EXPECT_DOUBLE_EQ(back.counters.get(Stage::Reflect), 1.25);
+    EXPECT_EQ(back.counters.rays, 1u);
+    EXPECT_EQ(back.counters.bounceHistogram[3], 1u);
+    EXPECT_EQ(back.counters.intersectCalls, 4u);
+    EXPECT_EQ(back.counters.traversal.primitiveTests, 48u);
+    EXPECT_EQ(back.counters.traversal.nodeTests, 7u);
+    EXPECT_EQ(back.counters.hits, 3u);
+    EXPECT_EQ(back.counters.hardware.cycles, 1000u);
+    EXPECT_EQ(back.counters.hardware.branchMisses, 9u);
+    EXPECT_EQ(back.counters.hardware.threads, 1u);
+    EXPECT_DOUBLE_EQ(back.loopSeconds, 2.0);
+    EXPECT_DOUBLE_EQ(back.threadBusyMax, 1.5);
+    EXPECT_DOUBLE_EQ(back.threadBusyMean, 1.0);
+    EXPECT_DOUBLE_EQ(back.maxRssMB, 123.5);
+    EXPECT_EQ(back.threads, 8);
+}
+
+TEST(RunProfilerTest, WritesJsonReport) {
+    RankSummary a, b;
+    a.counters.rays = 100;
+    a.counters.intersectCalls = 250;
+    a.counters.traversal.primitiveTests = 3000;
+    a.loopSeconds = 2.0;
+    b.counters.rays = 100;
+    b.loopSeconds = 1.0;
+
+    RunReport report;
+    report.set("model", "CLL \"test\"");
+    report.set("rays", 200);
+    report.setResult("cd", 2.2);
+    const std::string path = (std::filesystem::temp_directory_path() / "test_run_report.json").string();
+    ASSERT_TRUE(report.write(path, {a, b}));
+
+    std::ifstream in(path);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    const std::string json = ss.str();
+    std::filesystem::remove(path);
+
+    EXPECT_NE(json.find("\"model\": \"CLL \\\"test\\\"\""), std::string::npos);
+    EXPECT_NE(json.find("\"rays_per_s\": 100"), std::string::npos);          // 200 Strahlen / 2 s
+    EXPECT_NE(json.find("\"triangle_tests_per_ray\": 15"), std::string::npos);
+    EXPECT_NE(json.find("\"rank_max_over_mean\": 1.333333333"), std::string::npos);
+    EXPECT_NE(json.find("\"cd\": 2.2"), std::string::npos);
+    EXPECT_NE(json.find("\"accel_build\""), std::string::npos);
+    EXPECT_NE(json.find("\"hardware\": {\"available\": false"), std::string::npos);
+}
+
+TEST(RunProfilerTest, ReportsHardwareCountersPerRayAndHit) {
+    RankSummary r;
+    r.counters.rays = 10;
+    r.counters.hits = 4;
+    r.counters.hardware = {2000, 4000, 40, 8, 1};
+    r.loopSeconds = 1.0;
+
+    RunReport report;
+    const std::string path = (std::filesystem::temp_directory_path() / "test_run_report_hw.json").string();
+    ASSERT_TRUE(report.write(path, {r}));
+
+    std::ifstream in(path);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    const std::string json = ss.str();
+    std::filesystem::remove(path);
+
+    EXPECT_NE(json.find("\"available\": true"), std::string::npos);
+    EXPECT_NE(json.find("\"ipc\": 2"), std::string::npos);
+    EXPECT_NE(json.find("\"per_ray\": {\"cycles\": 200, \"instructions\": 400, \"cache_misses\": 4, \"branch_misses\": 0.8}"),
+              std::string::npos);
+    EXPECT_NE(json.find("\"per_hit\": {\"cycles\": 500"), std::string::npos);
+}
+
+TEST(RunProfilerTest, PerfCounterGroupFallsBackToNoOp) {
+    PerfCounterGroup perf;
+    perf.start();
+    volatile double x = 0.0;
+    for (int i = 0; i < 100000; ++i) x = x + i * 0.5;
+    HardwareCounts c = perf.stop();
+
+    if (perf.available()) {
+        EXPECT_EQ(c.threads, 1u);
+        EXPECT_GT(c.instructions, 0u);
+    } else {
+        // Ohne Zähler: keine Werte, aber ein Grund für die Warnung
+        EXPECT_EQ(c.threads, 0u);
+        EXPECT_EQ(c.cycles, 0u);
+        EXPECT_FALSE(perf.error().empty());
+    }
+}
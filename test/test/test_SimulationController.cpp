@@ -3,8 +3,10 @@
 #include "ConfigLoader.h"
 #include "Vector3.h"
 #include "Triangle.h"
+#include "Attitude.h"
 #include <iostream>
 #include <cassert>
+#include <cmath>
 
 void test_simulation_controller_generates_shell_rays() {
     std::cout << "[TEST] SimulationController: generateMixedRays() mit BoundingBox-Shell\n";
@@ -59,8 +61,76 @@ void test_simulation_controller_generates_shell_rays() {
     }
 }
 
+void test_attitude_conventions() {
+    std::cout << "[TEST] Attitude: Winkel und Quaternion\n";
+
+    const Vector3 freeStream{0.0, 1.0, 0.0};
+    const double a = 25.0 * M_PI / 180.0, b = -10.0 * M_PI / 180.0;
+    Vector3 d = Attitude::fromAngles(25.0, -10.0).toBody(freeStream);
+    assert((d - Vector3{std::sin(a) * std::cos(b), std::cos(a) * std::cos(b), std::sin(b)}).norm() < 1e-12);
+
+    // Rollen dreht um die Körper-y-Achse: bei α = β = 0 ändert sich die Anströmung nicht
+    d = Attitude::fromAngles(0.0, 0.0, 40.0).toBody(freeStream);
+    assert((d - freeStream).norm() < 1e-12);
+    d = Attitude::fromAngles(30.0, 0.0, 90.0).toBody(freeStream);
+    assert(std::abs(d.x) < 1e-12 && std::abs(d.y - std::cos(M_PI / 6.0)) < 1e-12 && std::abs(std::abs(d.z) - 0.5) < 1e-12);
+
+    // Quaternion Körper → Referenz um +z entspricht dem Anstellwinkel
+    const double t = 15.0 * M_PI / 180.0;
+    const Attitude q = Attitude::fromQuaternion(2.0 * std::cos(t / 2), 0.0, 0.0, 2.0 * std::sin(t / 2));   // unnormiert
+    assert((q.toBody(freeStream) - Attitude::fromAngles(15.0, 0.0).toBody(freeStream)).norm() < 1e-12);
+
+    // Winkel einer beliebigen Quaternion reproduzieren die volle Drehung, nicht nur die Anströmung
+    const Attitude general = Attitude::fromQuaternion(0.8, 0.3, -0.4, 0.2);
+    double aoa, sideslip, roll;
+    general.toAngles(aoa, sideslip, roll);
+    const Attitude back = Attitude::fromAngles(aoa, sideslip, roll);
+    for (const Vector3& axis : {Vector3{1, 0, 0}, Vector3{0, 1, 0}, Vector3{0, 0, 1}})
+        assert((general.toBody(axis) - back.toBody(axis)).norm() < 1e-12);
+    Attitude::fromAngles(30.0, -20.0, 40.0).toAngles(aoa, sideslip, roll);
+    assert(std::abs(aoa - 30.0) < 1e-9 && std::abs(sideslip + 20.0) < 1e-9 && std::abs(roll - 40.0) < 1e-9);
+    std::cout << "✔️  Attitude conventions OK.\n";
+}
+
+void test_simulation_controller_rotates_ray_source() {
+    std::cout << "[TEST] SimulationController: Strahlquelle folgt der Lage\n";
+
+    SimulationController controller;
+    controller.setVerbose(false);
+    IntersectionEngine intersection;
+    controller.setIntersectionEngine(&intersection);
+    controller.loadMesh("models/Cube.obj");
+    const auto& vertices = controller.getMesh().getVertices();
+    const auto& triangles = controller.getMesh().getTriangles();
+    assert(!triangles.empty());
+    intersection.setMesh(vertices, triangles);
+
+    SimulationConfig cfg;
+    cfg.temperature = 300.0;
+    cfg.seed = 5;
+    cfg.flowVelocity = Vector3(0, 7500, 0);   // Referenzsystem
+    cfg.species["O"] = SpeciesInfo{1.0e15, 2.66e-26};
+
+    const Attitude attitude = Attitude::fromAngles(30.0, 20.0, 10.0);
+    controller.setAttitude(attitude);
+    controller.generateMixedRays(cfg, triangles, vertices, 0.0, 2000, 2000);
+
+    const Vector3 flowDir = attitude.toBody(cfg.flowVelocity).normalize();
+    Vector3 mean{0, 0, 0};
+    for (const auto& ray : controller.getRays()) mean += ray.velocity;
+    mean = mean / static_cast<double>(controller.getRays().size());
+    assert(mean.normalize().dot(flowDir) > 0.999);
+
+    // Quelle liegt stromauf des Körpers
+    for (const auto& ray : controller.getRays())
+        for (const auto& v : vertices) assert((v - ray.origin).dot(flowDir) > 0.0);
+    std::cout << "✔️  Rays follow the attitude.\n";
+}
+
 int main() {
     test_simulation_controller_generates_shell_rays();
+    test_attitude_conventions();
+    test_simulation_controller_rotates_ray_source();
     return 0;
 }
 
@@ -36,7 +36,150 @@ void test_reflection_is_computed_correctly() {
     std::cout << "[OK] test_reflection_is_computed_correctly\n";
 }
 
+// Mittlere Energie und mittlere Normalgeschwindigkeit vieler DRIA-Re-Emissionen
+static void meanReemission(const SurfaceInteractionModel& model, const SimulationConfig& cfg, const Ray& in,
+                           const HitInfo& hit, double& energy, double& normalSpeed) {
+    const int n = 200000;
+    energy = normalSpeed = 0.0;
+    for (int i = 0; i < n; ++i) {
+        Ray out = model.reflect<SurfaceModelType::DRIA>(cfg, in, hit);
+        energy += out.energy / n;
+        normalSpeed += out.velocity.dot(hit.normal) / n;
+    }
+}
+
+void test_compile_time_kernels() {
+    assert(parseSurfaceModel("DRIA") == SurfaceModelType::DRIA);
+    assert(parseSurfaceModel("Sentman") == SurfaceModelType::Sentman);
+    assert(parseSurfaceModel("") == SurfaceModelType::Classic);
+
+    SurfaceInteractionModel model;
+
+    Ray in;
+    in.direction = {0, -1, 0};
+    in.energy = 1e-20;
+    in.speciesMass = 4.65e-26;
+    in.speciesId = 2;
+    in.weight = 3.0;
+
+    HitInfo hit;
+    hit.point = {0, 0, 0};
+    hit.normal = {0, 1, 0};
+    hit.panelId = 7;
+
+    SimulationConfig cfg;
+    cfg.energyAccommodation = 1.0; // vollständige Akkommodation → T_r = 300 K
+
+    seedSurfaceRandom(1);
+    Ray out = model.reflect<SurfaceModelType::DRIA>(cfg, in, hit);
+    assert(out.direction.dot(hit.normal) > 0);
+    assert(std::abs(out.momentum.norm() - std::sqrt(2.0 * out.speciesMass * out.energy)) < 1e-9 * out.momentum.norm());
+    assert(out.speciesId == 2);
+    assert(out.panelId == 7);
+    assert(out.weight == 3.0);
+
+    // Sentman mit rein spiegelnder Reflexion
+    cfg.specularFraction = 1.0;
+    out = model.reflect<SurfaceModelType::Sentman>(cfg, in, hit);
+    assert(std::abs(out.direction.y - 1.0) < 1e-12);
+
+    std::cout << "[OK] test_compile_time_kernels\n";
+}
+
+void test_dria_matches_flux_weighted_convention() {
+    // Gleiche Konvention wie PanelMethodEngine: im Mittel 2kT_r, ⟨v_n⟩ = √π/2 · √(2kT_r/m)
+    SurfaceInteractionModel model;
+    SimulationConfig cfg;
+    cfg.WallTemp = 300.0;
+
+    Ray in;
+    in.direction = {0, -1, 0};
+    in.speciesMass = 4.65e-26;
+    HitInfo hit;
+    hit.point = {0, 0, 0};
+    hit.normal = {0, 1, 0};
+
+    // Vollständige Akkommodation: T_r = T_w unabhängig von der Einfallsenergie
+    cfg.energyAccommodation = 1.0;
+    in.energy = 1e-18;
+    seedSurfaceRandom(7);
+    double energy, vn;
+    meanReemission(model, cfg, in, hit, energy, vn);
+    const double c_w = std::sqrt(2.0 * cfg.kB * 300.0 / in.speciesMass);
+    assert(std::abs(energy / (2.0 * cfg.kB * 300.0) - 1.0) < 0.01);
+    assert(std::abs(vn / (0.5 * std::sqrt(M_PI) * c_w) - 1.0) < 0.01);
+
+    // Keine Akkommodation: mittlere Energie bleibt erhalten (T_i = E/(2k))
+    cfg.energyAccommodation = 0.0;
+    meanReemission(model, cfg, in, hit, energy, vn);
+    assert(std::abs(energy / in.energy - 1.0) < 0.01);
+
+    std::cout << "[OK] test_dria_matches_flux_weighted_convention\n";
+}
+
+void test_per_panel_materials() {
+    SimulationConfig cfg;
+    cfg.energyAccommodation = 1.0;
+    cfg.WallTemp = 300.0;
+    cfg.materials["hot"].wallTemperature = 600.0;
+    cfg.materials["mirror"].specularFraction = 1.0;
+
+    SurfaceInteractionModel model;
+    model.prepare(cfg, {"", "hot", "mirror"});
+    assert(model.getMaterials().size() == 3);
+    assert(std::abs(model.getMaterials()[1].wallTemperature - 600.0) < 1e-12);
+    assert(std::abs(model.getMaterials()[2].wallTemperature - 300.0) < 1e-12); // globaler Wert
+
+    Ray in;
+    in.direction = {0, -1, 0};
+    in.energy = 1e-20;
+    in.speciesMass = 4.65e-26;
+
+    HitInfo hit;
+    hit.point = {0, 0, 0};
+    hit.normal = {0, 1, 0};
+
+    double energy, vn;
+    hit.materialId = 0;
+    meanReemission(model, cfg, in, hit, energy, vn);
+    assert(std::abs(energy / (2.0 * cfg.kB * 300.0) - 1.0) < 0.01);
+
+    hit.materialId = 1;
+    meanReemission(model, cfg, in, hit, energy, vn);
+    assert(std::abs(energy / (2.0 * cfg.kB * 600.0) - 1.0) < 0.01);
+
+    hit.materialId = 2;
+    Ray out = model.reflect<SurfaceModelType::Sentman>(cfg, in, hit);
+    assert(std::abs(out.direction.y - 1.0) < 1e-12);
+
+    // Unbekannte ID → globale Werte
+    hit.materialId = 42;
+    meanReemission(model, cfg, in, hit, energy, vn);
+    assert(std::abs(energy / (2.0 * cfg.kB * 300.0) - 1.0) < 0.01);
+
+    std::cout << "[OK] test_per_panel_materials\n";
+}
+
+void test_origin_offset_scales_with_coordinates() {
+    const Vector3 n = {0, 1, 0};
+
+    // Kleine Modelle: Versatz weit unter der Panelgröße, aber auf der Gasseite
+    Vector3 small = offsetRayOrigin({1e-4, 2e-4, 0.0}, n);
+    assert(small.y > 2e-4 && small.y - 2e-4 < 1e-9);
+
+    // Große Modelle: Versatz wächst mit, bleibt über der float-Auflösung der Koordinaten
+    Vector3 large = offsetRayOrigin({0.0, 1000.0, 0.0}, n);
+    assert(large.y - 1000.0 > 1000.0 * 6e-8);
+    assert(large.y - 1000.0 < 1e-2);
+
+    std::cout << "[OK] test_origin_offset_scales_with_coordinates\n";
+}
+
 int main() {
     test_reflection_is_computed_correctly();
+    test_compile_time_kernels();
+    test_dria_matches_flux_weighted_convention();
+    test_per_panel_materials();
+    test_origin_offset_scales_with_coordinates();
     return 0;
 }
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include "ThermosphereModel.h"
+#include "ConfigLoader.h"
+#include <cmath>
+
+// US Standard Atmosphere 1976 (T∞ = 1000 K): Höhe [km], T [K], ρ [kg/m³]
+TEST(ThermosphereModelTest, ProfileMatchesUS76) {
+    const double ref[4][3] = {{200.0, 854.56, 2.541e-10}, {300.0, 976.01, 1.916e-11},
+                              {400.0, 995.83, 2.803e-12}, {500.0, 999.24, 5.215e-13}};
+    for (const auto& r : ref) {
+        AtmosphereState s = ThermosphereModel::diffusiveProfile(r[0], 1000.0);
+        EXPECT_NEAR(s.temperature, r[1], 0.1) << r[0] << " km";
+        EXPECT_NEAR(s.massDensity / r[2], 1.0, 0.03) << r[0] << " km";
+    }
+    // Oberhalb von ~200 km überwiegt atomarer Sauerstoff
+    AtmosphereState s = ThermosphereModel::diffusiveProfile(400.0, 1000.0);
+    EXPECT_GT(s.densities[2], s.densities[0]);
+    EXPECT_EQ(s.densities[7], 0.0);   // AO
+}
+
+TEST(ThermosphereModelTest, ExosphericTemperatureFollowsSolarAndGeomagneticActivity) {
+    ThermosphereInput quiet;
+    quiet.f107 = quiet.f107a = 70.0;
+    quiet.ap = 0.0;
+    ThermosphereInput active = quiet;
+    active.f107 = active.f107a = 250.0;
+    ThermosphereInput storm = quiet;
+    storm.ap = 200.0;
+    const double tQuiet = ThermosphereModel::exosphericTemperature(quiet);
+    EXPECT_GT(ThermosphereModel::exosphericTemperature(active), tQuiet + 400.0);
+    EXPECT_GT(ThermosphereModel::exosphericTemperature(storm), tQuiet + 250.0);
+
+    // Tagesgang am Äquator zur Tagundnachtgleiche: Maximum am Nachmittag, Minimum vor Sonnenaufgang
+    ThermosphereInput p = quiet;
+    p.dayOfYear = 80.0;
+    double tMax = 0.0, tMin = 1e9, hMax = 0.0, hMin = 0.0;
+    for (int h = 0; h < 24; ++h) {
+        p.utSeconds = h * 3600.0;
+        const double t = ThermosphereModel::exosphericTemperature(p);
+        if (t > tMax) tMax = t, hMax = h;
+        if (t < tMin) tMin = t, hMin = h;
+    }
+    EXPECT_GE(hMax, 13.0);
+    EXPECT_LE(hMax, 15.0);
+    EXPECT_GE(hMin, 2.0);
+    EXPECT_LE(hMin, 5.0);
+    EXPECT_NEAR(tMax / tMin, 1.3, 0.02);
+}
+
+TEST(ThermosphereModelTest, BatchMatchesSinglePoints) {
+    ThermosphereModel model;
+    ThermosphereBatch batch;
+    std::vector<ThermosphereInput> points;
+    for (int i = 0; i < 1000; ++i) {
+        ThermosphereInput p;
+        p.altitude = 150.0 + 0.7 * i;
+        p.latitude = 80.0 * std::sin(0.01 * i);
+        p.longitude = std::fmod(3.6 * i, 360.0) - 180.0;
+        p.dayOfYear = 1.0 + (i % 365);
+        p.utSeconds = 86.4 * i;
+        p.f107 = 120.0 + (i % 50);
+        p.f107a = 140.0;
+        p.ap = i % 30;
+        points.push_back(p);
+        batch.push_back(p);
+    }
+    model.evaluate(batch);
+    ASSERT_EQ(batch.massDensity.size(), points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        AtmosphereState s = model.evaluate(points[i]);
+        AtmosphereState b = batch.state(i);
+        EXPECT_NEAR(b.temperature, s.temperature, 1e-9 * s.temperature);
+        EXPECT_NEAR(b.massDensity, s.massDensity, 1e-9 * s.massDensity);
+        EXPECT_NEAR(b.densities[2], s.densities[2], 1e-9 * s.densities[2]);
+    }
+}
+
+TEST(ThermosphereModelTest, FeedsConfiguredSpecies) {
+    ThermosphereInput p;
+    p.altitude = 300.0;
+    AtmosphereState s = ThermosphereModel().evaluate(p);
+
+    SimulationConfig cfg;
+    cfg.species["O"] = SpeciesInfo{0.0, 2.66e-26};
+    cfg.species["N2"] = SpeciesInfo{0.0, 4.65e-26};
+    s.applyTo(cfg);
+    EXPECT_DOUBLE_EQ(cfg.species["O"].density, s.densities[2]);
+    EXPECT_DOUBLE_EQ(cfg.species["N2"].density, s.densities[0]);
+    EXPECT_DOUBLE_EQ(cfg.temperature, s.temperature);
+    EXPECT_GT(cfg.mass_density, 1e-12);
+    EXPECT_LT(cfg.mass_density, 1e-10);
+}
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include "TraceRecorder.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+TEST(TraceRecorderTest, DisabledRecorderIgnoresEvents) {
+    TraceRecorder trace;
+    auto t = StageClock::now();
+    trace.record(0, "stage", "cat", t, t);
+    { TraceScope scope(trace, 0, "scoped", "cat"); }
+
+    EXPECT_FALSE(trace.isEnabled());
+    EXPECT_TRUE(trace.serialize(0).empty());
+}
+
+TEST(TraceRecorderTest, SerializesCompleteEventsPerThread) {
+    TraceRecorder trace;
+    auto epoch = StageClock::now();
+    trace.setEpoch(epoch);
+    trace.enable(2, 16);
+
+    trace.record(0, "config", "stage", epoch, epoch + std::chrono::microseconds(1500));
+    trace.record(1, "ray_batch", "trace", epoch + std::chrono::microseconds(2000),
+                 epoch + std::chrono::microseconds(2500), 256);
+
+    std::string json = trace.serialize(3);
+    EXPECT_NE(json.find("\"name\":\"rank 3\""), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"config\",\"cat\":\"stage\",\"pid\":3,\"tid\":0,\"ts\":0.000,\"dur\":1500.000"),
+              std::string::npos);
+    EXPECT_NE(json.find("\"tid\":1,\"ts\":2000.000,\"dur\":500.000,\"args\":{\"first\":256}"), std::string::npos);
+    EXPECT_EQ(trace.droppedEvents(), 0u);
+}
+
+TEST(TraceRecorderTest, RingBufferKeepsNewestEvents) {
+    TraceRecorder trace;
+    auto epoch = StageClock::now();
+    trace.setEpoch(epoch);
+    trace.enable(1, 4);
+
+    for (int i = 0; i < 10; ++i)
+        trace.record(0, "ray_batch", "trace", epoch, epoch, i);
+
+    EXPECT_EQ(trace.droppedEvents(), 6u);
+    std::string json = trace.serialize(0);
+    EXPECT_EQ(json.find("\"first\":5}"), std::string::npos);
+    EXPECT_NE(json.find("\"first\":6}"), std::string::npos);
+    EXPECT_NE(json.find("\"first\":9}"), std::string::npos);
+}
+
+TEST(TraceRecorderTest, WritesMergedChromeTrace) {
+    const std::string path = (std::filesystem::temp_directory_path() / "test_trace.json").string();
+    ASSERT_TRUE(TraceRecorder::writeChromeTrace(path, {"{\"a\":1}", "", "{\"b\":2}"}));
+
+    std::ifstream in(path);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    std::filesystem::remove(path);
+    EXPECT_EQ(ss.str(), "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n{\"a\":1},\n{\"b\":2}\n]}\n");
+}